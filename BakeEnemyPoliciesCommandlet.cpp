@@ -0,0 +1,66 @@
+// BakeEnemyPoliciesCommandlet.cpp - Headless policy baking for all encounters
+#include "BakeEnemyPoliciesCommandlet.h"
+#include "KevesCardKitLog.h"
+#include "EnemyPolicyTable.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "UObject/Package.h"
+#include "UObject/SavePackage.h"
+#include "Misc/PackageName.h"
+
+UBakeEnemyPoliciesCommandlet::UBakeEnemyPoliciesCommandlet()
+{
+    IsClient = false;
+    IsEditor = true;
+    IsServer = false;
+    LogToConsole = true;
+}
+
+int32 UBakeEnemyPoliciesCommandlet::Main(const FString& Params)
+{
+    FString SearchPath = TEXT("/Game");
+    FParse::Value(*Params, TEXT("Path="), SearchPath);
+    const bool bSave = !FParse::Param(*Params, TEXT("NoSave"));
+
+    IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+    AssetRegistry.SearchAllAssets(true);
+
+    TArray<FAssetData> PolicyAssets;
+    FARFilter Filter;
+    Filter.ClassPaths.Add(UEnemyPolicyTable::StaticClass()->GetClassPathName());
+    Filter.PackagePaths.Add(FName(*SearchPath));
+    Filter.bRecursivePaths = true;
+    AssetRegistry.GetAssets(Filter, PolicyAssets);
+
+    UE_LOG(LogKevesCardKitAI, Display, TEXT("[EnemyPolicy] Found %d policy tables under %s"), PolicyAssets.Num(), *SearchPath);
+
+    int32 NumFailed = 0;
+    for (const FAssetData& AssetData : PolicyAssets)
+    {
+        UEnemyPolicyTable* PolicyTable = Cast<UEnemyPolicyTable>(AssetData.GetAsset());
+        if (!PolicyTable)
+        {
+            NumFailed++;
+            continue;
+        }
+
+        PolicyTable->Bake();
+
+        if (bSave)
+        {
+#if WITH_EDITOR
+            UPackage* Package = PolicyTable->GetOutermost();
+            const FString Filename = FPackageName::LongPackageNameToFilename(Package->GetName(), FPackageName::GetAssetPackageExtension());
+
+            FSavePackageArgs SaveArgs;
+            SaveArgs.TopLevelFlags = RF_Public | RF_Standalone;
+            if (!UPackage::SavePackage(Package, PolicyTable, *Filename, SaveArgs))
+            {
+                UE_LOG(LogKevesCardKitAI, Error, TEXT("[EnemyPolicy] Failed to save %s"), *Filename);
+                NumFailed++;
+            }
+#endif
+        }
+    }
+
+    return NumFailed == 0 ? 0 : 1;
+}
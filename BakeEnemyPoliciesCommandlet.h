@@ -0,0 +1,18 @@
+// BakeEnemyPoliciesCommandlet.h - Batch bakes every UEnemyPolicyTable asset
+// Usage: UnrealEditor-Cmd <Project> -run=BakeEnemyPolicies [-Path=/Game/AI] [-NoSave]
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "BakeEnemyPoliciesCommandlet.generated.h"
+
+UCLASS()
+class KEVESCARDKIT_API UBakeEnemyPoliciesCommandlet : public UCommandlet
+{
+    GENERATED_BODY()
+
+public:
+    UBakeEnemyPoliciesCommandlet();
+
+    virtual int32 Main(const FString& Params) override;
+};
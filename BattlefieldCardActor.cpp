@@ -1,7 +1,11 @@
 #include "BattlefieldCardActor.h"
+#include "KevesCardKitLog.h"
+#include "KevesCardKitMemory.h"
 #include "Engine/World.h"
 #include "GameFramework/PlayerController.h"
 #include "CombatManager.h"
+#include "CombatSequencer.h"
+#include "TimerManager.h"
 
 ABattlefieldCardActor::ABattlefieldCardActor()
 {
@@ -21,6 +25,8 @@ void ABattlefieldCardActor::BeginPlay()
 {
     Super::BeginPlay();
 
+    KCKMemory::AddBytes(ECardKitMemoryCategory::Actors, GetClass()->GetStructureSize());
+
     // Optionally run initial visuals
     OnSpawnedVisuals();
 
@@ -28,9 +34,17 @@ void ABattlefieldCardActor::BeginPlay()
     if (ACombatManager* CombatMgr = Cast<ACombatManager>(OwningCombatManager))
     {
         CombatMgr->OnCardDamagedByUniqueID.AddDynamic(this, &ABattlefieldCardActor::OnCardDamagedByUniqueID);
+        CombatMgr->OnBattlefieldDelta.AddUniqueDynamic(this, &ABattlefieldCardActor::OnBattlefieldDelta);
     }
 }
 
+void ABattlefieldCardActor::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    KCKMemory::AddBytes(ECardKitMemoryCategory::Actors, -GetClass()->GetStructureSize());
+
+    Super::EndPlay(EndPlayReason);
+}
+
 void ABattlefieldCardActor::InitializeBattlefieldCard(const FCardData& InCardData, int32 InUniqueID, int32 InIndex, bool bOwnedByPlayer, AActor* InCombatManager)
 {
     CardData = InCardData;
@@ -39,7 +53,7 @@ void ABattlefieldCardActor::InitializeBattlefieldCard(const FCardData& InCardDat
     bIsPlayerOwned = bOwnedByPlayer;
     OwningCombatManager = InCombatManager;
 
-    UE_LOG(LogTemp, Log, TEXT("[BattlefieldCardActor] Initialized: %s (UniqueID:%d, Index:%d, PlayerOwned:%s)"),
+    KCK_LOG_HOT(LogKevesCardKitCombat, Verbose, TEXT("[BattlefieldCardActor] Initialized: %s (UniqueID:%d, Index:%d, PlayerOwned:%s)"),
         *CardData.Name.ToString(), UniqueID, BattlefieldIndex, bOwnedByPlayer ? TEXT("Yes") : TEXT("No"));
 
     // Let Blueprints set flipbook/sprite/label based on CardData
@@ -52,12 +66,13 @@ void ABattlefieldCardActor::InitializeBattlefieldCard(const FCardData& InCardDat
         {
             CombatMgr->OnCardDamagedByUniqueID.AddDynamic(this, &ABattlefieldCardActor::OnCardDamagedByUniqueID);
         }
+        CombatMgr->OnBattlefieldDelta.AddUniqueDynamic(this, &ABattlefieldCardActor::OnBattlefieldDelta);
     }
 }
 
 void ABattlefieldCardActor::OnSelectedByPlayer()
 {
-    UE_LOG(LogTemp, Log, TEXT("[BattlefieldCardActor] Selected UniqueID %d (Index:%d, PlayerSide:%s) for card %s"),
+    KCK_LOG_HOT(LogKevesCardKitCombat, Verbose, TEXT("[BattlefieldCardActor] Selected UniqueID %d (Index:%d, PlayerSide:%s) for card %s"),
         UniqueID, BattlefieldIndex, bIsPlayerOwned ? TEXT("true") : TEXT("false"), *CardData.Name.ToString());
 
     // Broadcast delegate so CombatManager / PlayerController / UI can bind to it
@@ -69,7 +84,7 @@ void ABattlefieldCardActor::UpdateBattlefieldIndex(int32 NewIndex)
     int32 OldIndex = BattlefieldIndex;
     BattlefieldIndex = NewIndex;
 
-    UE_LOG(LogTemp, VeryVerbose, TEXT("[BattlefieldCardActor] %s (UniqueID:%d) index updated: %d -> %d"),
+    KCK_LOG_HOT(LogKevesCardKitCombat, VeryVerbose, TEXT("[BattlefieldCardActor] %s (UniqueID:%d) index updated: %d -> %d"),
         *CardData.Name.ToString(), UniqueID, OldIndex, NewIndex);
 }
 
@@ -87,7 +102,7 @@ void ABattlefieldCardActor::HandleDamaged(int32 DamageAmount)
     int32 NewHealth = FMath::Max(0, CardData.Health - DamageAmount);
     CardData.Health = NewHealth;
 
-    UE_LOG(LogTemp, Log, TEXT("[BattlefieldCardActor] %s (UniqueID:%d) took %d damage, health now %d"),
+    KCK_LOG_HOT(LogKevesCardKitCombat, Verbose, TEXT("[BattlefieldCardActor] %s (UniqueID:%d) took %d damage, health now %d"),
         *CardData.Name.ToString(), UniqueID, DamageAmount, NewHealth);
 
     // Fire delegate so Blueprint logic can run
@@ -97,25 +112,63 @@ void ABattlefieldCardActor::HandleDamaged(int32 DamageAmount)
     // Optional: auto-play hit animation
     PlayHitAnimation();
 
-    // If dead, optionally trigger death animation
+    // If dead, hold combat until the death animation reports back (or times out)
     if (NewHealth <= 0)
     {
-        PlayDeathAnimation();
+        BeginDeath();
+    }
+}
+
+void ABattlefieldCardActor::BeginDeath()
+{
+    if (bDeathStarted)
+    {
+        return;
+    }
+    bDeathStarted = true;
+
+    if (ACombatManager* CombatMgr = Cast<ACombatManager>(OwningCombatManager))
+    {
+        if (UCombatSequencer* Sequencer = CombatMgr->GetCombatSequencer())
+        {
+            DeathHoldHandle = Sequencer->AcquirePresentationHold(TEXT("CreatureDeath"));
+        }
+    }
+
+    GetWorld()->GetTimerManager().SetTimer(DeathTimeoutHandle, this, &ABattlefieldCardActor::NotifyDeathAnimationFinished, DeathAnimationTimeout, false);
+
+    PlayDeathAnimation();
+}
 
-        // Destroy after a short delay to allow animation to play
-        FTimerHandle DestroyTimer;
-        GetWorld()->GetTimerManager().SetTimer(DestroyTimer, [this]()
+void ABattlefieldCardActor::NotifyDeathAnimationFinished()
+{
+    if (!bDeathStarted || IsActorBeingDestroyed())
+    {
+        return;
+    }
+
+    GetWorld()->GetTimerManager().ClearTimer(DeathTimeoutHandle);
+
+    if (DeathHoldHandle != -1)
+    {
+        if (ACombatManager* CombatMgr = Cast<ACombatManager>(OwningCombatManager))
+        {
+            if (UCombatSequencer* Sequencer = CombatMgr->GetCombatSequencer())
             {
-                Destroy();
-            }, 2.0f, false);
+                Sequencer->ReleasePresentationHold(DeathHoldHandle);
+            }
+        }
+        DeathHoldHandle = -1;
     }
+
+    Destroy();
 }
 
 void ABattlefieldCardActor::HandleHealed(int32 NewHealth)
 {
     CardData.Health = NewHealth;
 
-    UE_LOG(LogTemp, Log, TEXT("[BattlefieldCardActor] %s (UniqueID:%d) healed, health now %d"),
+    KCK_LOG_HOT(LogKevesCardKitCombat, Verbose, TEXT("[BattlefieldCardActor] %s (UniqueID:%d) healed, health now %d"),
         *CardData.Name.ToString(), UniqueID, NewHealth);
 
     OnHealed.Broadcast(NewHealth);
@@ -131,4 +184,50 @@ void ABattlefieldCardActor::OnCardDamagedByUniqueID(int32 DamagedUniqueID, int32
     {
         HandleDamaged(DamageAmount);
     }
-}
\ No newline at end of file
+}
+
+void ABattlefieldCardActor::OnBattlefieldDelta(const FBattlefieldDelta& Delta)
+{
+    if (Delta.bIsPlayerSide != bIsPlayerOwned || bDeathStarted)
+    {
+        return;
+    }
+
+    if (Delta.Type == EBattlefieldDeltaType::Cleared)
+    {
+        BeginDeath();
+        return;
+    }
+
+    if (Delta.UniqueID != UniqueID)
+    {
+        // A card before us left the field; our slot shifts down
+        if (Delta.Type == EBattlefieldDeltaType::Removed && Delta.BattlefieldIndex < BattlefieldIndex)
+        {
+            UpdateBattlefieldIndex(BattlefieldIndex - 1);
+        }
+        return;
+    }
+
+    switch (Delta.Type)
+    {
+    case EBattlefieldDeltaType::StatsChanged:
+        CardData.Attack = Delta.Attack;
+        if (Delta.Health < CardData.Health)
+        {
+            HandleDamaged(CardData.Health - Delta.Health);
+        }
+        else if (Delta.Health > CardData.Health)
+        {
+            HandleHealed(Delta.Health);
+        }
+        break;
+
+    case EBattlefieldDeltaType::Removed:
+        BeginDeath();
+        break;
+
+    default:
+        break;
+    }
+}
@@ -4,6 +4,7 @@
 #include "CoreMinimal.h"
 #include "PaperCharacter.h"
 #include "CardTypesHost.h"
+#include "CombatTypes.h"
 #include "BattlefieldCardActor.generated.h"
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnCardSelected, int32, UniqueID, bool, bIsPlayerOwned);
@@ -20,6 +21,7 @@ public:
 
 protected:
     virtual void BeginPlay() override;
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
 public:
     // === CARD DATA ===
@@ -65,6 +67,14 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Battlefield Card")
     void HandleHealed(int32 NewHealth);
 
+    // Call from the PlayDeathAnimation Blueprint when the animation ends; destroys the actor
+    UFUNCTION(BlueprintCallable, Category = "Battlefield Card")
+    void NotifyDeathAnimationFinished();
+
+    // Fallback if the Blueprint never calls NotifyDeathAnimationFinished
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Battlefield Card")
+    float DeathAnimationTimeout = 2.0f;
+
     // === UTILITY ===
     UFUNCTION(BlueprintPure, Category = "Battlefield Card")
     int32 GetUniqueID() const { return UniqueID; }
@@ -91,4 +101,19 @@ protected:
     // Event handler for damage by UniqueID
     UFUNCTION()
     void OnCardDamagedByUniqueID(int32 DamagedUniqueID, int32 DamageAmount);
+
+    // Applies battlefield deltas for this card (stats, removal) and tracks slot shifts on our side
+    UFUNCTION()
+    void OnBattlefieldDelta(const FBattlefieldDelta& Delta);
+
+private:
+    // Play the death animation while holding the combat sequencer; destroyed on NotifyDeathAnimationFinished
+    void BeginDeath();
+
+    // Presentation hold keeping the combat sequencer from advancing while we die (-1 = none)
+    int32 DeathHoldHandle = -1;
+
+    bool bDeathStarted = false;
+
+    FTimerHandle DeathTimeoutHandle;
 };
\ No newline at end of file
@@ -0,0 +1,294 @@
+// CardAbilityInterpreter.cpp - Native interpreter for compiled ability ops
+#include "CardAbilityInterpreter.h"
+#include "KevesCardKitLog.h"
+#include "KevesCardKitTrace.h"
+#include "CardCatalog.h"
+#include "CardTargetSelector.h"
+#include "HandManager.h"
+#include "CombatManager.h"
+#include "EnemyAIComponent.h"
+#include "KCKGameplayLibrary.h"
+
+namespace
+{
+    // Chosen actor that is not part of the card game (e.g. a prop): the op falls back to the gameplay library
+    bool IsExternalChosenTarget(const FCardAbilityOp& Op, const FCardAbilityContext& Context)
+    {
+        FCardTargetSet Unused;
+        return Op.Selector.Pick == ECardTargetPick::Chosen && Context.ChosenTarget
+            && !KCKTargeting::ResolveActor(Context.CombatManager, Context.ChosenTarget, Unused);
+    }
+
+    void ExecuteDamage(const FCardAbilityOp& Op, const FCardAbilityContext& Context)
+    {
+        if (IsExternalChosenTarget(Op, Context))
+        {
+            UKCKGameplayLibrary::ApplyDamage(Context.ChosenTarget, Op.Amount);
+            return;
+        }
+
+        Context.CombatManager->DamageTargets(KCKTargeting::Select(Op.Selector, Context), Op.Amount);
+    }
+
+    void ExecuteHeal(const FCardAbilityOp& Op, const FCardAbilityContext& Context)
+    {
+        if (IsExternalChosenTarget(Op, Context))
+        {
+            UKCKGameplayLibrary::HealActor(Context.ChosenTarget, Op.Amount);
+            return;
+        }
+
+        Context.CombatManager->HealTargets(KCKTargeting::Select(Op.Selector, Context), Op.Amount);
+    }
+
+    void ExecuteBuff(const FCardAbilityOp& Op, const FCardAbilityContext& Context)
+    {
+        ACombatManager* Combat = Context.CombatManager;
+
+        if (Op.Target == ECardAbilityTarget::Self)
+        {
+            bool bIsPlayerSide = true;
+            if (Combat && Context.SourceUniqueID != -1 && Combat->FindBattlefieldCard(Context.SourceUniqueID, &bIsPlayerSide))
+            {
+                // Through the modifier layers, so the buff counts toward the creature's healing cap
+                const int32 Index = Combat->FindBattlefieldIndexByUniqueID(Context.SourceUniqueID, bIsPlayerSide);
+                if (Index < FCardZoneMasks::MaxSlots)
+                {
+                    FCardTargetSet SourceSlot;
+                    SourceSlot.Field(bIsPlayerSide) = 1ull << Index;
+                    Combat->BuffTargets(SourceSlot, Op.Amount, Op.Amount2);
+                }
+            }
+            else if (Context.SourceCard)
+            {
+                UKCKGameplayLibrary::BuffCard(*Context.SourceCard, Op.Amount, Op.Amount2);
+            }
+            return;
+        }
+
+        const FCardTargetSet Targets = KCKTargeting::Select(Op.Selector, Context);
+        if (Combat)
+        {
+            Combat->BuffTargets(Targets, Op.Amount, Op.Amount2);
+        }
+        else if (Context.HandManager && Targets.PlayerHand != 0)
+        {
+            // Hand buffs still work outside combat
+            Context.HandManager->BuffHandSlots(Targets.PlayerHand, Op.Amount, Op.Amount2);
+        }
+    }
+
+    // Current values of the variables an expression can read
+    void GatherValueVars(const FCardAbilityContext& Context, FCardValueVars& OutVars)
+    {
+        const bool bPlayer = Context.bCasterIsPlayer;
+        const ACombatManager* Combat = Context.CombatManager;
+
+        OutVars[ECardValueVar::EnergySpent] = Context.EnergySpent;
+        if (Combat)
+        {
+            OutVars[ECardValueVar::Energy] = bPlayer ? Combat->CurrentEnergy : Combat->GetEnemyCurrentEnergy();
+            OutVars[ECardValueVar::CopiesPlayed] = Context.SourceCard ? Combat->GetCopiesPlayedThisTurn(Context.SourceCard->ID, bPlayer) : 0;
+            OutVars[ECardValueVar::OwnCreatures] = Combat->GetBattlefieldCardCount(bPlayer);
+            OutVars[ECardValueVar::OpposingCreatures] = Combat->GetBattlefieldCardCount(!bPlayer);
+        }
+
+        if (bPlayer && Context.HandManager)
+        {
+            OutVars[ECardValueVar::HandSize] = Context.HandManager->GetHandSize();
+            OutVars[ECardValueVar::DiscardSize] = Context.HandManager->GetDiscardPileSize();
+        }
+        else if (!bPlayer && Combat && Combat->EnemyAIComponent)
+        {
+            OutVars[ECardValueVar::HandSize] = Combat->EnemyAIComponent->GetHandSize();
+            OutVars[ECardValueVar::DiscardSize] = Combat->EnemyAIComponent->GetDiscardPileSize();
+        }
+    }
+
+    // Copy of Op with its Amount / Count expressions evaluated
+    const FCardAbilityOp& ResolveExpressions(const FCardCatalog& Catalog, const FCardAbilityOp& Op, const FCardAbilityContext& Context, FCardAbilityOp& OutResolved)
+    {
+        FCardValueVars Vars;
+        GatherValueVars(Context, Vars);
+
+        OutResolved = Op;
+        if (Op.AmountExpr.IsSet())
+        {
+            OutResolved.Amount = KCKValueExpr::Evaluate(Catalog.GetExprCode(Op.AmountExpr), Vars);
+        }
+        if (Op.CountExpr.IsSet())
+        {
+            OutResolved.Count = (int16)FMath::Clamp(KCKValueExpr::Evaluate(Catalog.GetExprCode(Op.CountExpr), Vars), 0, (int32)MAX_int16);
+        }
+
+        KCK_LOG_HOT(LogKevesCardKitAbility, Verbose, TEXT("[KCK] Ability op %d values resolved: Amount %d, Count %d"),
+            (int32)Op.Op, OutResolved.Amount, (int32)OutResolved.Count);
+        return OutResolved;
+    }
+
+    void ExecuteBanish(const FCardAbilityOp& Op, const FCardAbilityContext& Context)
+    {
+        AHandManager* Hand = Context.bCasterIsPlayer ? Context.HandManager : nullptr;
+        if (!Hand)
+        {
+            return;
+        }
+
+        if (Op.Target == ECardAbilityTarget::Self)
+        {
+            // The played card has already left the hand; send it to the banish pile instead of discarding it
+            if (Context.SourceCard)
+            {
+                Hand->AddCardToBanishPile(Context.SourceCard->ID);
+            }
+        }
+        else if (Op.Target == ECardAbilityTarget::OwnHand)
+        {
+            // No hand selection yet: banish from the leftmost slot
+            for (int32 i = 0; i < Op.Count && Hand->GetHandSize() > 0; i++)
+            {
+                Hand->BanishCardFromHand(0);
+            }
+        }
+    }
+}
+
+namespace KCKAbility
+{
+    int32 Execute(const FCardCatalog& Catalog, int32 AbilityID, FCardAbilityContext& Context)
+    {
+        KCK_TRACE_SCOPE(KCK_ExecuteAbility);
+
+        if (!Catalog.HasAbility(AbilityID))
+        {
+            UE_LOG(LogKevesCardKitAbility, Warning, TEXT("[KCK] Ability ID %d not found."), AbilityID);
+            return 0;
+        }
+
+        const TConstArrayView<FCardAbilityOp> Ops = Catalog.GetAbilityOps(AbilityID);
+        for (const FCardAbilityOp& Op : Ops)
+        {
+            ExecuteOp(Catalog, Op, Context);
+        }
+
+        KCK_LOG_HOT(LogKevesCardKitAbility, Verbose, TEXT("[KCK] Ability %d executed %d ops (caster: %s)"),
+            AbilityID, Ops.Num(), Context.bCasterIsPlayer ? TEXT("player") : TEXT("enemy"));
+
+        return Ops.Num();
+    }
+
+    void ExecuteOp(const FCardCatalog& Catalog, const FCardAbilityOp& CompiledOp, FCardAbilityContext& Context)
+    {
+        // "X" values are evaluated against the current combat state; plain ops run as compiled
+        FCardAbilityOp ResolvedOp;
+        const FCardAbilityOp& Op = (CompiledOp.AmountExpr.IsSet() || CompiledOp.CountExpr.IsSet())
+            ? ResolveExpressions(Catalog, CompiledOp, Context, ResolvedOp)
+            : CompiledOp;
+
+        ACombatManager* Combat = Context.CombatManager;
+        AHandManager* Hand = Context.bCasterIsPlayer ? Context.HandManager : nullptr;
+        UEnemyAIComponent* EnemyAI = (!Context.bCasterIsPlayer && Combat) ? Combat->EnemyAIComponent : nullptr;
+
+        // Ops that touch the battlefield or life crystals need a combat manager
+        const bool bNeedsCombat = Op.Op == ECardAbilityOp::DealDamage || Op.Op == ECardAbilityOp::Heal
+            || Op.Op == ECardAbilityOp::Summon || Op.Op == ECardAbilityOp::GainEnergy || Op.Op == ECardAbilityOp::ApplyStatus
+            || Op.Op == ECardAbilityOp::AddAura;
+        if (bNeedsCombat && !Combat)
+        {
+            UE_LOG(LogKevesCardKitAbility, Warning, TEXT("[KCK] Ability op %d skipped - no CombatManager"), (int32)Op.Op);
+            return;
+        }
+
+        KCK_TRACE_EFFECT_RESOLVED();
+
+        switch (Op.Op)
+        {
+        case ECardAbilityOp::DrawCards:
+            if (Hand)
+            {
+                Hand->DrawCards(Op.Count);
+            }
+            else if (EnemyAI)
+            {
+                EnemyAI->DrawCards(Op.Count);
+            }
+            break;
+
+        case ECardAbilityOp::AddCardToHand:
+            if (Hand)
+            {
+                const int32 CardID = Catalog.GetCard(Op.CardIndex).ID;
+                for (int32 i = 0; i < Op.Count; i++)
+                {
+                    Hand->AddCardToHand(CardID);
+                }
+            }
+            break;
+
+        case ECardAbilityOp::AddCardToDeck:
+            if (Hand)
+            {
+                const int32 CardID = Catalog.GetCard(Op.CardIndex).ID;
+                for (int32 i = 0; i < Op.Count; i++)
+                {
+                    Hand->AddCardToDeck(CardID);
+                }
+            }
+            break;
+
+        case ECardAbilityOp::DealDamage:
+            ExecuteDamage(Op, Context);
+            break;
+
+        case ECardAbilityOp::Heal:
+            ExecuteHeal(Op, Context);
+            break;
+
+        case ECardAbilityOp::Buff:
+            ExecuteBuff(Op, Context);
+            break;
+
+        case ECardAbilityOp::Banish:
+            ExecuteBanish(Op, Context);
+            break;
+
+        case ECardAbilityOp::GainEnergy:
+            if (Context.bCasterIsPlayer)
+            {
+                Combat->SetPlayerEnergy(Combat->CurrentEnergy + Op.Amount);
+            }
+            else if (EnemyAI)
+            {
+                EnemyAI->SetCurrentEnergy(EnemyAI->GetCurrentEnergy() + Op.Amount);
+            }
+            break;
+
+        case ECardAbilityOp::Summon:
+            for (int32 i = 0; i < Op.Count; i++)
+            {
+                Combat->SummonCreature(Catalog.GetCard(Op.CardIndex), Context.bCasterIsPlayer);
+            }
+            break;
+
+        case ECardAbilityOp::ApplyStatus:
+            // Creatures only; Self means the source creature when it is in play
+            if (Op.Target == ECardAbilityTarget::Self)
+            {
+                Combat->ApplyStatusEffect(Context.SourceUniqueID, Op.Status, Op.Amount, Op.Amount2);
+            }
+            else
+            {
+                Combat->ApplyStatusToTargets(KCKTargeting::Select(Op.Selector, Context), Op.Status, Op.Amount, Op.Amount2);
+            }
+            break;
+
+        case ECardAbilityOp::AddAura:
+            // Tied to the source permanent when it is one; a power's or spell's aura lasts the combat
+            Combat->AddAura(Op.Selector, Context.bCasterIsPlayer, Op.Amount, Op.Amount2, Op.CostDelta, Context.SourceUniqueID);
+            break;
+
+        default:
+            break;
+        }
+    }
+}
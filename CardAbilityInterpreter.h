@@ -0,0 +1,42 @@
+// CardAbilityInterpreter.h - Runs compiled ability programs against the combat managers
+#pragma once
+
+#include "CoreMinimal.h"
+#include "CardTypesHost.h"
+
+class FCardCatalog;
+struct FCardAbilityOp;
+class AHandManager;
+class ACombatManager;
+
+// Everything a program can touch. Sides are relative to the caster.
+struct FCardAbilityContext
+{
+    // Player's hand; hand/deck ops are skipped when the caster is the enemy
+    AHandManager* HandManager = nullptr;
+
+    ACombatManager* CombatManager = nullptr;
+
+    bool bCasterIsPlayer = true;
+
+    // Card being played; Self buffs modify this copy
+    FCardData* SourceCard = nullptr;
+
+    // Battlefield UniqueID when the source is a creature in play (triggered abilities); Self buffs then apply to it
+    int32 SourceUniqueID = -1;
+
+    // Energy paid for the card being played ("X" in value expressions)
+    int32 EnergySpent = 0;
+
+    // Actor picked by the player (battlefield creature or any other actor), may be null
+    AActor* ChosenTarget = nullptr;
+};
+
+namespace KCKAbility
+{
+    // Run an ability's compiled ops in order. Returns the number of ops executed (0 for unknown/empty abilities).
+    KEVESCARDKIT_API int32 Execute(const FCardCatalog& Catalog, int32 AbilityID, FCardAbilityContext& Context);
+
+    // Run a single op (exposed for tools that step through programs)
+    KEVESCARDKIT_API void ExecuteOp(const FCardCatalog& Catalog, const FCardAbilityOp& Op, FCardAbilityContext& Context);
+}
@@ -1,6 +1,10 @@
 // CardActor.cpp - Card Actor Implementation
 #include "CardActor.h"
+#include "KevesCardKitLog.h"
+#include "KevesCardKitTrace.h"
+#include "KevesCardKitMemory.h"
 #include "KCKGameplayLibrary.h"
+#include "CardCatalog.h"
 #include "HandManager.h"
 #include "Kismet/GameplayStatics.h"
 
@@ -14,6 +18,15 @@ ACardActor::ACardActor()
 void ACardActor::BeginPlay()
 {
     Super::BeginPlay();
+
+    KCKMemory::AddBytes(ECardKitMemoryCategory::Actors, GetClass()->GetStructureSize());
+}
+
+void ACardActor::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    KCKMemory::AddBytes(ECardKitMemoryCategory::Actors, -GetClass()->GetStructureSize());
+
+    Super::EndPlay(EndPlayReason);
 }
 
 void ACardActor::InitializeCard(const FCardData& InCardData, UDataTable* InCardDataTable, UDataTable* InAbilityDataTable)
@@ -22,23 +35,25 @@ void ACardActor::InitializeCard(const FCardData& InCardData, UDataTable* InCardD
     CardDataTable = InCardDataTable;
     AbilityDataTable = InAbilityDataTable;
 
-    UE_LOG(LogTemp, Log, TEXT("[CardActor] Initialized card: %s (ID: %d, AbilityID: %d)"),
+    KCK_LOG_HOT(LogKevesCardKitAbility, Verbose, TEXT("[CardActor] Initialized card: %s (ID: %d, AbilityID: %d)"),
         *CardData.Name.ToString(), CardData.ID, CardData.AbilityID);
 }
 
 void ACardActor::ActivateAbility(AActor* Target)
 {
-    UE_LOG(LogTemp, Log, TEXT("[CardActor] ActivateAbility called for card: %s (AbilityID: %d)"),
+    KCK_TRACE_SCOPE(KCK_ActivateAbility);
+
+    KCK_LOG_HOT(LogKevesCardKitAbility, Verbose, TEXT("[CardActor] ActivateAbility called for card: %s (AbilityID: %d)"),
         *CardData.Name.ToString(), CardData.AbilityID);
     
     if (CardData.AbilityID <= 0)
     {
-        UE_LOG(LogTemp, Log, TEXT("[CardActor] Card '%s' has no ability (AbilityID: %d)"),
+        KCK_LOG_HOT(LogKevesCardKitAbility, Verbose, TEXT("[CardActor] Card '%s' has no ability (AbilityID: %d)"),
             *CardData.Name.ToString(), CardData.AbilityID);
         return;
     }
 
-    UE_LOG(LogTemp, Log, TEXT("[CardActor] Activating ability %d for card: %s"),
+    KCK_LOG_HOT(LogKevesCardKitAbility, Verbose, TEXT("[CardActor] Activating ability %d for card: %s"),
         CardData.AbilityID, *CardData.Name.ToString());
 
     // If no target is provided, try to find the HandManager in the world
@@ -52,7 +67,7 @@ void ACardActor::ActivateAbility(AActor* Target)
             if (FoundActors.Num() > 0)
             {
                 ActualTarget = FoundActors[0];
-                UE_LOG(LogTemp, Log, TEXT("[CardActor] Found HandManager in world: %s"), *ActualTarget->GetName());
+                KCK_LOG_HOT(LogKevesCardKitAbility, Verbose, TEXT("[CardActor] Found HandManager in world: %s"), *ActualTarget->GetName());
             }
         }
     }
@@ -64,20 +79,16 @@ void ACardActor::ExecuteAbilityByID(int32 AbilityID, AActor* Target)
 {
     if (!AbilityDataTable)
     {
-        UE_LOG(LogTemp, Error, TEXT("[CardActor] No AbilityDataTable set!"));
+        UE_LOG(LogKevesCardKitAbility, Error, TEXT("[CardActor] No AbilityDataTable set!"));
         return;
     }
 
-    FCardAbility* Ability = FindAbilityByID(AbilityID);
-    if (!Ability)
+    if (!FCardCatalog::Get(CardDataTable, AbilityDataTable)->HasAbility(AbilityID))
     {
-        UE_LOG(LogTemp, Warning, TEXT("[CardActor] Ability ID %d not found in AbilityDataTable"), AbilityID);
+        UE_LOG(LogKevesCardKitAbility, Warning, TEXT("[CardActor] Ability ID %d not found in AbilityDataTable"), AbilityID);
         return;
     }
 
-    UE_LOG(LogTemp, Log, TEXT("[CardActor] Found ability: %s (Type: %d)"),
-        *Ability->Name.ToString(), (int32)Ability->AbilityType);
-
     // Use the gameplay library to execute the ability
     UKCKGameplayLibrary::ExecuteAbilityByID(
         AbilityID,
@@ -88,21 +99,6 @@ void ACardActor::ExecuteAbilityByID(int32 AbilityID, AActor* Target)
         Target
     );
 
-    UE_LOG(LogTemp, Log, TEXT("[CardActor] Ability execution completed for: %s"),
+    KCK_LOG_HOT(LogKevesCardKitAbility, Verbose, TEXT("[CardActor] Ability execution completed for: %s"),
         *CardData.Name.ToString());
 }
-
-FCardAbility* ACardActor::FindAbilityByID(int32 AbilityID)
-{
-    if (!AbilityDataTable) return nullptr;
-
-    for (const FName& RowName : AbilityDataTable->GetRowNames())
-    {
-        FCardAbility* FoundAbility = AbilityDataTable->FindRow<FCardAbility>(RowName, TEXT("FindAbilityByID"));
-        if (FoundAbility && FoundAbility->ID == AbilityID)
-        {
-            return FoundAbility;
-        }
-    }
-    return nullptr;
-}
\ No newline at end of file
@@ -17,6 +17,7 @@ public:
 
 protected:
     virtual void BeginPlay() override;
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
 public:
     // Card data this actor represents
@@ -45,7 +46,4 @@ public:
 private:
     // Internal function to execute ability by ID
     void ExecuteAbilityByID(int32 AbilityID, AActor* Target);
-
-    // Helper function to find ability data
-    FCardAbility* FindAbilityByID(int32 AbilityID);
 };
\ No newline at end of file
@@ -0,0 +1,546 @@
+// CardCatalog.cpp - Catalog build, ability compilation and the shared catalog registry
+#include "CardCatalog.h"
+#include "KevesCardKitLog.h"
+#include "KevesCardKitMemory.h"
+#include "CardTargetSelector.h"
+#include "CardDisplayCache.h"
+#include "Engine/DataTable.h"
+#include "UObject/ObjectKey.h"
+
+namespace
+{
+    typedef TPair<FObjectKey, FObjectKey> FCatalogKey;
+
+    TMap<FCatalogKey, FCardCatalog::FRef>& GetCatalogs()
+    {
+        static TMap<FCatalogKey, FCardCatalog::FRef> Catalogs;
+        return Catalogs;
+    }
+
+    // Catalogs plus the tables they were built from (each table counted once)
+    void NoteCatalogMemory()
+    {
+        int64 Bytes = 0;
+        TSet<const UDataTable*> Tables;
+        for (const TPair<FCatalogKey, FCardCatalog::FRef>& Entry : GetCatalogs())
+        {
+            Bytes += Entry.Value->GetAllocatedSize();
+            Tables.Add(Entry.Value->GetCardTable());
+            Tables.Add(Entry.Value->GetAbilityTable());
+        }
+        for (const UDataTable* Table : Tables)
+        {
+            Bytes += KCKMemory::GetDataTableBytes(Table);
+        }
+        KCKMemory::SetBytes(ECardKitMemoryCategory::CardDefinitions, Bytes);
+    }
+
+    bool OpNeedsCard(ECardAbilityOp Op)
+    {
+        return Op == ECardAbilityOp::AddCardToHand || Op == ECardAbilityOp::AddCardToDeck || Op == ECardAbilityOp::Summon;
+    }
+
+    bool IsTableOf(const UDataTable* Table, const UScriptStruct* RowStruct)
+    {
+        return Table && Table->GetRowStruct() && Table->GetRowStruct()->IsChildOf(RowStruct);
+    }
+
+    // Ability compiles a reference to one of these card IDs
+    bool ReferencesAnyCard(const FCardAbility& Ability, const TSet<int32>& CardIDs)
+    {
+        for (const FCardAbilityStep& Step : Ability.Steps)
+        {
+            if (CardIDs.Contains(Step.CardID))
+            {
+                return true;
+            }
+        }
+        for (int32 CardID : Ability.CardIDsToAffect)
+        {
+            if (CardIDs.Contains(CardID))
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+}
+
+// ==== REGISTRY ====
+
+FCardCatalog::FRef FCardCatalog::Get(const UDataTable* InCardTable, const UDataTable* InAbilityTable)
+{
+    check(IsInGameThread());
+
+    TMap<FCatalogKey, FRef>& Catalogs = GetCatalogs();
+
+    const FCatalogKey Key(FObjectKey(InCardTable), FObjectKey(InAbilityTable));
+    if (const FRef* Found = Catalogs.Find(Key))
+    {
+        return *Found;
+    }
+
+    // Forget catalogs whose tables have been unloaded
+    for (auto It = Catalogs.CreateIterator(); It; ++It)
+    {
+        if (It.Value()->CardTable.IsStale() || It.Value()->AbilityTable.IsStale())
+        {
+            It.RemoveCurrent();
+        }
+    }
+
+    TSharedRef<FCardCatalog, ESPMode::ThreadSafe> Catalog = MakeShared<FCardCatalog, ESPMode::ThreadSafe>();
+    Catalog->Build(InCardTable, InAbilityTable);
+    Catalogs.Add(Key, Catalog);
+
+#if WITH_EDITOR
+    ListenForChanges(InCardTable);
+    ListenForChanges(InAbilityTable);
+#endif
+
+    NoteCatalogMemory();
+    return Catalog;
+}
+
+// ==== LOOKUPS ====
+
+const FCardData* FCardCatalog::FindCard(int32 CardID) const
+{
+    const int32* Index = CardIndexByID.Find(CardID);
+    return Index ? &Cards[*Index] : nullptr;
+}
+
+int32 FCardCatalog::FindCardIndex(int32 CardID) const
+{
+    const int32* Index = CardIndexByID.Find(CardID);
+    return Index ? *Index : INDEX_NONE;
+}
+
+TConstArrayView<FCardAbilityOp> FCardCatalog::GetAbilityOps(int32 AbilityID) const
+{
+    const FOpRange* Range = AbilityRanges.Find(AbilityID);
+    if (!Range)
+    {
+        return TConstArrayView<FCardAbilityOp>();
+    }
+    return TConstArrayView<FCardAbilityOp>(Ops.GetData() + Range->FirstOp, Range->NumOps);
+}
+
+ECardTriggerEvent FCardCatalog::GetAbilityTrigger(int32 AbilityID, ECardTriggerSide* OutSide) const
+{
+    const FOpRange* Range = AbilityRanges.Find(AbilityID);
+    if (OutSide)
+    {
+        *OutSide = Range ? Range->TriggerSide : ECardTriggerSide::Any;
+    }
+    return Range ? Range->Trigger : ECardTriggerEvent::None;
+}
+
+int64 FCardCatalog::GetAllocatedSize() const
+{
+    return Cards.GetAllocatedSize() + CardIndexByID.GetAllocatedSize() + Ops.GetAllocatedSize() + AbilityRanges.GetAllocatedSize()
+        + ExprCode.GetAllocatedSize() + AbilitySources.GetAllocatedSize();
+}
+
+// ==== BUILD ====
+
+void FCardCatalog::Build(const UDataTable* InCardTable, const UDataTable* InAbilityTable)
+{
+    LLM_SCOPE_BYTAG(KevesCardKit_CardDefinitions);
+
+    CardTable = InCardTable;
+    AbilityTable = InAbilityTable;
+
+    // Cards first, so ability steps can resolve card IDs to indices
+    if (IsTableOf(InCardTable, FCardData::StaticStruct()))
+    {
+        const TMap<FName, uint8*>& RowMap = InCardTable->GetRowMap();
+        Cards.Reserve(RowMap.Num());
+        CardIndexByID.Reserve(RowMap.Num());
+
+        for (const TPair<FName, uint8*>& Row : RowMap)
+        {
+            const FCardData& Card = *reinterpret_cast<const FCardData*>(Row.Value);
+            if (CardIndexByID.Contains(Card.ID))
+            {
+                UE_LOG(LogKevesCardKitAbility, Warning, TEXT("[CardCatalog] Duplicate card ID %d in row %s ignored"), Card.ID, *Row.Key.ToString());
+                continue;
+            }
+            CardIndexByID.Add(Card.ID, Cards.Add(Card));
+        }
+    }
+
+    if (IsTableOf(InAbilityTable, FCardAbility::StaticStruct()))
+    {
+        const TMap<FName, uint8*>& RowMap = InAbilityTable->GetRowMap();
+        AbilityRanges.Reserve(RowMap.Num());
+
+        for (const TPair<FName, uint8*>& Row : RowMap)
+        {
+            const FCardAbility& Ability = *reinterpret_cast<const FCardAbility*>(Row.Value);
+            if (AbilityRanges.Contains(Ability.ID))
+            {
+                UE_LOG(LogKevesCardKitAbility, Warning, TEXT("[CardCatalog] Duplicate ability ID %d in row %s ignored"), Ability.ID, *Row.Key.ToString());
+                continue;
+            }
+            CompileAbility(Ability);
+        }
+    }
+
+    Ops.Shrink();
+    ExprCode.Shrink();
+
+    UE_LOG(LogKevesCardKitAbility, Log, TEXT("[CardCatalog] Built %d cards, %d abilities (%d ops) from %s / %s"),
+        Cards.Num(), AbilityRanges.Num(), Ops.Num(), *GetNameSafe(InCardTable), *GetNameSafe(InAbilityTable));
+}
+
+void FCardCatalog::CompileAbility(const FCardAbility& Ability)
+{
+    FOpRange Range;
+    Range.FirstOp = Ops.Num();
+    Range.Trigger = Ability.Trigger;
+    Range.TriggerSide = Ability.TriggerSide;
+
+    if (Ability.Steps.Num() > 0)
+    {
+        for (const FCardAbilityStep& Step : Ability.Steps)
+        {
+            CompileStep(Ability, Step);
+        }
+    }
+    else
+    {
+        // Legacy single-type abilities become the equivalent one- or few-step program
+        FCardAbilityStep Step;
+        switch (Ability.AbilityType)
+        {
+        case ECardAbilityType::DrawSpecificCard:
+            if (Ability.CardIDsToAffect.Num() > 0)
+            {
+                Step.Op = ECardAbilityOp::AddCardToHand;
+                Step.CardID = Ability.CardIDsToAffect[0];
+                Step.Count = Ability.Count;
+                CompileStep(Ability, Step);
+            }
+            else
+            {
+                UE_LOG(LogKevesCardKitAbility, Warning, TEXT("[CardCatalog] Ability %d: DrawSpecificCard has no CardIDsToAffect"), Ability.ID);
+            }
+            break;
+
+        case ECardAbilityType::DrawMultipleCards:
+            for (int32 CardID : Ability.CardIDsToAffect)
+            {
+                Step.Op = ECardAbilityOp::AddCardToHand;
+                Step.CardID = CardID;
+                Step.Count = Ability.Count;
+                CompileStep(Ability, Step);
+            }
+            break;
+
+        case ECardAbilityType::BuffAllCreatures:
+            Step.Op = ECardAbilityOp::Buff;
+            Step.Target = ECardAbilityTarget::OwnCreatures;
+            Step.Amount = Ability.Amount;
+            Step.Amount2 = Ability.Amount;
+            CompileStep(Ability, Step);
+            break;
+
+        case ECardAbilityType::ApplyDamage:
+            Step.Op = ECardAbilityOp::DealDamage;
+            Step.Target = ECardAbilityTarget::ChosenTarget;
+            Step.Amount = Ability.Amount;
+            CompileStep(Ability, Step);
+            break;
+
+        case ECardAbilityType::HealActor:
+            Step.Op = ECardAbilityOp::Heal;
+            Step.Target = ECardAbilityTarget::ChosenTarget;
+            Step.Amount = Ability.Amount;
+            CompileStep(Ability, Step);
+            break;
+
+        case ECardAbilityType::BuffCard:
+            Step.Op = ECardAbilityOp::Buff;
+            Step.Target = ECardAbilityTarget::Self;
+            Step.Amount = Ability.Amount;
+            Step.Amount2 = Ability.Amount;
+            CompileStep(Ability, Step);
+            break;
+
+        case ECardAbilityType::None:
+            break;
+
+        default:
+            UE_LOG(LogKevesCardKitAbility, Warning, TEXT("[CardCatalog] Ability %d: unknown ability type %d"), Ability.ID, (int32)Ability.AbilityType);
+            break;
+        }
+    }
+
+    Range.NumOps = Ops.Num() - Range.FirstOp;
+    AbilityRanges.Add(Ability.ID, Range);
+    AbilitySources.Add(Ability.ID, Ability);
+}
+
+void FCardCatalog::CompileStep(const FCardAbility& Ability, const FCardAbilityStep& Step)
+{
+    if (Step.Op == ECardAbilityOp::None)
+    {
+        return;
+    }
+
+    FCardAbilityOp Op;
+    Op.Op = Step.Op;
+    Op.Target = Step.Target;
+    Op.Count = (int16)FMath::Clamp(Step.Count, 0, (int32)MAX_int16);
+    Op.Amount = Step.Amount;
+    Op.Amount2 = Step.Amount2;
+    Op.Status = Step.Status;
+    Op.CostDelta = Step.CostDelta;
+    Op.Selector = (Step.Target == ECardAbilityTarget::Selector) ? Step.Selector : KCKTargeting::MakeSelector(Step.Target);
+
+    if (OpNeedsCard(Step.Op))
+    {
+        Op.CardIndex = FindCardIndex(Step.CardID);
+        if (Op.CardIndex == INDEX_NONE)
+        {
+            UE_LOG(LogKevesCardKitAbility, Warning, TEXT("[CardCatalog] Ability %d: step references unknown card ID %d, step skipped"), Ability.ID, Step.CardID);
+            return;
+        }
+
+        const ECardType CardType = Cards[Op.CardIndex].CardType;
+        if (Step.Op == ECardAbilityOp::Summon && CardType != ECardType::Creature && CardType != ECardType::Champion)
+        {
+            UE_LOG(LogKevesCardKitAbility, Warning, TEXT("[CardCatalog] Ability %d: cannot summon non-creature card %d, step skipped"), Ability.ID, Step.CardID);
+            return;
+        }
+    }
+
+    Op.AmountExpr = CompileExpression(Ability, Step.AmountExpression);
+    Op.CountExpr = CompileExpression(Ability, Step.CountExpression);
+    Ops.Add(Op);
+}
+
+FCardExprRange FCardCatalog::CompileExpression(const FCardAbility& Ability, const FString& Source)
+{
+    FCardExprRange Range;
+    if (Source.TrimStartAndEnd().IsEmpty())
+    {
+        return Range;
+    }
+
+    FString Error;
+    Range.First = ExprCode.Num();
+    if (!KCKValueExpr::Compile(Source, ExprCode, Error))
+    {
+        UE_LOG(LogKevesCardKitAbility, Warning, TEXT("[CardCatalog] Ability %d: expression \"%s\" - %s, using the fixed value"),
+            Ability.ID, *Source, *Error);
+        return FCardExprRange();
+    }
+
+    Range.Num = ExprCode.Num() - Range.First;
+    return Range;
+}
+
+// ==== LIVE EDITING ====
+
+bool FCardCatalog::ApplyTableChanges(bool bCardTableChanged, bool bAbilityTableChanged, TArray<int32>& OutChangedCardIDs, int32& OutRecompiledAbilities)
+{
+    LLM_SCOPE_BYTAG(KevesCardKit_CardDefinitions);
+
+    const UDataTable* InCardTable = CardTable.Get();
+    const UDataTable* InAbilityTable = AbilityTable.Get();
+    OutRecompiledAbilities = 0;
+
+    TSet<int32> ChangedCardIDs;
+    if (bCardTableChanged)
+    {
+        if (!IsTableOf(InCardTable, FCardData::StaticStruct()))
+        {
+            return false;
+        }
+
+        const UScriptStruct* CardStruct = FCardData::StaticStruct();
+        TBitArray<> Seen(false, Cards.Num());
+        for (const TPair<FName, uint8*>& Row : InCardTable->GetRowMap())
+        {
+            const FCardData& Card = *reinterpret_cast<const FCardData*>(Row.Value);
+            const int32* Index = CardIndexByID.Find(Card.ID);
+            if (!Index)
+            {
+                CardIndexByID.Add(Card.ID, Cards.Add(Card));
+                Seen.Add(true);
+                ChangedCardIDs.Add(Card.ID);
+            }
+            else if (!Seen[*Index])
+            {
+                // Later rows with the same ID were ignored by Build as well
+                Seen[*Index] = true;
+                if (!CardStruct->CompareScriptStruct(&Cards[*Index], &Card, PPF_None))
+                {
+                    Cards[*Index] = Card;
+                    ChangedCardIDs.Add(Card.ID);
+                }
+            }
+        }
+
+        // A removed (or renumbered) card would shift the indices compiled ops point at
+        if (Seen.Find(false) != INDEX_NONE)
+        {
+            return false;
+        }
+    }
+
+    if ((bAbilityTableChanged || ChangedCardIDs.Num() > 0) && IsTableOf(InAbilityTable, FCardAbility::StaticStruct()))
+    {
+        const UScriptStruct* AbilityStruct = FCardAbility::StaticStruct();
+        TSet<int32> SeenAbilities;
+        for (const TPair<FName, uint8*>& Row : InAbilityTable->GetRowMap())
+        {
+            const FCardAbility& Ability = *reinterpret_cast<const FCardAbility*>(Row.Value);
+            bool bAlreadySeen = false;
+            SeenAbilities.Add(Ability.ID, &bAlreadySeen);
+            if (bAlreadySeen)
+            {
+                continue;
+            }
+
+            const FCardAbility* Source = AbilitySources.Find(Ability.ID);
+            const bool bRowChanged = !Source || !AbilityStruct->CompareScriptStruct(Source, &Ability, PPF_None);
+            if (bRowChanged || ReferencesAnyCard(Ability, ChangedCardIDs))
+            {
+                if (const FOpRange* OldRange = AbilityRanges.Find(Ability.ID))
+                {
+                    DeadOps += OldRange->NumOps;
+                }
+                CompileAbility(Ability);
+                OutRecompiledAbilities++;
+            }
+        }
+
+        for (auto It = AbilityRanges.CreateIterator(); It; ++It)
+        {
+            if (!SeenAbilities.Contains(It.Key()))
+            {
+                DeadOps += It.Value().NumOps;
+                AbilitySources.Remove(It.Key());
+                It.RemoveCurrent();
+                OutRecompiledAbilities++;
+            }
+        }
+    }
+    else if (bAbilityTableChanged)
+    {
+        return false;
+    }
+
+    if (DeadOps > Ops.Num() / 2)
+    {
+        CompactOps();
+    }
+
+    OutChangedCardIDs = ChangedCardIDs.Array();
+    return true;
+}
+
+void FCardCatalog::CompactOps()
+{
+    TArray<FCardAbilityOp> NewOps;
+    TArray<FCardExprInstr> NewExprCode;
+    NewOps.Reserve(Ops.Num() - DeadOps);
+
+    auto MoveExpression = [this, &NewExprCode](FCardExprRange& Range)
+    {
+        if (Range.IsSet())
+        {
+            const int32 First = NewExprCode.Num();
+            NewExprCode.Append(ExprCode.GetData() + Range.First, Range.Num);
+            Range.First = First;
+        }
+    };
+
+    for (TPair<int32, FOpRange>& Entry : AbilityRanges)
+    {
+        FOpRange& Range = Entry.Value;
+        const int32 FirstOp = NewOps.Num();
+        for (int32 i = 0; i < Range.NumOps; i++)
+        {
+            FCardAbilityOp& Op = NewOps.Add_GetRef(Ops[Range.FirstOp + i]);
+            MoveExpression(Op.AmountExpr);
+            MoveExpression(Op.CountExpr);
+        }
+        Range.FirstOp = FirstOp;
+    }
+
+    Ops = MoveTemp(NewOps);
+    ExprCode = MoveTemp(NewExprCode);
+    DeadOps = 0;
+}
+
+#if WITH_EDITOR
+void FCardCatalog::ListenForChanges(const UDataTable* Table)
+{
+    static TSet<FObjectKey> ListenedTables;
+
+    bool bAlreadyListening = false;
+    ListenedTables.Add(FObjectKey(Table), &bAlreadyListening);
+    if (Table && !bAlreadyListening)
+    {
+        const_cast<UDataTable*>(Table)->OnDataTableChanged().AddStatic(&FCardCatalog::HandleTableChanged, FObjectKey(Table));
+    }
+}
+
+void FCardCatalog::HandleTableChanged(FObjectKey TableKey)
+{
+    TMap<FCatalogKey, FRef>& Catalogs = GetCatalogs();
+    for (TPair<FCatalogKey, FRef>& Entry : Catalogs)
+    {
+        const bool bCardTableChanged = Entry.Key.Key == TableKey;
+        const bool bAbilityTableChanged = Entry.Key.Value == TableKey;
+        if (!bCardTableChanged && !bAbilityTableChanged)
+        {
+            continue;
+        }
+
+        const FCardCatalog& Current = *Entry.Value;
+        if (Current.CardTable.IsStale() || Current.AbilityTable.IsStale())
+        {
+            continue;
+        }
+
+        // Copy-on-write: readers holding the current snapshot are never touched
+        const double StartTime = FPlatformTime::Seconds();
+        TSharedRef<FCardCatalog, ESPMode::ThreadSafe> Updated = MakeShared<FCardCatalog, ESPMode::ThreadSafe>(Current);
+        TArray<int32> ChangedCardIDs;
+        int32 RecompiledAbilities = 0;
+        const bool bIncremental = Updated->ApplyTableChanges(bCardTableChanged, bAbilityTableChanged, ChangedCardIDs, RecompiledAbilities);
+        if (!bIncremental)
+        {
+            Updated = MakeShared<FCardCatalog, ESPMode::ThreadSafe>();
+            Updated->Build(Current.GetCardTable(), Current.GetAbilityTable());
+        }
+
+        Current.bSuperseded = true;
+        Entry.Value = Updated;
+
+        FCardDisplayDataCache& DisplayCache = FCardDisplayDataCache::Get();
+        if (bIncremental)
+        {
+            for (int32 CardID : ChangedCardIDs)
+            {
+                DisplayCache.Invalidate(CardID);
+            }
+        }
+        else
+        {
+            DisplayCache.InvalidateAll();
+        }
+
+        UE_LOG(LogKevesCardKitAbility, Log, TEXT("[CardCatalog] %s: %s update, %d cards changed, %d abilities recompiled (%.2f ms)"),
+            *GetNameSafe(TableKey.ResolveObjectPtr()), bIncremental ? TEXT("incremental") : TEXT("full"),
+            ChangedCardIDs.Num(), RecompiledAbilities, (FPlatformTime::Seconds() - StartTime) * 1000.0);
+    }
+
+    NoteCatalogMemory();
+}
+#endif
@@ -0,0 +1,123 @@
+// CardCatalog.h - Card definitions indexed by ID, with abilities compiled to flat op lists
+#pragma once
+
+#include "CoreMinimal.h"
+#include "CardTypesHost.h"
+#include "CardValueExpression.h"
+#include "UObject/ObjectKey.h"
+
+class UDataTable;
+
+// One compiled ability step. Card references are resolved to catalog indices at build time,
+// so running an ability never touches a DataTable.
+struct FCardAbilityOp
+{
+    ECardAbilityOp Op = ECardAbilityOp::None;
+    ECardAbilityTarget Target = ECardAbilityTarget::Self;
+    int16 Count = 1;
+    int32 Amount = 0;
+    int32 Amount2 = 0;
+    int32 CardIndex = INDEX_NONE;
+    ECardStatusEffect Status = ECardStatusEffect::Poison;
+    int32 CostDelta = 0;
+
+    // Compiled AmountExpression / CountExpression (see FCardCatalog::GetExprCode)
+    FCardExprRange AmountExpr;
+    FCardExprRange CountExpr;
+
+    // Target resolved to a selector query (empty for Self)
+    FCardTargetSelector Selector;
+};
+
+/**
+ * Immutable snapshot of a card table and an ability table. Cards are stored contiguously with an
+ * ID -> index map; every ability becomes a range in one shared op array. Legacy single-type abilities
+ * (FCardAbility::AbilityType) are compiled into the same op form as authored Steps.
+ *
+ * Catalogs are shared per table pair: hold the ref returned by Get for as long as you read from it.
+ * In the editor, editing either table swaps in an updated copy (only changed cards and the abilities
+ * that depend on them are recompiled); holders of the old ref see IsSuperseded() and re-Get.
+ */
+class KEVESCARDKIT_API FCardCatalog
+{
+public:
+    typedef TSharedRef<const FCardCatalog, ESPMode::ThreadSafe> FRef;
+
+    // Catalog for this table pair, compiled on first request (game thread). AbilityTable may be null.
+    static FRef Get(const UDataTable* CardTable, const UDataTable* AbilityTable);
+
+    // O(1) lookups; nullptr / INDEX_NONE for unknown IDs
+    const FCardData* FindCard(int32 CardID) const;
+    int32 FindCardIndex(int32 CardID) const;
+
+    const FCardData& GetCard(int32 CardIndex) const { return Cards[CardIndex]; }
+    TConstArrayView<FCardData> GetCards() const { return Cards; }
+
+    bool HasAbility(int32 AbilityID) const { return AbilityRanges.Contains(AbilityID); }
+
+    // Event that runs this ability (None for abilities that run when played)
+    ECardTriggerEvent GetAbilityTrigger(int32 AbilityID, ECardTriggerSide* OutSide = nullptr) const;
+
+    // Compiled program for an ability; empty for unknown IDs and for abilities with no effect
+    TConstArrayView<FCardAbilityOp> GetAbilityOps(int32 AbilityID) const;
+
+    // Postfix code of an op's value expression (see KCKValueExpr::Evaluate)
+    TConstArrayView<FCardExprInstr> GetExprCode(const FCardExprRange& Range) const
+    {
+        return TConstArrayView<FCardExprInstr>(ExprCode.GetData() + Range.First, Range.Num);
+    }
+
+    const UDataTable* GetCardTable() const { return CardTable.Get(); }
+    const UDataTable* GetAbilityTable() const { return AbilityTable.Get(); }
+
+    // A table edit replaced this snapshot in the registry; Get returns the new one
+    bool IsSuperseded() const { return bSuperseded; }
+
+    int64 GetAllocatedSize() const;
+
+private:
+    struct FOpRange
+    {
+        int32 FirstOp = 0;
+        int32 NumOps = 0;
+        ECardTriggerEvent Trigger = ECardTriggerEvent::None;
+        ECardTriggerSide TriggerSide = ECardTriggerSide::Any;
+    };
+
+    void Build(const UDataTable* InCardTable, const UDataTable* InAbilityTable);
+    void CompileAbility(const FCardAbility& Ability);
+
+    // Bring a copy of a catalog up to date with its tables: changed/added cards are patched in place and only
+    // affected abilities are recompiled. False if it cannot be done incrementally (e.g. a card was removed).
+    bool ApplyTableChanges(bool bCardTableChanged, bool bAbilityTableChanged, TArray<int32>& OutChangedCardIDs, int32& OutRecompiledAbilities);
+
+    // Drop op and expression code left behind by recompiled abilities
+    void CompactOps();
+
+#if WITH_EDITOR
+    static void ListenForChanges(const UDataTable* Table);
+    static void HandleTableChanged(FObjectKey TableKey);
+#endif
+    void CompileStep(const FCardAbility& Ability, const FCardAbilityStep& Step);
+    FCardExprRange CompileExpression(const FCardAbility& Ability, const FString& Source);
+
+    TWeakObjectPtr<const UDataTable> CardTable;
+    TWeakObjectPtr<const UDataTable> AbilityTable;
+
+    TArray<FCardData> Cards;
+    TMap<int32, int32> CardIndexByID;
+
+    TArray<FCardAbilityOp> Ops;
+    TMap<int32, FOpRange> AbilityRanges;
+
+    // Rows the abilities were compiled from, to find what an edit changed
+    TMap<int32, FCardAbility> AbilitySources;
+
+    // Ops no longer referenced by any range (see CompactOps)
+    int32 DeadOps = 0;
+
+    mutable bool bSuperseded = false;
+
+    // Value expressions of every op, back to back
+    TArray<FCardExprInstr> ExprCode;
+};
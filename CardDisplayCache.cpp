@@ -0,0 +1,174 @@
+// CardDisplayCache.cpp - Display data cache and shared display helpers
+#include "CardDisplayCache.h"
+#include "KevesCardKitMemory.h"
+
+DEFINE_STAT(STAT_KCK_DisplayCacheHits);
+DEFINE_STAT(STAT_KCK_DisplayCacheMisses);
+
+FCardDisplayDataCache& FCardDisplayDataCache::Get()
+{
+    static FCardDisplayDataCache Instance;
+    return Instance;
+}
+
+FCardDisplayDataRef FCardDisplayDataCache::FindOrBuild(const FCardData& CardData, bool bIsPlayable, bool bIsHovered, bool bIsSelected)
+{
+    check(IsInGameThread());
+
+    FCardDisplayKey Key;
+    Key.CardID = CardData.ID;
+    Key.Cost = CardData.Cost;
+    Key.Attack = CardData.Attack;
+    Key.Health = CardData.Health;
+    Key.StateFlags = (bIsPlayable ? 1 : 0) | (bIsHovered ? 2 : 0) | (bIsSelected ? 4 : 0);
+
+    if (const FCardDisplayDataRef* Found = Entries.Find(Key))
+    {
+        Hits++;
+        INC_DWORD_STAT(STAT_KCK_DisplayCacheHits);
+        return *Found;
+    }
+
+    Misses++;
+    INC_DWORD_STAT(STAT_KCK_DisplayCacheMisses);
+
+    LLM_SCOPE_BYTAG(KevesCardKit_DisplayCache);
+
+    if (Entries.Num() >= MaxEntries)
+    {
+        Entries.Reset();
+    }
+
+    FCardDisplayDataRef Entry = MakeShared<const FCardDisplayData, ESPMode::ThreadSafe>(Build(CardData, bIsPlayable, bIsHovered, bIsSelected));
+    Entries.Add(Key, Entry);
+    NoteMemory();
+    return Entry;
+}
+
+void FCardDisplayDataCache::Invalidate(int32 CardID)
+{
+    for (auto It = Entries.CreateIterator(); It; ++It)
+    {
+        if (It.Key().CardID == CardID)
+        {
+            It.RemoveCurrent();
+        }
+    }
+    NoteMemory();
+}
+
+void FCardDisplayDataCache::InvalidateAll()
+{
+    Entries.Reset();
+    NoteMemory();
+}
+
+void FCardDisplayDataCache::NoteMemory() const
+{
+    // Map storage plus each shared entry (payload and its reference controller)
+    const int64 EntryBytes = sizeof(FCardDisplayData) + 2 * sizeof(void*) + 2 * sizeof(int32);
+    KCKMemory::SetBytes(ECardKitMemoryCategory::DisplayCache, Entries.GetAllocatedSize() + Entries.Num() * EntryBytes);
+}
+
+FCardDisplayData FCardDisplayDataCache::Build(const FCardData& CardData, bool bIsPlayable, bool bIsHovered, bool bIsSelected)
+{
+    FCardDisplayData Data;
+
+    // Core Card Data
+    Data.CardData = CardData;
+    Data.HandIndex = -1;
+
+    Data.bIsPlayable = bIsPlayable;
+    Data.bIsHovered = bIsHovered;
+    Data.bIsSelected = bIsSelected;
+
+    // Display Information
+    Data.CardTypeDisplayName = GetCardTypeDisplayName(CardData.CardType);
+    Data.FactionDisplayName = GetFactionDisplayName(CardData.CardFaction);
+    Data.FactionColor = GetFactionColor(CardData.CardFaction);
+    Data.bShouldShowAttackHealth = ShouldShowAttackHealth(CardData.CardType);
+
+    // Border color and opacity based on playability, then selection/hover
+    if (!bIsPlayable)
+    {
+        Data.CardBorderColor = FLinearColor::Gray;
+        Data.DisplayOpacity = 0.6f;
+    }
+    else if (bIsSelected)
+    {
+        Data.CardBorderColor = FLinearColor::Yellow;
+        Data.DisplayOpacity = 1.0f;
+    }
+    else if (bIsHovered)
+    {
+        Data.CardBorderColor = FLinearColor::White;
+        Data.DisplayOpacity = 1.0f;
+    }
+    else
+    {
+        Data.CardBorderColor = Data.FactionColor;
+        Data.DisplayOpacity = 1.0f;
+    }
+
+    // Format text fields for convenience
+    Data.FormattedCostText = FString::FromInt(CardData.Cost);
+
+    if (Data.bShouldShowAttackHealth)
+    {
+        Data.FormattedAttackText = FString::FromInt(CardData.Attack);
+        Data.FormattedHealthText = FString::FromInt(CardData.Health);
+    }
+    else
+    {
+        Data.FormattedAttackText = TEXT("");
+        Data.FormattedHealthText = TEXT("");
+    }
+
+    return Data;
+}
+
+// ==== DISPLAY HELPERS ====
+
+FString FCardDisplayDataCache::GetCardTypeDisplayName(ECardType CardType)
+{
+    switch (CardType)
+    {
+    case ECardType::Creature: return TEXT("Creature");
+    case ECardType::Spell: return TEXT("Spell");
+    case ECardType::Power: return TEXT("Power");
+    case ECardType::Skill: return TEXT("Skill");
+    case ECardType::Champion: return TEXT("Champion");
+    default: return TEXT("Unknown");
+    }
+}
+
+FString FCardDisplayDataCache::GetFactionDisplayName(ECardFaction Faction)
+{
+    switch (Faction)
+    {
+    case ECardFaction::Demon: return TEXT("Demon");
+    case ECardFaction::Undead: return TEXT("Undead");
+    case ECardFaction::Angel: return TEXT("Angel");
+    default: return TEXT("Neutral");
+    }
+}
+
+FLinearColor FCardDisplayDataCache::GetFactionColor(ECardFaction Faction)
+{
+    switch (Faction)
+    {
+    case ECardFaction::Demon:
+        return FLinearColor::Red;
+    case ECardFaction::Undead:
+        return FLinearColor(0.4f, 0.2f, 0.4f, 1.0f); // Purple-ish
+    case ECardFaction::Angel:
+        return FLinearColor(1.0f, 1.0f, 0.8f, 1.0f); // Light yellow
+    default:
+        return FLinearColor::White;
+    }
+}
+
+bool FCardDisplayDataCache::ShouldShowAttackHealth(ECardType CardType)
+{
+    return CardType == ECardType::Creature || CardType == ECardType::Champion;
+}
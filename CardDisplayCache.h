@@ -0,0 +1,76 @@
+// CardDisplayCache.h - Shared cache of immutable FCardDisplayData keyed by card stats and UI state
+#pragma once
+
+#include "CoreMinimal.h"
+#include "KevesCardKitStats.h"
+#include "CardDisplayTypes.h"
+
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Display Cache Hits"), STAT_KCK_DisplayCacheHits, STATGROUP_KevesCardKit, KEVESCARDKIT_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Display Cache Misses"), STAT_KCK_DisplayCacheMisses, STATGROUP_KevesCardKit, KEVESCARDKIT_API);
+
+// Everything an FCardDisplayData is derived from. Modified stats produce a different key,
+// so a buffed card never reads a stale entry.
+struct FCardDisplayKey
+{
+    int32 CardID = 0;
+    int32 Cost = 0;
+    int32 Attack = 0;
+    int32 Health = 0;
+    uint8 StateFlags = 0; // Playable | Hovered | Selected
+
+    bool operator==(const FCardDisplayKey& Other) const
+    {
+        return CardID == Other.CardID && Cost == Other.Cost && Attack == Other.Attack
+            && Health == Other.Health && StateFlags == Other.StateFlags;
+    }
+
+    friend uint32 GetTypeHash(const FCardDisplayKey& Key)
+    {
+        uint32 Hash = HashCombine(GetTypeHash(Key.CardID), GetTypeHash(Key.Cost));
+        Hash = HashCombine(Hash, GetTypeHash(Key.Attack));
+        Hash = HashCombine(Hash, GetTypeHash(Key.Health));
+        return HashCombine(Hash, Key.StateFlags);
+    }
+};
+
+/**
+ * Game-thread cache of display data shared by UCombatUIWidget and UCardUIWidget.
+ * Entries are immutable and ref-counted; HandIndex is always -1 in a cached entry,
+ * callers copy and set their own slot index.
+ */
+class KEVESCARDKIT_API FCardDisplayDataCache
+{
+public:
+    static FCardDisplayDataCache& Get();
+
+    // Entries beyond this are dropped wholesale; a hand only ever uses a few dozen
+    static constexpr int32 MaxEntries = 1024;
+
+    FCardDisplayDataRef FindOrBuild(const FCardData& CardData, bool bIsPlayable, bool bIsHovered = false, bool bIsSelected = false);
+
+    // Drop every entry for a card definition (row edited, art or text changed)
+    void Invalidate(int32 CardID);
+
+    void InvalidateAll();
+
+    int32 Num() const { return Entries.Num(); }
+    uint32 GetHits() const { return Hits; }
+    uint32 GetMisses() const { return Misses; }
+
+    // === DISPLAY HELPERS (shared with the widgets' Blueprint utilities) ===
+
+    static FString GetCardTypeDisplayName(ECardType CardType);
+    static FString GetFactionDisplayName(ECardFaction Faction);
+    static FLinearColor GetFactionColor(ECardFaction Faction);
+    static bool ShouldShowAttackHealth(ECardType CardType);
+
+private:
+    static FCardDisplayData Build(const FCardData& CardData, bool bIsPlayable, bool bIsHovered, bool bIsSelected);
+
+    // Report current size to KCKMemory
+    void NoteMemory() const;
+
+    TMap<FCardDisplayKey, FCardDisplayDataRef> Entries;
+    uint32 Hits = 0;
+    uint32 Misses = 0;
+};
@@ -3,3 +3,83 @@
 
 #include "CardDisplayTypes.h"
 
+
+// ==== HAND VIEW MODEL ====
+
+void FHandViewModel::BeginUpdate(int32 HandSize, int32 DeckSize)
+{
+    HandSize = FMath::Clamp(HandSize, 0, MaxSlots);
+
+    ChangedMask = 0;
+    ShiftedMask = 0;
+    RemovedMask = 0;
+    MatchedPreviousMask = 0;
+    bCountsChanged = HandSize != LastHandSize || DeckSize != LastDeckSize;
+    PreviousHandSize = LastHandSize;
+    LastHandSize = HandSize;
+    LastDeckSize = DeckSize;
+
+    Swap(Slots, PreviousSlots);
+    Swap(HandDisplay, PreviousDisplay);
+    Slots.SetNum(HandSize);
+    HandDisplay.SetNum(HandSize);
+}
+
+EHandSlotChange FHandViewModel::UpdateSlot(int32 Slot, int32 InstanceID, const FHandSlotInputs& Inputs)
+{
+    if (!Slots.IsValidIndex(Slot))
+    {
+        return EHandSlotChange::None;
+    }
+
+    Slots[Slot].InstanceID = InstanceID;
+    Slots[Slot].Inputs = Inputs;
+
+    // Usually the card is still in the same slot; otherwise search the (small) previous hand
+    int32 Previous = INDEX_NONE;
+    if (InstanceID != INDEX_NONE)
+    {
+        Previous = (PreviousSlots.IsValidIndex(Slot) && PreviousSlots[Slot].InstanceID == InstanceID)
+            ? Slot
+            : PreviousSlots.IndexOfByPredicate([InstanceID](const FSlotState& State) { return State.InstanceID == InstanceID; });
+    }
+
+    if (Previous == INDEX_NONE || (MatchedPreviousMask & (1ull << Previous)) != 0)
+    {
+        ChangedMask |= 1ull << Slot;
+        return EHandSlotChange::Inserted;
+    }
+
+    MatchedPreviousMask |= 1ull << Previous;
+    HandDisplay[Slot] = MoveTemp(PreviousDisplay[Previous]);
+
+    if (PreviousSlots[Previous].Inputs != Inputs)
+    {
+        ChangedMask |= 1ull << Slot;
+        return EHandSlotChange::Changed;
+    }
+
+    if (Previous != Slot)
+    {
+        ShiftedMask |= 1ull << Slot;
+        return EHandSlotChange::Shifted;
+    }
+
+    return EHandSlotChange::None;
+}
+
+void FHandViewModel::EndUpdate()
+{
+    const uint64 PreviousMask = PreviousSlots.Num() >= MaxSlots ? ~0ull : (1ull << PreviousSlots.Num()) - 1;
+    RemovedMask = PreviousMask & ~MatchedPreviousMask;
+}
+
+void FHandViewModel::Invalidate()
+{
+    Slots.Reset();
+    PreviousSlots.Reset();
+    HandDisplay.Reset();
+    PreviousDisplay.Reset();
+    LastHandSize = INDEX_NONE;
+    LastDeckSize = INDEX_NONE;
+}
@@ -56,4 +56,99 @@ struct KEVESCARDKIT_API FCardDisplayData
 
     UPROPERTY(BlueprintReadOnly, Category = "Card Display")
     FString FormattedHealthText = TEXT("0");
-};
\ No newline at end of file
+};
+
+// Immutable, shared display data as handed out by FCardDisplayDataCache
+typedef TSharedRef<const FCardDisplayData, ESPMode::ThreadSafe> FCardDisplayDataRef;
+typedef TSharedPtr<const FCardDisplayData, ESPMode::ThreadSafe> FCardDisplayDataPtr;
+
+// ==== HAND VIEW MODEL ====
+
+// Everything a hand slot's display data is built from. Equal inputs mean the cached display data is still valid.
+struct KEVESCARDKIT_API FHandSlotInputs
+{
+    int32 CardID = INDEX_NONE;
+    int32 Cost = 0;
+    int32 Attack = 0;
+    int32 Health = 0;
+    bool bIsPlayable = false;
+
+    bool operator==(const FHandSlotInputs& Other) const
+    {
+        return CardID == Other.CardID && Cost == Other.Cost && Attack == Other.Attack
+            && Health == Other.Health && bIsPlayable == Other.bIsPlayable;
+    }
+
+    bool operator!=(const FHandSlotInputs& Other) const { return !(*this == Other); }
+};
+
+// How a hand slot differs from the previous pass
+enum class EHandSlotChange : uint8
+{
+    None,       // Same card, same inputs, same slot
+    Shifted,    // Same card and inputs, moved here from another slot; its display entry moved with it
+    Changed,    // Same card, different inputs (cost, stats, playability)
+    Inserted,   // Card was not in the hand last pass
+};
+
+// Per-card references to shared hand display data, diffed by hand instance ID (AHandManager::GetHandInstanceID).
+// Playing the card in slot i reports one removal and shifts for the later slots; only changed and
+// inserted slots need their display data rebuilt.
+struct KEVESCARDKIT_API FHandViewModel
+{
+    // Slot masks are 64-bit; hands are capped far below this
+    static constexpr int32 MaxSlots = 64;
+
+    // Start a pass over the hand; HandDisplay is resized to HandSize (at most MaxSlots)
+    void BeginUpdate(int32 HandSize, int32 DeckSize);
+
+    // Record the card in a slot. Call for every slot in [0, HandSize). The caller rebuilds
+    // HandDisplay[Slot] for Changed and Inserted.
+    EHandSlotChange UpdateSlot(int32 Slot, int32 InstanceID, const FHandSlotInputs& Inputs);
+
+    // Finish the pass: previous-pass slots whose card was not seen again become the removed mask
+    void EndUpdate();
+
+    // True if any slot, the hand size or the deck size changed during this pass
+    bool HasChanges() const { return (ChangedMask | ShiftedMask | RemovedMask) != 0 || bCountsChanged; }
+
+    // Slots whose display data was rebuilt (Changed or Inserted)
+    uint64 GetChangedMask() const { return ChangedMask; }
+
+    // Slots now holding an unchanged card that moved from another slot
+    uint64 GetShiftedMask() const { return ShiftedMask; }
+
+    // Slots of the previous pass whose card left the hand
+    uint64 GetRemovedMask() const { return RemovedMask; }
+
+    // Hand size of the previous pass; INDEX_NONE after Invalidate
+    int32 GetPreviousHandSize() const { return PreviousHandSize; }
+
+    // Forget all cached slots so the next pass reports every card as inserted
+    void Invalidate();
+
+    // Shared display entries for occupied slots [0, HandSize). Entries are not slot-specific
+    // (their HandIndex is -1); the array index is the slot.
+    TArray<FCardDisplayDataPtr> HandDisplay;
+
+private:
+    struct FSlotState
+    {
+        int32 InstanceID = INDEX_NONE;
+        FHandSlotInputs Inputs;
+    };
+
+    // This pass and the previous one; swapped in BeginUpdate so neither reallocates
+    TArray<FSlotState> Slots;
+    TArray<FSlotState> PreviousSlots;
+    TArray<FCardDisplayDataPtr> PreviousDisplay;
+
+    uint64 ChangedMask = 0;
+    uint64 ShiftedMask = 0;
+    uint64 RemovedMask = 0;
+    uint64 MatchedPreviousMask = 0;
+    int32 PreviousHandSize = INDEX_NONE;
+    int32 LastHandSize = INDEX_NONE;
+    int32 LastDeckSize = INDEX_NONE;
+    bool bCountsChanged = false;
+};
@@ -0,0 +1,402 @@
+// CardKitBenchmarkCommandlet.cpp - Benchmark cases and baseline comparison
+#include "CardKitBenchmarkCommandlet.h"
+#include "KevesCardKitLog.h"
+#include "HandManager.h"
+#include "CombatManager.h"
+#include "EnemyAIComponent.h"
+#include "Engine/DataTable.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "Interfaces/IPluginManager.h"
+#include "JsonObjectConverter.h"
+#include "Misc/App.h"
+#include "Misc/CommandLine.h"
+#include "Misc/DateTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "UObject/Package.h"
+
+namespace CardKitBenchmark
+{
+    static constexpr int32 CatalogSize = 2048;
+    static constexpr int32 AbilityIDBase = 100000;
+    static constexpr int32 NumSamples = 7;
+
+    struct FContext
+    {
+        UWorld* World = nullptr;
+        UDataTable* CardTable = nullptr;
+        UDataTable* AbilityTable = nullptr;
+        AHandManager* HandManager = nullptr;
+        ACombatManager* CombatManager = nullptr;
+        UEnemyAIComponent* EnemyAI = nullptr;
+
+        FCardData Creature;
+        TArray<int32> DeckIDs;                  // Spread across the whole catalog
+        TArray<int32> AbilityCardIDs;           // Indexed by (int32)ECardAbilityType
+    };
+
+    // Median microseconds per Body call over NumSamples samples (plus one discarded warmup).
+    // Setup runs before every sample, outside the timed region.
+    static FCardKitBenchmarkResult Measure(const FString& Name, int32 Iterations, TFunctionRef<void()> Setup, TFunctionRef<void()> Body)
+    {
+        TArray<double> Samples;
+        for (int32 Sample = 0; Sample <= NumSamples; Sample++)
+        {
+            Setup();
+
+            const double Start = FPlatformTime::Seconds();
+            for (int32 i = 0; i < Iterations; i++)
+            {
+                Body();
+            }
+            const double Elapsed = FPlatformTime::Seconds() - Start;
+
+            if (Sample > 0)
+            {
+                Samples.Add(Elapsed * 1000000.0 / Iterations);
+            }
+        }
+
+        Samples.Sort();
+
+        FCardKitBenchmarkResult Result;
+        Result.Name = Name;
+        Result.MicrosecondsPerOp = Samples[Samples.Num() / 2];
+        Result.Iterations = Iterations;
+        return Result;
+    }
+
+    static void BuildTables(FContext& Context)
+    {
+        Context.CardTable = NewObject<UDataTable>(GetTransientPackage());
+        Context.CardTable->RowStruct = FCardData::StaticStruct();
+        Context.CardTable->AddToRoot();
+
+        Context.AbilityTable = NewObject<UDataTable>(GetTransientPackage());
+        Context.AbilityTable->RowStruct = FCardAbility::StaticStruct();
+        Context.AbilityTable->AddToRoot();
+
+        // Plain catalog: three creatures to every spell, costs 0-3
+        for (int32 ID = 1; ID <= CatalogSize; ID++)
+        {
+            FCardData Card;
+            Card.ID = ID;
+            Card.Name = FText::FromString(FString::Printf(TEXT("Bench Card %d"), ID));
+            Card.CardType = (ID % 4 == 0) ? ECardType::Spell : ECardType::Creature;
+            Card.Cost = ID % 4;
+            Card.Attack = (Card.CardType == ECardType::Creature) ? 1 + ID % 5 : 0;
+            Card.Health = 1 + ID % 6;
+            Context.CardTable->AddRow(FName(*FString::Printf(TEXT("Card_%d"), ID)), Card);
+
+            if (Context.Creature.ID == 0 && Card.CardType == ECardType::Creature)
+            {
+                Context.Creature = Card;
+            }
+        }
+
+        // One zero-cost skill per ability type, each pointing at a matching ability row
+        const UEnum* AbilityEnum = StaticEnum<ECardAbilityType>();
+        for (int32 EnumIndex = 0; EnumIndex < AbilityEnum->NumEnums() - 1; EnumIndex++)
+        {
+            const int32 TypeValue = (int32)AbilityEnum->GetValueByIndex(EnumIndex);
+
+            FCardAbility Ability;
+            Ability.ID = AbilityIDBase + TypeValue;
+            Ability.Name = FText::FromString(AbilityEnum->GetNameStringByIndex(EnumIndex));
+            Ability.AbilityType = (ECardAbilityType)TypeValue;
+            Ability.CardIDsToAffect = { 1, 2 };
+            Ability.Count = 1;
+            Ability.Amount = 1;
+            Context.AbilityTable->AddRow(FName(*FString::Printf(TEXT("Ability_%d"), Ability.ID)), Ability);
+
+            FCardData Card;
+            Card.ID = CatalogSize + 1 + TypeValue;
+            Card.Name = Ability.Name;
+            Card.CardType = ECardType::Skill;
+            Card.AbilityID = Ability.ID;
+            Context.CardTable->AddRow(FName(*FString::Printf(TEXT("Card_%d"), Card.ID)), Card);
+
+            if (Context.AbilityCardIDs.Num() <= TypeValue)
+            {
+                Context.AbilityCardIDs.SetNumZeroed(TypeValue + 1);
+            }
+            Context.AbilityCardIDs[TypeValue] = Card.ID;
+        }
+
+        for (int32 i = 0; i < 200; i++)
+        {
+            Context.DeckIDs.Add(1 + (i * 37) % CatalogSize);
+        }
+    }
+
+    static void CreateWorld(FContext& Context)
+    {
+        Context.World = UWorld::CreateWorld(EWorldType::Game, false, TEXT("CardKitBenchmarkWorld"));
+        FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+        WorldContext.SetCurrentWorld(Context.World);
+        Context.World->InitializeActorsForPlay(FURL());
+        Context.World->BeginPlay();
+
+        Context.HandManager = Context.World->SpawnActor<AHandManager>();
+        Context.HandManager->CardDataTable = Context.CardTable;
+        Context.HandManager->AbilityDataTable = Context.AbilityTable;
+
+        Context.CombatManager = Context.World->SpawnActor<ACombatManager>();
+        Context.CombatManager->HandManager = Context.HandManager;
+        Context.HandManager->SetCombatManager(Context.CombatManager);
+
+        AActor* EnemyActor = Context.World->SpawnActor<AActor>();
+        Context.EnemyAI = NewObject<UEnemyAIComponent>(EnemyActor);
+        Context.EnemyAI->RegisterComponent();
+        Context.EnemyAI->SetCardDataTable(Context.CardTable);
+        Context.EnemyAI->SetCombatManager(Context.CombatManager);
+        Context.CombatManager->EnemyAIComponent = Context.EnemyAI;
+    }
+
+    static void DestroyWorld(FContext& Context)
+    {
+        GEngine->DestroyWorldContext(Context.World);
+        Context.World->DestroyWorld(false);
+
+        Context.CardTable->RemoveFromRoot();
+        Context.AbilityTable->RemoveFromRoot();
+    }
+
+    static void ClearBattlefield(ACombatManager* CombatManager, bool bIsPlayerSide)
+    {
+        for (int32 Index = CombatManager->GetBattlefieldCardCount(bIsPlayerSide) - 1; Index >= 0; Index--)
+        {
+            CombatManager->RemoveCardFromBattlefield(Index, bIsPlayerSide);
+        }
+    }
+
+    static void RunCasesInContext(FContext& Context, const FString& Filter, TArray<FCardKitBenchmarkResult>& OutResults)
+    {
+        AHandManager* Hand = Context.HandManager;
+        ACombatManager* Combat = Context.CombatManager;
+        UEnemyAIComponent* EnemyAI = Context.EnemyAI;
+
+        const TArray<int32> SmallDeck(Context.DeckIDs.GetData(), 60);
+        auto NoSetup = []() {};
+
+        auto Run = [&](const FString& Name, int32 Iterations, TFunctionRef<void()> Setup, TFunctionRef<void()> Body)
+        {
+            if (Filter.IsEmpty() || Name.Contains(Filter))
+            {
+                OutResults.Add(Measure(Name, Iterations, Setup, Body));
+            }
+        };
+
+        // Deck building against the full catalog
+        Run(FString::Printf(TEXT("HandManager.SetPlayerDeck.Catalog%d"), CatalogSize), 5, NoSetup,
+            [&]() { Hand->SetPlayerDeck(Context.DeckIDs); });
+
+        // Turn-start churn: shuffle, draw a hand, discard it
+        Run(TEXT("HandManager.DrawShuffle"), 10,
+            [&]() { Hand->ClearHand(); Hand->SetPlayerDeck(SmallDeck); },
+            [&]() { Hand->ShuffleDeck(); Hand->DrawCards(5); Hand->ClearHand(); });
+
+        // One case per ability type; includes adding the card to the hand
+        const UEnum* AbilityEnum = StaticEnum<ECardAbilityType>();
+        for (int32 TypeValue = 0; TypeValue < Context.AbilityCardIDs.Num(); TypeValue++)
+        {
+            const int32 CardID = Context.AbilityCardIDs[TypeValue];
+            Run(FString::Printf(TEXT("HandManager.PlayCard.%s"), *AbilityEnum->GetNameStringByValue(TypeValue)), 50,
+                [&]() { Hand->ClearHand(); Hand->SetPlayerDeck(SmallDeck); },
+                [&]() { Hand->ClearHand(); Hand->AddCardToHand(CardID); Hand->PlayCard(0, nullptr); });
+        }
+
+        // Battlefield churn with five resident creatures per side
+        Run(TEXT("CombatManager.SummonDamageRemove"), 200,
+            [&]()
+            {
+                ClearBattlefield(Combat, true);
+                ClearBattlefield(Combat, false);
+                for (int32 i = 0; i < 5; i++)
+                {
+                    Combat->SummonCreature(Context.Creature, true);
+                    Combat->SummonCreature(Context.Creature, false);
+                }
+            },
+            [&]()
+            {
+                Combat->SummonCreature(Context.Creature, true);
+                Combat->DamageSpecificBattlefieldCard(Combat->GetBattlefieldCardCount(true) - 1, true, Context.Creature.Health);
+            });
+
+        // Whole enemy turn: draw, select and play until done. Steps are spaced one tick apart, so the world is ticked.
+        const TArray<int32> EnemyDeck(Context.DeckIDs.GetData(), 30);
+        Run(TEXT("EnemyAI.FullTurn"), 5,
+            [&]() { EnemyAI->InitializeEnemyAI(EnemyDeck); },
+            [&]()
+            {
+                EnemyAI->StartEnemyTurn();
+                for (int32 Tick = 0; Tick < 64 && EnemyAI->IsEnemyTurnActive(); Tick++)
+                {
+                    Context.World->Tick(LEVELTICK_All, 1.0f / 60.0f);
+                }
+                ClearBattlefield(Combat, false);
+            });
+    }
+
+    FString GetDefaultBaselinePath()
+    {
+        FString Path;
+        if (FParse::Value(FCommandLine::Get(), TEXT("CardKitBenchmarkBaseline="), Path))
+        {
+            return Path;
+        }
+
+        const TSharedPtr<IPlugin> Plugin = IPluginManager::Get().FindPlugin(TEXT("KevesCardKit"));
+        return Plugin.IsValid() ? FPaths::Combine(Plugin->GetBaseDir(), TEXT("KevesCardKitBenchmarkBaselines.json")) : FString();
+    }
+
+    bool LoadBaselines(const FString& Path, FCardKitBenchmarkBaselines& OutBaselines)
+    {
+        FString Json;
+        return !Path.IsEmpty() && FFileHelper::LoadFileToString(Json, *Path)
+            && FJsonObjectConverter::JsonObjectStringToUStruct(Json, &OutBaselines);
+    }
+
+    void RunCases(const FString& Filter, TArray<FCardKitBenchmarkResult>& OutResults)
+    {
+        FContext Context;
+        BuildTables(Context);
+        CreateWorld(Context);
+
+        RunCasesInContext(Context, Filter, OutResults);
+
+        DestroyWorld(Context);
+    }
+
+    bool AreBaselinesRequired()
+    {
+        return FParse::Param(FCommandLine::Get(), TEXT("RequireBaselines"));
+    }
+
+    TArray<FString> CompareWithBaselines(const TArray<FCardKitBenchmarkResult>& Results,
+        const FCardKitBenchmarkBaselines& Baselines, bool bRequireBaselines, TArray<FString>* OutMissing)
+    {
+        TArray<FString> Failures;
+        for (const FCardKitBenchmarkResult& Result : Results)
+        {
+            const FCardKitBenchmarkResult* Baseline = Baselines.Cases.FindByPredicate(
+                [&Result](const FCardKitBenchmarkResult& Case) { return Case.Name == Result.Name; });
+
+            // Nothing to compare against: skipped, unless this run requires every case to have a baseline
+            if (!Baseline || Baseline->MicrosecondsPerOp <= 0.0)
+            {
+                const FString Message = FString::Printf(TEXT("%s has no baseline (%.2f us/op); record one with -WriteBaseline="),
+                    *Result.Name, Result.MicrosecondsPerOp);
+                if (bRequireBaselines)
+                {
+                    UE_LOG(LogKevesCardKit, Error, TEXT("[Benchmark] %s"), *Message);
+                    Failures.Add(Message);
+                }
+                else
+                {
+                    UE_LOG(LogKevesCardKit, Display, TEXT("[Benchmark] %s"), *Message);
+                    if (OutMissing)
+                    {
+                        OutMissing->Add(Message);
+                    }
+                }
+                continue;
+            }
+
+            const double Ratio = Result.MicrosecondsPerOp / Baseline->MicrosecondsPerOp;
+            if (Ratio > 1.0 + Baselines.Tolerance)
+            {
+                UE_LOG(LogKevesCardKit, Error, TEXT("[Benchmark] %-48s %10.2f us/op REGRESSED (baseline %.2f, %+.1f%%)"),
+                    *Result.Name, Result.MicrosecondsPerOp, Baseline->MicrosecondsPerOp, (Ratio - 1.0) * 100.0);
+                Failures.Add(FString::Printf(TEXT("%s regressed: %.2f us/op against a baseline of %.2f (%+.1f%%, tolerance %.0f%%)"),
+                    *Result.Name, Result.MicrosecondsPerOp, Baseline->MicrosecondsPerOp, (Ratio - 1.0) * 100.0, Baselines.Tolerance * 100.0f));
+            }
+            else
+            {
+                UE_LOG(LogKevesCardKit, Display, TEXT("[Benchmark] %-48s %10.2f us/op (baseline %.2f, %+.1f%%)"),
+                    *Result.Name, Result.MicrosecondsPerOp, Baseline->MicrosecondsPerOp, (Ratio - 1.0) * 100.0);
+            }
+        }
+        return Failures;
+    }
+}
+
+UCardKitBenchmarkCommandlet::UCardKitBenchmarkCommandlet()
+{
+    IsClient = false;
+    IsEditor = true;
+    IsServer = false;
+    LogToConsole = true;
+}
+
+int32 UCardKitBenchmarkCommandlet::Main(const FString& Params)
+{
+    using namespace CardKitBenchmark;
+
+    FString BaselinePath = GetDefaultBaselinePath();
+    FString WriteBaselinePath;
+    FString Filter;
+    FParse::Value(*Params, TEXT("Baseline="), BaselinePath);
+    FParse::Value(*Params, TEXT("WriteBaseline="), WriteBaselinePath);
+    FParse::Value(*Params, TEXT("Filter="), Filter);
+
+    // Recording new baselines is never gated on the old ones
+    const bool bRequireBaselines = WriteBaselinePath.IsEmpty() && FParse::Param(*Params, TEXT("RequireBaselines"));
+
+    FCardKitBenchmarkBaselines Baselines;
+    if (!LoadBaselines(BaselinePath, Baselines))
+    {
+        if (bRequireBaselines)
+        {
+            UE_LOG(LogKevesCardKit, Error, TEXT("[Benchmark] Could not read baselines from '%s'"), *BaselinePath);
+            return 1;
+        }
+        UE_LOG(LogKevesCardKit, Warning, TEXT("[Benchmark] Could not read baselines from '%s'; nothing will be compared"), *BaselinePath);
+    }
+    FParse::Value(*Params, TEXT("Tolerance="), Baselines.Tolerance);
+
+    TArray<FCardKitBenchmarkResult> Results;
+    RunCases(Filter, Results);
+
+    TArray<FString> Missing;
+    const int32 NumFailures = CompareWithBaselines(Results, Baselines, bRequireBaselines, &Missing).Num();
+    if (Missing.Num() > 0)
+    {
+        UE_LOG(LogKevesCardKit, Warning, TEXT("[Benchmark] %d of %d cases have no baseline and were not checked; pass -RequireBaselines to fail on them"),
+            Missing.Num(), Results.Num());
+    }
+
+    // Keep every run for trend tracking, and optionally refresh the baselines file
+    FCardKitBenchmarkBaselines Run;
+    Run.Tolerance = Baselines.Tolerance;
+    Run.RecordedOn = FString::Printf(TEXT("%s %s %s"), ANSI_TO_TCHAR(FPlatformProperties::PlatformName()),
+        *FPlatformMisc::GetCPUBrand().TrimStartAndEnd(), LexToString(FApp::GetBuildConfiguration()));
+    Run.Cases = Results;
+
+    FString RunJson;
+    FJsonObjectConverter::UStructToJsonObjectString(Run, RunJson);
+
+    const FString ResultsPath = FPaths::Combine(FPaths::ProfilingDir(), TEXT("KevesCardKit"),
+        FString::Printf(TEXT("BenchmarkResults_%s.json"), *FDateTime::Now().ToString()));
+    FFileHelper::SaveStringToFile(RunJson, *ResultsPath);
+
+    if (!WriteBaselinePath.IsEmpty())
+    {
+        if (FFileHelper::SaveStringToFile(RunJson, *WriteBaselinePath))
+        {
+            UE_LOG(LogKevesCardKit, Display, TEXT("[Benchmark] Wrote baselines to %s"), *WriteBaselinePath);
+        }
+        else
+        {
+            UE_LOG(LogKevesCardKit, Error, TEXT("[Benchmark] Failed to write baselines to %s"), *WriteBaselinePath);
+            return 1;
+        }
+    }
+
+    UE_LOG(LogKevesCardKit, Display, TEXT("[Benchmark] %d cases, %d failed (tolerance %.0f%%), results in %s"),
+        Results.Num(), NumFailures, Baselines.Tolerance * 100.0f, *ResultsPath);
+
+    return NumFailures == 0 ? 0 : 1;
+}
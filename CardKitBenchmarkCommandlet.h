@@ -0,0 +1,78 @@
+// CardKitBenchmarkCommandlet.h - Headless micro-benchmarks for the card kit with baseline regression checks
+// Usage: UnrealEditor-Cmd <Project> -run=CardKitBenchmark -nullrhi -unattended
+//            [-Baseline=<path>/KevesCardKitBenchmarkBaselines.json] [-Tolerance=0.25] [-Filter=PlayCard]
+//            [-WriteBaseline=<path>] [-RequireBaselines]
+// Returns 1 if any case is slower than its baseline by more than the tolerance. Cases without a baseline
+// are reported and skipped, unless -RequireBaselines (CI on the reference machine) makes them fail too.
+// Baselines default to the checked-in KevesCardKitBenchmarkBaselines.json. The same cases run as the
+// KevesCardKit.Benchmark automation tests (see CardKitBenchmarkTests.cpp), which honour -RequireBaselines
+// on the editor command line.
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "CardKitBenchmarkCommandlet.generated.h"
+
+USTRUCT()
+struct FCardKitBenchmarkResult
+{
+    GENERATED_BODY()
+
+    UPROPERTY()
+    FString Name;
+
+    // Median over samples
+    UPROPERTY()
+    double MicrosecondsPerOp = 0.0;
+
+    UPROPERTY()
+    int32 Iterations = 0;
+};
+
+// Layout of the checked-in baselines file
+USTRUCT()
+struct FCardKitBenchmarkBaselines
+{
+    GENERATED_BODY()
+
+    // Allowed slowdown before a case counts as a regression (0.25 = 25%)
+    UPROPERTY()
+    float Tolerance = 0.25f;
+
+    // Machine/build the numbers were recorded on
+    UPROPERTY()
+    FString RecordedOn;
+
+    UPROPERTY()
+    TArray<FCardKitBenchmarkResult> Cases;
+};
+
+namespace CardKitBenchmark
+{
+    // Checked-in baselines in the plugin directory; -CardKitBenchmarkBaseline=<path> on the command line overrides it
+    KEVESCARDKIT_API FString GetDefaultBaselinePath();
+
+    KEVESCARDKIT_API bool LoadBaselines(const FString& Path, FCardKitBenchmarkBaselines& OutBaselines);
+
+    // Run every case whose name contains Filter (all of them when empty) in a private world
+    KEVESCARDKIT_API void RunCases(const FString& Filter, TArray<FCardKitBenchmarkResult>& OutResults);
+
+    // Whether a missing baseline fails the run (-RequireBaselines on the command line)
+    KEVESCARDKIT_API bool AreBaselinesRequired();
+
+    // Log each result against its baseline. Returns a message per regression, and per case without a
+    // baseline if bRequireBaselines; otherwise those are skipped and listed in OutMissing.
+    KEVESCARDKIT_API TArray<FString> CompareWithBaselines(const TArray<FCardKitBenchmarkResult>& Results,
+        const FCardKitBenchmarkBaselines& Baselines, bool bRequireBaselines, TArray<FString>* OutMissing = nullptr);
+}
+
+UCLASS()
+class KEVESCARDKIT_API UCardKitBenchmarkCommandlet : public UCommandlet
+{
+    GENERATED_BODY()
+
+public:
+    UCardKitBenchmarkCommandlet();
+
+    virtual int32 Main(const FString& Params) override;
+};
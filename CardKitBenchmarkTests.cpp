@@ -0,0 +1,91 @@
+// CardKitBenchmarkTests.cpp - Benchmark cases as automation tests, gated by the checked-in baselines
+// Usage: UnrealEditor-Cmd <Project> -nullrhi -unattended [-RequireBaselines] -ExecCmds="Automation RunTests KevesCardKit.Benchmark; Quit"
+#include "CardKitBenchmarkCommandlet.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace CardKitBenchmarkTests
+{
+    // Run the cases matching Filter and fail on any regression. Cases without a baseline are skipped with
+    // a warning, or fail under -RequireBaselines, like the commandlet.
+    static bool RunAndCompare(FAutomationTestBase& Test, const FString& Filter)
+    {
+        const bool bRequireBaselines = CardKitBenchmark::AreBaselinesRequired();
+        const FString BaselinePath = CardKitBenchmark::GetDefaultBaselinePath();
+        FCardKitBenchmarkBaselines Baselines;
+        if (!CardKitBenchmark::LoadBaselines(BaselinePath, Baselines))
+        {
+            const FString Message = FString::Printf(TEXT("Could not read benchmark baselines from '%s'"), *BaselinePath);
+            if (bRequireBaselines)
+            {
+                Test.AddError(Message);
+                return false;
+            }
+            Test.AddWarning(Message);
+        }
+
+        TArray<FCardKitBenchmarkResult> Results;
+        CardKitBenchmark::RunCases(Filter, Results);
+        if (Results.Num() == 0)
+        {
+            Test.AddError(FString::Printf(TEXT("No benchmark case matches '%s'"), *Filter));
+            return false;
+        }
+
+        for (const FCardKitBenchmarkResult& Result : Results)
+        {
+            Test.AddInfo(FString::Printf(TEXT("%s: %.2f us/op"), *Result.Name, Result.MicrosecondsPerOp));
+        }
+
+        TArray<FString> Missing;
+        const TArray<FString> Failures = CardKitBenchmark::CompareWithBaselines(Results, Baselines, bRequireBaselines, &Missing);
+        for (const FString& Message : Missing)
+        {
+            Test.AddWarning(Message);
+        }
+        for (const FString& Failure : Failures)
+        {
+            Test.AddError(Failure);
+        }
+        return Failures.Num() == 0;
+    }
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCardKitBenchmarkSetPlayerDeckTest, "KevesCardKit.Benchmark.SetPlayerDeck",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+bool FCardKitBenchmarkSetPlayerDeckTest::RunTest(const FString& Parameters)
+{
+    return CardKitBenchmarkTests::RunAndCompare(*this, TEXT("HandManager.SetPlayerDeck"));
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCardKitBenchmarkDrawShuffleTest, "KevesCardKit.Benchmark.DrawShuffle",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+bool FCardKitBenchmarkDrawShuffleTest::RunTest(const FString& Parameters)
+{
+    return CardKitBenchmarkTests::RunAndCompare(*this, TEXT("HandManager.DrawShuffle"));
+}
+
+// One result per ability type
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCardKitBenchmarkPlayCardTest, "KevesCardKit.Benchmark.PlayCard",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+bool FCardKitBenchmarkPlayCardTest::RunTest(const FString& Parameters)
+{
+    return CardKitBenchmarkTests::RunAndCompare(*this, TEXT("HandManager.PlayCard."));
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCardKitBenchmarkBattlefieldTest, "KevesCardKit.Benchmark.SummonDamageRemove",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+bool FCardKitBenchmarkBattlefieldTest::RunTest(const FString& Parameters)
+{
+    return CardKitBenchmarkTests::RunAndCompare(*this, TEXT("CombatManager.SummonDamageRemove"));
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCardKitBenchmarkEnemyTurnTest, "KevesCardKit.Benchmark.EnemyFullTurn",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+bool FCardKitBenchmarkEnemyTurnTest::RunTest(const FString& Parameters)
+{
+    return CardKitBenchmarkTests::RunAndCompare(*this, TEXT("EnemyAI.FullTurn"));
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,195 @@
+// CardModifierLayers.cpp - Incremental modifier bookkeeping
+#include "CardModifierLayers.h"
+
+// ==== INSTANCES ====
+
+const FCardInstanceStats& FCardModifierLayers::AddInstance(int32 InstanceID, const FCardData& Card, bool bPlayerSide, bool bInHand)
+{
+    RemoveInstance(InstanceID);
+
+    FCardInstanceStats& Stats = Instances.Add(InstanceID);
+    Stats.BaseAttack = Stats.Attack = Card.Attack;
+    Stats.BaseHealth = Stats.Health = Card.Health;
+    Stats.BaseCost = Stats.Cost = Card.Cost;
+    Stats.CardType = Card.CardType;
+    Stats.bPlayerSide = bPlayerSide;
+    Stats.bInHand = bInHand;
+
+    for (int32 AuraID : AuraIDs)
+    {
+        FModifierRecord& Record = Modifiers[AuraID];
+        if (AuraMatches(Record.Modifier, Stats))
+        {
+            ApplyDeltas(Record.Modifier, Stats, 1);
+            Stats.ModifierIDs.Add(AuraID);
+            Record.Affected.Add(InstanceID);
+        }
+    }
+
+    return Stats;
+}
+
+void FCardModifierLayers::RemoveInstance(int32 InstanceID)
+{
+    FCardInstanceStats Stats;
+    if (!Instances.RemoveAndCopyValue(InstanceID, Stats))
+    {
+        return;
+    }
+
+    for (int32 ModifierID : Stats.ModifierIDs)
+    {
+        FModifierRecord* Record = Modifiers.Find(ModifierID);
+        if (!Record)
+        {
+            continue;
+        }
+
+        if (Record->Modifier.IsAura())
+        {
+            Record->Affected.RemoveSingleSwap(InstanceID);
+        }
+        else
+        {
+            Modifiers.Remove(ModifierID);
+        }
+    }
+}
+
+// ==== MODIFIERS ====
+
+int32 FCardModifierLayers::AddModifier(const FCardModifier& Modifier, FChanges& OutChanges)
+{
+    if (!Modifier.IsAura() && !Instances.Contains(Modifier.InstanceID))
+    {
+        return 0;
+    }
+
+    const int32 ModifierID = NextModifierID++;
+    FModifierRecord& Record = Modifiers.Add(ModifierID);
+    Record.Modifier = Modifier;
+
+    auto Attach = [&](int32 InstanceID, FCardInstanceStats& Stats)
+    {
+        ApplyDeltas(Modifier, Stats, 1);
+        Stats.ModifierIDs.Add(ModifierID);
+        Record.Affected.Add(InstanceID);
+
+        FCardStatChange& Change = OutChanges.AddDefaulted_GetRef();
+        Change.InstanceID = InstanceID;
+        Change.HealthDelta = Modifier.Health;
+    };
+
+    if (Modifier.IsAura())
+    {
+        AuraIDs.Add(ModifierID);
+        for (TPair<int32, FCardInstanceStats>& Instance : Instances)
+        {
+            if (AuraMatches(Modifier, Instance.Value))
+            {
+                Attach(Instance.Key, Instance.Value);
+            }
+        }
+    }
+    else
+    {
+        FCardInstanceStats& Stats = Instances[Modifier.InstanceID];
+        Stats.OwnAttack += Modifier.Attack;
+        Stats.OwnHealth += Modifier.Health;
+        Attach(Modifier.InstanceID, Stats);
+    }
+
+    return ModifierID;
+}
+
+void FCardModifierLayers::RemoveModifier(int32 ModifierID, FChanges& OutChanges)
+{
+    FModifierRecord Record;
+    if (!Modifiers.RemoveAndCopyValue(ModifierID, Record))
+    {
+        return;
+    }
+
+    if (Record.Modifier.IsAura())
+    {
+        AuraIDs.Remove(ModifierID);
+    }
+
+    for (int32 InstanceID : Record.Affected)
+    {
+        FCardInstanceStats* Stats = Instances.Find(InstanceID);
+        if (!Stats)
+        {
+            continue;
+        }
+
+        ApplyDeltas(Record.Modifier, *Stats, -1);
+        Stats->ModifierIDs.RemoveSingleSwap(ModifierID);
+        if (!Record.Modifier.IsAura())
+        {
+            Stats->OwnAttack -= Record.Modifier.Attack;
+            Stats->OwnHealth -= Record.Modifier.Health;
+        }
+
+        FCardStatChange& Change = OutChanges.AddDefaulted_GetRef();
+        Change.InstanceID = InstanceID;
+        Change.HealthDelta = -Record.Modifier.Health;
+    }
+}
+
+void FCardModifierLayers::RemoveModifiersFromSource(int32 SourceID, FChanges& OutChanges)
+{
+    if (SourceID == -1)
+    {
+        return;
+    }
+
+    TArray<int32, TInlineAllocator<8>> SourceModifiers;
+    for (const TPair<int32, FModifierRecord>& Entry : Modifiers)
+    {
+        if (Entry.Value.Modifier.SourceID == SourceID)
+        {
+            SourceModifiers.Add(Entry.Key);
+        }
+    }
+
+    for (int32 ModifierID : SourceModifiers)
+    {
+        RemoveModifier(ModifierID, OutChanges);
+    }
+}
+
+void FCardModifierLayers::Reset()
+{
+    Instances.Reset();
+    Modifiers.Reset();
+    AuraIDs.Reset();
+}
+
+int64 FCardModifierLayers::GetAllocatedSize() const
+{
+    int64 Bytes = Instances.GetAllocatedSize() + Modifiers.GetAllocatedSize() + AuraIDs.GetAllocatedSize();
+    for (const TPair<int32, FModifierRecord>& Entry : Modifiers)
+    {
+        Bytes += Entry.Value.Affected.GetAllocatedSize();
+    }
+    return Bytes;
+}
+
+// ==== HELPERS ====
+
+bool FCardModifierLayers::AuraMatches(const FCardModifier& Aura, const FCardInstanceStats& Stats)
+{
+    const bool bZone = Stats.bInHand
+        ? (Aura.bPlayerHand && Stats.bPlayerSide)
+        : (Stats.bPlayerSide ? Aura.bPlayerField : Aura.bEnemyField);
+
+    return bZone && (Aura.CardTypes == 0 || (Aura.CardTypes & (1 << (int32)Stats.CardType)) != 0);
+}
+
+void FCardModifierLayers::ApplyDeltas(const FCardModifier& Modifier, FCardInstanceStats& Stats, int32 Sign)
+{
+    Stats.Attack += Sign * Modifier.Attack;
+    Stats.Health += Sign * Modifier.Health;
+    Stats.Cost += Sign * Modifier.Cost;
+}
@@ -0,0 +1,108 @@
+// CardModifierLayers.h - Stat modifiers layered over card instances, with cached effective stats
+#pragma once
+
+#include "CoreMinimal.h"
+#include "CardTypesHost.h"
+
+// A stat change from a buff, power or aura
+struct FCardModifier
+{
+    int32 Attack = 0;
+    int32 Health = 0;
+    int32 Cost = 0;
+
+    // Permanent that owns the modifier (see RemoveModifiersFromSource); -1 lasts until removed or the combat ends
+    int32 SourceID = -1;
+
+    // Instance the modifier is attached to; -1 makes it an aura over every matching instance, current and future
+    int32 InstanceID = -1;
+
+    // Aura scope (absolute sides) and card type mask (0 = any)
+    bool bPlayerField = false;
+    bool bEnemyField = false;
+    bool bPlayerHand = false;
+    int32 CardTypes = 0;
+
+    bool IsAura() const { return InstanceID == -1; }
+};
+
+// Cached stats of one card instance (battlefield UniqueID or hand instance ID)
+struct FCardInstanceStats
+{
+    int32 BaseAttack = 0;
+    int32 BaseHealth = 0;
+    int32 BaseCost = 0;
+
+    // Base plus every applied modifier, updated incrementally
+    int32 Attack = 0;
+    int32 Health = 0;
+    int32 Cost = 0;
+
+    // Share of the above from modifiers on this instance alone; it stays with the card when it moves from hand to field
+    int32 OwnAttack = 0;
+    int32 OwnHealth = 0;
+
+    ECardType CardType = ECardType::Creature;
+    bool bPlayerSide = true;
+    bool bInHand = false;
+
+    TArray<int32, TInlineAllocator<4>> ModifierIDs;
+};
+
+// Health delta for an instance whose cached stats changed; attack and cost are read from the cache
+struct FCardStatChange
+{
+    int32 InstanceID = -1;
+    int32 HealthDelta = 0;
+};
+
+/**
+ * Base stats plus stacked modifiers. Adding or removing a modifier only touches the instances it applies to,
+ * and reads are a map lookup, so a board-wide aura costs one update per affected card rather than a
+ * recompute on every read. Owned by ACombatManager, which pushes changes into the battlefield and hand.
+ */
+class KEVESCARDKIT_API FCardModifierLayers
+{
+public:
+    typedef TArray<FCardStatChange, TInlineAllocator<16>> FChanges;
+
+    // A card entering the hand or battlefield; matching auras apply immediately
+    const FCardInstanceStats& AddInstance(int32 InstanceID, const FCardData& Card, bool bPlayerSide, bool bInHand);
+
+    // Card left its zone; modifiers attached to it go with it
+    void RemoveInstance(int32 InstanceID);
+
+    // Returns the modifier's handle, or 0 if it applies to nothing (unknown instance)
+    int32 AddModifier(const FCardModifier& Modifier, FChanges& OutChanges);
+
+    void RemoveModifier(int32 ModifierID, FChanges& OutChanges);
+
+    // Drop every modifier owned by a permanent that left play
+    void RemoveModifiersFromSource(int32 SourceID, FChanges& OutChanges);
+
+    const FCardInstanceStats* Find(int32 InstanceID) const { return Instances.Find(InstanceID); }
+
+    void Reset();
+
+    int64 GetAllocatedSize() const;
+
+private:
+    struct FModifierRecord
+    {
+        FCardModifier Modifier;
+        TArray<int32> Affected;
+    };
+
+    static bool AuraMatches(const FCardModifier& Aura, const FCardInstanceStats& Stats);
+
+    // Add (Sign = 1) or take away (Sign = -1) a modifier's deltas on one instance
+    static void ApplyDeltas(const FCardModifier& Modifier, FCardInstanceStats& Stats, int32 Sign);
+
+    TMap<int32, FCardInstanceStats> Instances;
+    TMap<int32, FModifierRecord> Modifiers;
+
+    // Aura handles in the order they were added
+    TArray<int32> AuraIDs;
+
+    int32 NextModifierID = 1;
+};
@@ -0,0 +1,172 @@
+// CardStatusEffects.cpp - Status effect storage and batched ticking
+#include "CardStatusEffects.h"
+
+// ==== COLUMNS ====
+
+FCardStatusEntry* FCardStatusEffects::FColumn::Find(int32 UniqueID)
+{
+    const int32* Index = IndexByID.Find(UniqueID);
+    return Index ? &Entries[*Index] : nullptr;
+}
+
+const FCardStatusEntry* FCardStatusEffects::FColumn::Find(int32 UniqueID) const
+{
+    const int32* Index = IndexByID.Find(UniqueID);
+    return Index ? &Entries[*Index] : nullptr;
+}
+
+void FCardStatusEffects::FColumn::RemoveAt(int32 Index)
+{
+    IndexByID.Remove(Entries[Index].UniqueID);
+    Entries.RemoveAtSwap(Index);
+    if (Entries.IsValidIndex(Index))
+    {
+        IndexByID.Add(Entries[Index].UniqueID, Index);
+    }
+}
+
+// ==== EFFECTS ====
+
+void FCardStatusEffects::Apply(ECardStatusEffect Effect, int32 UniqueID, bool bPlayerSide, int32 Amount, int32 Turns)
+{
+    if ((int32)Effect >= (int32)ECardStatusEffect::Count || Amount <= 0)
+    {
+        return;
+    }
+
+    FColumn& Column = GetColumn(Effect);
+    if (FCardStatusEntry* Existing = Column.Find(UniqueID))
+    {
+        Existing->Amount = (int16)FMath::Min<int32>(Existing->Amount + Amount, MAX_int16);
+        if (Existing->TurnsLeft != 0)
+        {
+            Existing->TurnsLeft = (Turns <= 0) ? 0 : (int16)FMath::Max<int32>(Existing->TurnsLeft, FMath::Min<int32>(Turns, MAX_int16));
+        }
+        return;
+    }
+
+    FCardStatusEntry Entry;
+    Entry.UniqueID = UniqueID;
+    Entry.Amount = (int16)FMath::Min<int32>(Amount, MAX_int16);
+    Entry.TurnsLeft = (int16)FMath::Clamp<int32>(Turns, 0, MAX_int16);
+    Entry.bPlayerSide = bPlayerSide;
+    Column.IndexByID.Add(UniqueID, Column.Entries.Add(Entry));
+}
+
+int32 FCardStatusEffects::GetAmount(ECardStatusEffect Effect, int32 UniqueID) const
+{
+    if ((int32)Effect >= (int32)ECardStatusEffect::Count)
+    {
+        return 0;
+    }
+
+    const FCardStatusEntry* Entry = Columns[(int32)Effect].Find(UniqueID);
+    return Entry ? Entry->Amount : 0;
+}
+
+int32 FCardStatusEffects::AbsorbDamage(int32 UniqueID, int32 Damage)
+{
+    FColumn& Armor = GetColumn(ECardStatusEffect::Armor);
+    const int32* Index = Armor.IndexByID.Find(UniqueID);
+    if (!Index || Damage <= 0)
+    {
+        return Damage;
+    }
+
+    FCardStatusEntry& Entry = Armor.Entries[*Index];
+    const int32 Absorbed = FMath::Min<int32>(Entry.Amount, Damage);
+    Entry.Amount -= (int16)Absorbed;
+    if (Entry.Amount <= 0)
+    {
+        Armor.RemoveAt(*Index);
+    }
+    return Damage - Absorbed;
+}
+
+void FCardStatusEffects::RemoveCreature(int32 UniqueID)
+{
+    for (FColumn& Column : Columns)
+    {
+        if (const int32* Index = Column.IndexByID.Find(UniqueID))
+        {
+            Column.RemoveAt(*Index);
+        }
+    }
+}
+
+void FCardStatusEffects::Reset()
+{
+    for (FColumn& Column : Columns)
+    {
+        Column.Entries.Reset();
+        Column.IndexByID.Reset();
+    }
+}
+
+void FCardStatusEffects::Tick(bool bPlayerSide, TArray<FCardStatusTick>& OutTicks)
+{
+    OutTicks.Reset();
+
+    // UniqueID -> OutTicks index, so a creature with several effects gets one combined result
+    TMap<int32, int32, TInlineSetAllocator<16>> TickByID;
+    auto TickFor = [&OutTicks, &TickByID](int32 UniqueID) -> FCardStatusTick&
+    {
+        if (const int32* Index = TickByID.Find(UniqueID))
+        {
+            return OutTicks[*Index];
+        }
+        const int32 Index = OutTicks.AddDefaulted();
+        OutTicks[Index].UniqueID = UniqueID;
+        TickByID.Add(UniqueID, Index);
+        return OutTicks[Index];
+    };
+
+    for (int32 Effect = 0; Effect < (int32)ECardStatusEffect::Count; Effect++)
+    {
+        FColumn& Column = Columns[Effect];
+
+        // Back to front: RemoveAt swaps in an entry that has already been visited
+        for (int32 Index = Column.Entries.Num() - 1; Index >= 0; Index--)
+        {
+            FCardStatusEntry& Entry = Column.Entries[Index];
+            if (Entry.bPlayerSide != bPlayerSide)
+            {
+                continue;
+            }
+
+            bool bExpired = false;
+            switch ((ECardStatusEffect)Effect)
+            {
+            case ECardStatusEffect::Poison:
+                TickFor(Entry.UniqueID).Damage += Entry.Amount;
+                bExpired = --Entry.Amount <= 0;
+                break;
+            case ECardStatusEffect::Regeneration:
+                TickFor(Entry.UniqueID).Healing += Entry.Amount;
+                break;
+            default:
+                break;
+            }
+
+            if (Entry.TurnsLeft > 0 && --Entry.TurnsLeft == 0)
+            {
+                bExpired = true;
+            }
+
+            if (bExpired)
+            {
+                Column.RemoveAt(Index);
+            }
+        }
+    }
+}
+
+int64 FCardStatusEffects::GetAllocatedSize() const
+{
+    int64 Bytes = 0;
+    for (const FColumn& Column : Columns)
+    {
+        Bytes += Column.Entries.GetAllocatedSize() + Column.IndexByID.GetAllocatedSize();
+    }
+    return Bytes;
+}
@@ -0,0 +1,68 @@
+// CardStatusEffects.h - Status effects on battlefield creatures, stored per effect type and ticked in batches
+#pragma once
+
+#include "CoreMinimal.h"
+#include "CardTypesHost.h"
+
+struct FCardStatusEntry
+{
+    int32 UniqueID = -1;
+    int16 Amount = 0;
+
+    // Owner turns until the effect expires (0 = until used up / decayed)
+    int16 TurnsLeft = 0;
+
+    bool bPlayerSide = true;
+};
+
+// What one creature takes from a turn's tick, with all of its effects merged
+struct FCardStatusTick
+{
+    int32 UniqueID = -1;
+    int32 Damage = 0;
+    int32 Healing = 0;
+};
+
+/**
+ * One compact array per effect type, keyed by battlefield UniqueID. Effects never call back into
+ * combat: Tick reports the combined damage and healing per creature and ACombatManager applies
+ * them in one pass, followed by a single death sweep.
+ * Owned by ACombatManager; game thread only.
+ */
+class KEVESCARDKIT_API FCardStatusEffects
+{
+public:
+    // Stack Amount onto the creature's effect. The longer of the two durations is kept.
+    void Apply(ECardStatusEffect Effect, int32 UniqueID, bool bPlayerSide, int32 Amount, int32 Turns);
+
+    int32 GetAmount(ECardStatusEffect Effect, int32 UniqueID) const;
+
+    // Armor soaks damage first; returns the damage that gets through
+    int32 AbsorbDamage(int32 UniqueID, int32 Damage);
+
+    // Creature left play
+    void RemoveCreature(int32 UniqueID);
+
+    void Reset();
+
+    // Start-of-turn pass over the effects of one side: poison deals its amount and decays by 1,
+    // regeneration heals, timed effects count down and expire. One entry per affected creature.
+    void Tick(bool bPlayerSide, TArray<FCardStatusTick>& OutTicks);
+
+    int64 GetAllocatedSize() const;
+
+private:
+    struct FColumn
+    {
+        TArray<FCardStatusEntry> Entries;
+        TMap<int32, int32> IndexByID;
+
+        FCardStatusEntry* Find(int32 UniqueID);
+        const FCardStatusEntry* Find(int32 UniqueID) const;
+        void RemoveAt(int32 Index);
+    };
+
+    FColumn& GetColumn(ECardStatusEffect Effect) { return Columns[(int32)Effect]; }
+
+    FColumn Columns[(int32)ECardStatusEffect::Count];
+};
@@ -0,0 +1,291 @@
+// CardTargetSelector.cpp - Selector evaluation as mask operations
+#include "CardTargetSelector.h"
+#include "CardAbilityInterpreter.h"
+#include "CombatManager.h"
+#include "HandManager.h"
+#include "BattlefieldCardActor.h"
+
+// ==== ZONE MASKS ====
+
+void FCardZoneMasks::AddSlot(int32 Slot, const FCardData& Card)
+{
+    if (Slot < 0 || Slot >= MaxSlots)
+    {
+        return;
+    }
+
+    const uint64 Bit = 1ull << Slot;
+    Occupied |= Bit;
+
+    const int32 Type = (int32)Card.CardType;
+    if (Type < NumTypes)
+    {
+        ByType[Type] |= Bit;
+    }
+
+    const int32 Faction = (int32)Card.CardFaction;
+    if (Faction < NumFactions)
+    {
+        ByFaction[Faction] |= Bit;
+    }
+}
+
+uint64 FCardZoneMasks::Filter(int32 TypeMask, int32 FactionMask) const
+{
+    uint64 Result = Occupied;
+
+    if (TypeMask != 0)
+    {
+        uint64 Allowed = 0;
+        for (int32 Type = 0; Type < NumTypes; Type++)
+        {
+            if (TypeMask & (1 << Type))
+            {
+                Allowed |= ByType[Type];
+            }
+        }
+        Result &= Allowed;
+    }
+
+    if (FactionMask != 0)
+    {
+        uint64 Allowed = 0;
+        for (int32 Faction = 0; Faction < NumFactions; Faction++)
+        {
+            if (FactionMask & (1 << Faction))
+            {
+                Allowed |= ByFaction[Faction];
+            }
+        }
+        Result &= Allowed;
+    }
+
+    return Result;
+}
+
+// ==== SELECTION ====
+
+namespace
+{
+    // Only visits candidate slots, and only when the selector has a health bound
+    template <typename GetHealthType>
+    uint64 FilterHealth(uint64 Mask, const FCardTargetSelector& Selector, GetHealthType&& GetHealth)
+    {
+        if (Selector.MinHealth <= 0 && Selector.MaxHealth <= 0)
+        {
+            return Mask;
+        }
+
+        uint64 Result = Mask;
+        KCKTargeting::ForEachSlotDescending(Mask, [&](int32 Slot)
+        {
+            const int32 Health = GetHealth(Slot);
+            if ((Selector.MinHealth > 0 && Health < Selector.MinHealth) || (Selector.MaxHealth > 0 && Health > Selector.MaxHealth))
+            {
+                Result &= ~(1ull << Slot);
+            }
+        });
+        return Result;
+    }
+
+    // Keep Count distinct candidates, each equally likely. Draws from the combat's stream when there is one.
+    FCardTargetSet PickRandom(FCardTargetSet Remaining, int32 Count, FRandomStream* Random)
+    {
+        FCardTargetSet Picked;
+
+        for (int32 Pick = 0; Pick < Count; Pick++)
+        {
+            const int32 NumRemaining = Remaining.Num();
+            if (NumRemaining == 0)
+            {
+                break;
+            }
+
+            int32 Nth = Random ? Random->RandRange(0, NumRemaining - 1) : FMath::RandRange(0, NumRemaining - 1);
+            bool bPicked = false;
+
+            uint64* RemainingMasks[] = { &Remaining.PlayerField, &Remaining.EnemyField, &Remaining.PlayerHand };
+            uint64* PickedMasks[] = { &Picked.PlayerField, &Picked.EnemyField, &Picked.PlayerHand };
+            for (int32 Zone = 0; Zone < UE_ARRAY_COUNT(RemainingMasks) && !bPicked; Zone++)
+            {
+                const int32 NumBits = FMath::CountBits(*RemainingMasks[Zone]);
+                if (Nth >= NumBits)
+                {
+                    Nth -= NumBits;
+                    continue;
+                }
+
+                // Drop the lowest bits until the Nth one is lowest
+                uint64 Mask = *RemainingMasks[Zone];
+                for (int32 Skip = 0; Skip < Nth; Skip++)
+                {
+                    Mask &= Mask - 1;
+                }
+                const uint64 Bit = Mask & (~Mask + 1);
+                *RemainingMasks[Zone] &= ~Bit;
+                *PickedMasks[Zone] |= Bit;
+                bPicked = true;
+            }
+
+            if (!bPicked && Remaining.bPlayerHero)
+            {
+                if (Nth == 0)
+                {
+                    Remaining.bPlayerHero = false;
+                    Picked.bPlayerHero = true;
+                    bPicked = true;
+                }
+                else
+                {
+                    Nth--;
+                }
+            }
+
+            if (!bPicked && Remaining.bEnemyHero)
+            {
+                Remaining.bEnemyHero = false;
+                Picked.bEnemyHero = true;
+            }
+        }
+
+        return Picked;
+    }
+}
+
+namespace KCKTargeting
+{
+    FCardTargetSet Select(const FCardTargetSelector& Selector, const FCardAbilityContext& Context)
+    {
+        FCardTargetSet Candidates;
+        const ACombatManager* Combat = Context.CombatManager;
+        const bool bCasterIsPlayer = Context.bCasterIsPlayer;
+
+        if (Combat)
+        {
+            for (const bool bOwnSide : { true, false })
+            {
+                if (!Selector.HasZone(bOwnSide ? ECardTargetZone::OwnField : ECardTargetZone::OpposingField))
+                {
+                    continue;
+                }
+
+                const bool bPlayerSide = bOwnSide == bCasterIsPlayer;
+                const TConstArrayView<FBattlefieldCard> Battlefield = Combat->GetBattlefieldView(bPlayerSide);
+                const uint64 Mask = Combat->GetBattlefieldMasks(bPlayerSide).Filter(Selector.CardTypes, Selector.Factions);
+                Candidates.Field(bPlayerSide) = FilterHealth(Mask, Selector, [&Battlefield](int32 Slot) { return Battlefield[Slot].CurrentHealth; });
+            }
+
+            if (Selector.HasZone(ECardTargetZone::OwnHero))
+            {
+                (bCasterIsPlayer ? Candidates.bPlayerHero : Candidates.bEnemyHero) = true;
+            }
+            if (Selector.HasZone(ECardTargetZone::OpposingHero))
+            {
+                (bCasterIsPlayer ? Candidates.bEnemyHero : Candidates.bPlayerHero) = true;
+            }
+        }
+
+        // Only the player's hand is tracked card by card
+        if (Selector.HasZone(ECardTargetZone::OwnHand) && bCasterIsPlayer && Context.HandManager)
+        {
+            const TConstArrayView<FCardData> Hand = Context.HandManager->GetHandView();
+
+            FCardZoneMasks HandMasks;
+            for (int32 Slot = 0; Slot < Hand.Num(); Slot++)
+            {
+                HandMasks.AddSlot(Slot, Hand[Slot]);
+            }
+            const uint64 Mask = HandMasks.Filter(Selector.CardTypes, Selector.Factions);
+            Candidates.PlayerHand = FilterHealth(Mask, Selector, [&Hand](int32 Slot) { return Hand[Slot].Health; });
+        }
+
+        switch (Selector.Pick)
+        {
+        case ECardTargetPick::Random:
+            return PickRandom(Candidates, FMath::Max(1, Selector.RandomCount), Combat ? &Combat->GetCombatRandom() : nullptr);
+
+        case ECardTargetPick::Chosen:
+        {
+            FCardTargetSet Chosen;
+            if (!ResolveActor(Combat, Context.ChosenTarget, Chosen))
+            {
+                return FCardTargetSet();
+            }
+            Candidates &= Chosen;
+            return Candidates;
+        }
+
+        default:
+            return Candidates;
+        }
+    }
+
+    bool ResolveActor(const ACombatManager* CombatManager, const AActor* Actor, FCardTargetSet& OutTargets)
+    {
+        if (!CombatManager || !Actor)
+        {
+            return false;
+        }
+
+        if (const ABattlefieldCardActor* Creature = Cast<ABattlefieldCardActor>(Actor))
+        {
+            bool bPlayerSide = true;
+            if (!CombatManager->FindBattlefieldCard(Creature->GetUniqueID(), &bPlayerSide))
+            {
+                return false;
+            }
+
+            const int32 Slot = CombatManager->FindBattlefieldIndexByUniqueID(Creature->GetUniqueID(), bPlayerSide);
+            if (Slot == INDEX_NONE || Slot >= FCardZoneMasks::MaxSlots)
+            {
+                return false;
+            }
+
+            OutTargets.Field(bPlayerSide) |= 1ull << Slot;
+            return true;
+        }
+
+        if (Actor == CombatManager->EnemyActor)
+        {
+            OutTargets.bEnemyHero = true;
+            return true;
+        }
+
+        return false;
+    }
+
+    FCardTargetSelector MakeSelector(ECardAbilityTarget Target)
+    {
+        FCardTargetSelector Selector;
+
+        switch (Target)
+        {
+        case ECardAbilityTarget::ChosenTarget:
+            Selector.Zones = (int32)(ECardTargetZone::OwnField | ECardTargetZone::OpposingField | ECardTargetZone::OwnHero | ECardTargetZone::OpposingHero);
+            Selector.Pick = ECardTargetPick::Chosen;
+            break;
+        case ECardAbilityTarget::OwnHero:
+            Selector.Zones = (int32)ECardTargetZone::OwnHero;
+            break;
+        case ECardAbilityTarget::OpposingHero:
+            Selector.Zones = (int32)ECardTargetZone::OpposingHero;
+            break;
+        case ECardAbilityTarget::OwnCreatures:
+            Selector.Zones = (int32)ECardTargetZone::OwnField;
+            break;
+        case ECardAbilityTarget::OpposingCreatures:
+            Selector.Zones = (int32)ECardTargetZone::OpposingField;
+            break;
+        case ECardAbilityTarget::OwnHand:
+            // Hand buffs only ever applied to creature cards
+            Selector.Zones = (int32)ECardTargetZone::OwnHand;
+            Selector.CardTypes = (1 << (int32)ECardType::Creature) | (1 << (int32)ECardType::Champion);
+            break;
+        default:
+            // Self is handled by the interpreter, Selector is authored directly
+            break;
+        }
+
+        return Selector;
+    }
+}
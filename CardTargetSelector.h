@@ -0,0 +1,84 @@
+// CardTargetSelector.h - Bitmask target selection over battlefield and hand slots
+#pragma once
+
+#include "CoreMinimal.h"
+#include "CardTypesHost.h"
+
+class ACombatManager;
+class AActor;
+struct FCardAbilityContext;
+
+// Slot masks of one zone (a battlefield side or the hand), split by card attribute.
+// Bit N is slot N; slots from 64 on cannot be targeted.
+struct FCardZoneMasks
+{
+    static constexpr int32 MaxSlots = 64;
+    static constexpr int32 NumTypes = (int32)ECardType::Champion + 1;
+    static constexpr int32 NumFactions = (int32)ECardFaction::Angel + 1;
+
+    uint64 Occupied = 0;
+    uint64 ByType[NumTypes] = {};
+    uint64 ByFaction[NumFactions] = {};
+
+    void Reset() { *this = FCardZoneMasks(); }
+
+    void AddSlot(int32 Slot, const FCardData& Card);
+
+    // Occupied slots whose card matches the type/faction masks (0 = any)
+    uint64 Filter(int32 TypeMask, int32 FactionMask) const;
+};
+
+// Result of a selector: absolute sides, one bit per slot
+struct FCardTargetSet
+{
+    uint64 PlayerField = 0;
+    uint64 EnemyField = 0;
+    uint64 PlayerHand = 0;
+    bool bPlayerHero = false;
+    bool bEnemyHero = false;
+
+    uint64& Field(bool bPlayerSide) { return bPlayerSide ? PlayerField : EnemyField; }
+    uint64 Field(bool bPlayerSide) const { return bPlayerSide ? PlayerField : EnemyField; }
+
+    int32 Num() const
+    {
+        return FMath::CountBits(PlayerField) + FMath::CountBits(EnemyField) + FMath::CountBits(PlayerHand)
+            + (bPlayerHero ? 1 : 0) + (bEnemyHero ? 1 : 0);
+    }
+
+    bool IsEmpty() const { return Num() == 0; }
+
+    FCardTargetSet& operator&=(const FCardTargetSet& Other)
+    {
+        PlayerField &= Other.PlayerField;
+        EnemyField &= Other.EnemyField;
+        PlayerHand &= Other.PlayerHand;
+        bPlayerHero = bPlayerHero && Other.bPlayerHero;
+        bEnemyHero = bEnemyHero && Other.bEnemyHero;
+        return *this;
+    }
+};
+
+namespace KCKTargeting
+{
+    // Evaluate a selector for the caster in Context
+    KEVESCARDKIT_API FCardTargetSet Select(const FCardTargetSelector& Selector, const FCardAbilityContext& Context);
+
+    // Set the bit for an actor that is part of the card game (battlefield creature or the enemy). False otherwise.
+    KEVESCARDKIT_API bool ResolveActor(const ACombatManager* CombatManager, const AActor* Actor, FCardTargetSet& OutTargets);
+
+    // Selector equivalent of a fixed ability target (Self maps to an empty selector)
+    KEVESCARDKIT_API FCardTargetSelector MakeSelector(ECardAbilityTarget Target);
+
+    // Visit set bits from the highest slot down
+    template <typename FunctionType>
+    void ForEachSlotDescending(uint64 Mask, FunctionType&& Function)
+    {
+        while (Mask != 0)
+        {
+            const int32 Slot = 63 - (int32)FMath::CountLeadingZeros64(Mask);
+            Mask &= ~(1ull << Slot);
+            Function(Slot);
+        }
+    }
+}
@@ -0,0 +1,68 @@
+// CardTriggerRegistry.cpp - Event-bucketed trigger subscriptions
+#include "CardTriggerRegistry.h"
+
+void FCardTriggerRegistry::Register(ECardTriggerEvent Event, FCardTriggerSubscription&& Subscription)
+{
+    const int32 Bucket = (int32)Event;
+    if (Event == ECardTriggerEvent::None || Bucket >= NumEvents)
+    {
+        return;
+    }
+
+    // One triggered ability per permanent: re-registering replaces the old subscription
+    Unregister(Subscription.SourceID);
+
+    EventBySource.Add(Subscription.SourceID, Event);
+    Buckets[Bucket].Add(MoveTemp(Subscription));
+}
+
+void FCardTriggerRegistry::Unregister(int32 SourceID)
+{
+    ECardTriggerEvent Event;
+    if (!EventBySource.RemoveAndCopyValue(SourceID, Event))
+    {
+        return;
+    }
+
+    // Stable removal keeps resolution order for the remaining subscribers
+    TArray<FCardTriggerSubscription>& Bucket = Buckets[(int32)Event];
+    const int32 Index = Bucket.IndexOfByPredicate([SourceID](const FCardTriggerSubscription& Subscription) { return Subscription.SourceID == SourceID; });
+    if (Index != INDEX_NONE)
+    {
+        Bucket.RemoveAt(Index);
+    }
+}
+
+void FCardTriggerRegistry::Reset()
+{
+    for (TArray<FCardTriggerSubscription>& Bucket : Buckets)
+    {
+        Bucket.Reset();
+    }
+    EventBySource.Reset();
+}
+
+int32 FCardTriggerRegistry::GetNumSubscribers(ECardTriggerEvent Event) const
+{
+    const int32 Bucket = (int32)Event;
+    return (Bucket > 0 && Bucket < NumEvents) ? Buckets[Bucket].Num() : 0;
+}
+
+void FCardTriggerRegistry::GatherSubscribers(ECardTriggerEvent Event, bool bEventIsPlayerSide, TArray<FCardTriggerSubscription, TInlineAllocator<8>>& OutSubscribers) const
+{
+    OutSubscribers.Reset();
+
+    const int32 Bucket = (int32)Event;
+    if (Bucket <= 0 || Bucket >= NumEvents)
+    {
+        return;
+    }
+
+    for (const FCardTriggerSubscription& Subscription : Buckets[Bucket])
+    {
+        if (Subscription.ListensTo(bEventIsPlayerSide))
+        {
+            OutSubscribers.Add(Subscription);
+        }
+    }
+}
@@ -0,0 +1,63 @@
+// CardTriggerRegistry.h - Triggered abilities of permanents, indexed by combat event
+#pragma once
+
+#include "CoreMinimal.h"
+#include "CardTypesHost.h"
+
+// A permanent's triggered ability, registered while the permanent is in play
+struct FCardTriggerSubscription
+{
+    // Battlefield UniqueID of a creature, or the handle given to an active power
+    int32 SourceID = -1;
+
+    int32 AbilityID = -1;
+
+    bool bIsPlayerOwned = true;
+
+    ECardTriggerSide Side = ECardTriggerSide::Any;
+
+    // Copy of the permanent's card, passed to the ability as its source
+    FCardData SourceCard;
+
+    // Whether an event raised by this side should run the ability
+    bool ListensTo(bool bEventIsPlayerSide) const
+    {
+        switch (Side)
+        {
+        case ECardTriggerSide::Own:      return bEventIsPlayerSide == bIsPlayerOwned;
+        case ECardTriggerSide::Opposing: return bEventIsPlayerSide != bIsPlayerOwned;
+        default:                         return true;
+        }
+    }
+};
+
+/**
+ * Subscribers bucketed by event, so dispatching an event only visits the permanents listening to it.
+ * Buckets keep registration order, which is the order triggers resolve in.
+ * Owned by ACombatManager; game thread only.
+ */
+class KEVESCARDKIT_API FCardTriggerRegistry
+{
+public:
+    void Register(ECardTriggerEvent Event, FCardTriggerSubscription&& Subscription);
+
+    // Drop the source's subscription; no-op if it has none
+    void Unregister(int32 SourceID);
+
+    void Reset();
+
+    bool IsRegistered(int32 SourceID) const { return EventBySource.Contains(SourceID); }
+
+    int32 GetNumSubscribers(ECardTriggerEvent Event) const;
+
+    // Subscribers of an event that listen to the given side, copied so abilities may register/unregister while they run
+    void GatherSubscribers(ECardTriggerEvent Event, bool bEventIsPlayerSide, TArray<FCardTriggerSubscription, TInlineAllocator<8>>& OutSubscribers) const;
+
+private:
+    static constexpr int32 NumEvents = (int32)ECardTriggerEvent::Count;
+
+    TArray<FCardTriggerSubscription> Buckets[NumEvents];
+
+    // SourceID -> event bucket holding its subscription
+    TMap<int32, ECardTriggerEvent> EventBySource;
+};
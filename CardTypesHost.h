@@ -49,6 +49,176 @@ enum class ECardAbilityType : uint8
     // Add more as needed...
 };
 
+// Primitive operation in a composite ability program (see FCardAbility::Steps)
+UENUM(BlueprintType)
+enum class ECardAbilityOp : uint8
+{
+    None            UMETA(DisplayName = "None"),
+    DrawCards       UMETA(DisplayName = "Draw Cards"),              // Count cards from the draw pile
+    AddCardToHand   UMETA(DisplayName = "Add Card To Hand"),        // Count copies of CardID
+    AddCardToDeck   UMETA(DisplayName = "Add Card To Draw Pile"),   // Count copies of CardID
+    DealDamage      UMETA(DisplayName = "Deal Damage"),             // Amount
+    Heal            UMETA(DisplayName = "Heal"),                    // Amount
+    Buff            UMETA(DisplayName = "Buff"),                    // +Amount attack, +Amount2 health
+    Banish          UMETA(DisplayName = "Banish"),                  // Self, or Count cards from the caster's hand
+    GainEnergy      UMETA(DisplayName = "Gain Energy"),             // Amount
+    Summon          UMETA(DisplayName = "Summon"),                  // Count copies of CardID (creature)
+    ApplyStatus     UMETA(DisplayName = "Apply Status Effect"),     // Amount of Status for Amount2 turns (0 = until used up)
+    AddAura         UMETA(DisplayName = "Add Aura"),                // +Amount attack, +Amount2 health, +CostDelta cost on every card in the target's zones, now and later
+};
+
+// Status effects on battlefield creatures (see FCardStatusEffects)
+UENUM(BlueprintType)
+enum class ECardStatusEffect : uint8
+{
+    Poison          UMETA(DisplayName = "Poison"),          // Damage at the start of the owner's turn, then decays by 1
+    Armor           UMETA(DisplayName = "Armor"),           // Absorbs damage before health
+    Regeneration    UMETA(DisplayName = "Regeneration"),    // Heals at the start of the owner's turn
+
+    Count           UMETA(Hidden)
+};
+
+// Who an ability step applies to, relative to the side that played the card
+UENUM(BlueprintType)
+enum class ECardAbilityTarget : uint8
+{
+    Self                UMETA(DisplayName = "Self (this card)"),
+    ChosenTarget        UMETA(DisplayName = "Chosen Target"),
+    OwnHero             UMETA(DisplayName = "Own Life Crystal"),
+    OpposingHero        UMETA(DisplayName = "Opposing Life Crystal"),
+    OwnCreatures        UMETA(DisplayName = "All Own Creatures"),
+    OpposingCreatures   UMETA(DisplayName = "All Opposing Creatures"),
+    OwnHand             UMETA(DisplayName = "Own Hand"),
+    Selector            UMETA(DisplayName = "Custom Selector"),
+};
+
+// Zones a target selector draws from, relative to the caster
+UENUM(BlueprintType, meta = (Bitflags, UseEnumValuesAsMaskValuesInEditor = "true"))
+enum class ECardTargetZone : uint8
+{
+    None            = 0         UMETA(Hidden),
+    OwnField        = 1 << 0    UMETA(DisplayName = "Own Battlefield"),
+    OpposingField   = 1 << 1    UMETA(DisplayName = "Opposing Battlefield"),
+    OwnHand         = 1 << 2    UMETA(DisplayName = "Own Hand"),
+    OwnHero         = 1 << 3    UMETA(DisplayName = "Own Life Crystal"),
+    OpposingHero    = 1 << 4    UMETA(DisplayName = "Opposing Life Crystal"),
+};
+ENUM_CLASS_FLAGS(ECardTargetZone)
+
+// How targets are picked from the candidates that pass the filters
+UENUM(BlueprintType)
+enum class ECardTargetPick : uint8
+{
+    All         UMETA(DisplayName = "All"),
+    Random      UMETA(DisplayName = "Random"),
+    Chosen      UMETA(DisplayName = "Chosen Target"),
+};
+
+// Query such as "a random opposing creature" or "all creatures on the field and in hand"
+USTRUCT(BlueprintType)
+struct FCardTargetSelector
+{
+    GENERATED_BODY()
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (Bitmask, BitmaskEnum = "/Script/KevesCardKit.ECardTargetZone"))
+    int32 Zones = 0;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    ECardTargetPick Pick = ECardTargetPick::All;
+
+    // Distinct targets picked when Pick is Random
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    int32 RandomCount = 1;
+
+    // Allowed card types / factions; nothing ticked allows all
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (Bitmask, BitmaskEnum = "/Script/KevesCardKit.ECardType"))
+    int32 CardTypes = 0;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (Bitmask, BitmaskEnum = "/Script/KevesCardKit.ECardFaction"))
+    int32 Factions = 0;
+
+    // Current health bounds, inclusive (0 = unbounded)
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    int32 MinHealth = 0;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    int32 MaxHealth = 0;
+
+    bool HasZone(ECardTargetZone Zone) const { return (Zones & (int32)Zone) != 0; }
+};
+
+// Combat event that runs a triggered ability (see FCardAbility::Trigger)
+UENUM(BlueprintType)
+enum class ECardTriggerEvent : uint8
+{
+    None            UMETA(DisplayName = "None (runs when played)"),
+    TurnStart       UMETA(DisplayName = "At Start Of Turn"),
+    CardBanished    UMETA(DisplayName = "Whenever A Card Is Banished"),
+    CreatureSummoned UMETA(DisplayName = "Whenever A Creature Is Summoned"),
+    CreatureDied    UMETA(DisplayName = "Whenever A Creature Dies"),
+    CardPlayed      UMETA(DisplayName = "Whenever A Card Is Played"),
+
+    Count           UMETA(Hidden)
+};
+
+// Whose events a trigger listens to, relative to the permanent's owner
+UENUM(BlueprintType)
+enum class ECardTriggerSide : uint8
+{
+    Any         UMETA(DisplayName = "Either Side"),
+    Own         UMETA(DisplayName = "Own Side"),
+    Opposing    UMETA(DisplayName = "Opposing Side"),
+};
+
+// One authored step of an ability, e.g. "Banish 1 card" or "Draw 2 cards"
+USTRUCT(BlueprintType)
+struct FCardAbilityStep
+{
+    GENERATED_BODY()
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    ECardAbilityOp Op = ECardAbilityOp::None;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    ECardAbilityTarget Target = ECardAbilityTarget::Self;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    int32 Amount = 0;
+
+    // Secondary amount (health for Buff)
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    int32 Amount2 = 0;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    int32 Count = 1;
+
+    // Card definition for AddCardToHand / AddCardToDeck / Summon
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    int32 CardID = -1;
+
+    // Effect for ApplyStatus
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    ECardStatusEffect Status = ECardStatusEffect::Poison;
+
+    // Cost change for AddAura (negative makes cards cheaper)
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    int32 CostDelta = 0;
+
+    // Optional "X" values that replace Amount / Count when the step runs, e.g. "X+1" or "Copies*2".
+    // Variables (relative to the caster): X (energy spent on the card), Energy, Copies (of this card played
+    // this turn, including this one), OwnCreatures, EnemyCreatures, Hand, Discard. Operators + - * / ( ),
+    // min(a, b), max(a, b). Compiled with the catalog; a bad expression logs a warning and keeps the fixed value.
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    FString AmountExpression;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    FString CountExpression;
+
+    // Used when Target is Custom Selector
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    FCardTargetSelector Selector;
+};
+
 
 USTRUCT(BlueprintType)
 struct FCardData : public FTableRowBase
@@ -89,6 +259,42 @@ struct FCardData : public FTableRowBase
     UTexture2D* CardArt = nullptr;
 };
 
+// Compact payload for hand change events. Listeners read the slots they care about
+// through AHandManager / UCombatUIWidget accessors instead of receiving a copy of the hand.
+USTRUCT(BlueprintType)
+struct FHandChangeSet
+{
+    GENERATED_BODY()
+
+    // Bit i set = hand slot i must be redrawn: a card entered it or its card changed.
+    // AHandManager also sets slots that cards shifted into or out of here.
+    UPROPERTY(BlueprintReadOnly)
+    int64 ChangedSlotMask = 0;
+
+    // Bit i set = slot i now holds an unchanged card that moved from another slot (move its widget, no rebuild)
+    UPROPERTY(BlueprintReadOnly)
+    int64 ShiftedSlotMask = 0;
+
+    // Bit i set = the card that was in slot i before this change left the hand
+    UPROPERTY(BlueprintReadOnly)
+    int64 RemovedSlotMask = 0;
+
+    UPROPERTY(BlueprintReadOnly)
+    int32 HandSize = 0;
+
+    UPROPERTY(BlueprintReadOnly)
+    int32 DeckSize = 0;
+
+    // Increments on every broadcast; lets listeners detect missed updates
+    UPROPERTY(BlueprintReadOnly)
+    int32 Version = 0;
+
+    bool DidSlotChange(int32 Slot) const
+    {
+        return Slot >= 0 && Slot < 64 && (ChangedSlotMask & (1ll << Slot)) != 0;
+    }
+};
+
 USTRUCT(BlueprintType)
 struct FCardAbility : public FTableRowBase
 {
@@ -114,4 +320,18 @@ struct FCardAbility : public FTableRowBase
 
     UPROPERTY(EditAnywhere, BlueprintReadWrite)
     int32 Amount = 0;
+
+    // Composite program, run in order. When set, AbilityType/CardIDsToAffect/Count/Amount are ignored.
+    // Compiled into FCardCatalog's op list when the catalog is built.
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    TArray<FCardAbilityStep> Steps;
+
+    // When set, the ability does not run on play. The permanent (creature on the battlefield or
+    // active power) runs it each time the event happens, until it leaves play.
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    ECardTriggerEvent Trigger = ECardTriggerEvent::None;
+
+    // e.g. Own + TurnStart = "at the start of your turn"
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    ECardTriggerSide TriggerSide = ECardTriggerSide::Any;
 };
\ No newline at end of file
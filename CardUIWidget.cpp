@@ -1,6 +1,9 @@
 // CardUIWidget.cpp - Complete Implementation
 #include "CardUIWidget.h"
+#include "KevesCardKitLog.h"
+#include "KevesCardKitMemory.h"
 #include "HandManager.h"
+#include "CardDisplayCache.h"
 
 UCardUIWidget::UCardUIWidget(const FObjectInitializer& ObjectInitializer)
     : Super(ObjectInitializer)
@@ -9,11 +12,31 @@ UCardUIWidget::UCardUIWidget(const FObjectInitializer& ObjectInitializer)
     CurrentDisplayData.HandIndex = -1;
 }
 
+void UCardUIWidget::NativeOnInitialized()
+{
+    Super::NativeOnInitialized();
+
+    // Counted for the widget's whole life, including while it sits in a pool
+    KCKMemory::AddBytes(ECardKitMemoryCategory::Widgets, GetClass()->GetStructureSize());
+    bCountedInMemory = true;
+}
+
 void UCardUIWidget::NativeConstruct()
 {
     Super::NativeConstruct();
 }
 
+void UCardUIWidget::BeginDestroy()
+{
+    if (bCountedInMemory)
+    {
+        KCKMemory::AddBytes(ECardKitMemoryCategory::Widgets, -GetClass()->GetStructureSize());
+        bCountedInMemory = false;
+    }
+
+    Super::BeginDestroy();
+}
+
 void UCardUIWidget::InitializeCardWidget(const FCardData& CardData, int32 InHandIndex)
 {
     CurrentDisplayData.CardData = CardData;
@@ -30,7 +53,7 @@ void UCardUIWidget::InitializeCardWidget(const FCardData& CardData, int32 InHand
         ICardWidget::Execute_SetCardData(this, CurrentDisplayData);
     }
 
-    UE_LOG(LogTemp, Log, TEXT("[CardUI] Initialized card widget: %s at index %d (initially playable)"),
+    KCK_LOG_HOT(LogKevesCardKitUI, Verbose, TEXT("[CardUI] Initialized card widget: %s at index %d (initially playable)"),
         *CardData.Name.ToString(), InHandIndex);
 }
 
@@ -87,48 +110,57 @@ void UCardUIWidget::UpdateSelectedState(bool bIsSelected)
 
 void UCardUIWidget::RefreshCardDisplayData()
 {
-    FCardDisplayData NewData = BuildDisplayData();
+    const FCardDisplayDataRef Entry = FindDisplayEntry();
 
-    // Only broadcast if data actually changed
-    if (HasDisplayDataChanged(NewData, LastDisplayData))
+    // Equal inputs resolve to the same cache entry, so pointer identity means nothing changed
+    if (DisplayEntry.Get() == &Entry.Get() && DisplayedHandIndex == CurrentDisplayData.HandIndex)
     {
-        LastDisplayData = NewData;
-        CurrentDisplayData = NewData;
-        OnCardDisplayDataUpdated.Broadcast(NewData);
+        return;
     }
+
+    // CurrentDisplayData is the Blueprint-visible copy; refresh it once per actual change
+    const int32 HandIndex = CurrentDisplayData.HandIndex;
+    DisplayEntry = Entry;
+    DisplayedHandIndex = HandIndex;
+    CurrentDisplayData = *Entry;
+    CurrentDisplayData.HandIndex = HandIndex;
+    OnCardDisplayDataUpdated.Broadcast(CurrentDisplayData);
+}
+
+void UCardUIWidget::ResetForReuse()
+{
+    CurrentDisplayData = FCardDisplayData();
+    DisplayEntry.Reset(); // Forces the next refresh to broadcast
+    DisplayedHandIndex = INDEX_NONE;
 }
 
 void UCardUIWidget::RequestCardInteraction()
 {
-    // Add more detailed logging to help debug the issue
-    UE_LOG(LogTemp, Log, TEXT("[CardUI] RequestCardInteraction called for card: %s"),
-        *CurrentDisplayData.CardData.Name.ToString());
-    UE_LOG(LogTemp, Log, TEXT("[CardUI] - HandIndex: %d"), CurrentDisplayData.HandIndex);
-    UE_LOG(LogTemp, Log, TEXT("[CardUI] - bIsPlayable: %s"), CurrentDisplayData.bIsPlayable ? TEXT("true") : TEXT("false"));
+    KCK_LOG_HOT(LogKevesCardKitUI, Verbose, TEXT("[CardUI] RequestCardInteraction called for card: %s (HandIndex: %d, Playable: %s)"),
+        *CurrentDisplayData.CardData.Name.ToString(), CurrentDisplayData.HandIndex, CurrentDisplayData.bIsPlayable ? TEXT("true") : TEXT("false"));
 
     if (CurrentDisplayData.bIsPlayable && CurrentDisplayData.HandIndex >= 0)
     {
         // Call HandManager directly instead of broadcasting
         if (HandManager)
         {
-            UE_LOG(LogTemp, Log, TEXT("[CardUI] Calling HandManager->PlayCard directly"));
             bool bSuccess = HandManager->PlayCard(CurrentDisplayData.HandIndex, nullptr);
-            UE_LOG(LogTemp, Log, TEXT("[CardUI] HandManager->PlayCard result: %s"), bSuccess ? TEXT("Success") : TEXT("Failed"));
+            KCK_LOG_HOT(LogKevesCardKitUI, Verbose, TEXT("[CardUI] HandManager->PlayCard result: %s"), bSuccess ? TEXT("Success") : TEXT("Failed"));
         }
         else
         {
-            UE_LOG(LogTemp, Warning, TEXT("[CardUI] Cannot play card - HandManager is null"));
+            UE_LOG(LogKevesCardKitUI, Warning, TEXT("[CardUI] Cannot play card - HandManager is null"));
         }
     }
     else
     {
         if (!CurrentDisplayData.bIsPlayable)
         {
-            UE_LOG(LogTemp, Warning, TEXT("[CardUI] Cannot interact with card - not playable"));
+            UE_LOG(LogKevesCardKitUI, Warning, TEXT("[CardUI] Cannot interact with card - not playable"));
         }
         if (CurrentDisplayData.HandIndex < 0)
         {
-            UE_LOG(LogTemp, Warning, TEXT("[CardUI] Cannot interact with card - invalid hand index: %d"), CurrentDisplayData.HandIndex);
+            UE_LOG(LogKevesCardKitUI, Warning, TEXT("[CardUI] Cannot interact with card - invalid hand index: %d"), CurrentDisplayData.HandIndex);
         }
     }
 }
@@ -145,51 +177,27 @@ void UCardUIWidget::RequestCardUnhover()
 
 FString UCardUIWidget::GetCardTypeDisplayName(ECardType CardType) const
 {
-    switch (CardType)
-    {
-    case ECardType::Creature: return TEXT("Creature");
-    case ECardType::Spell: return TEXT("Spell");
-    case ECardType::Power: return TEXT("Power");
-    case ECardType::Skill: return TEXT("Skill");
-    case ECardType::Champion: return TEXT("Champion");
-    default: return TEXT("Unknown");
-    }
+    return FCardDisplayDataCache::GetCardTypeDisplayName(CardType);
 }
 
 FString UCardUIWidget::GetFactionDisplayName(ECardFaction Faction) const
 {
-    switch (Faction)
-    {
-    case ECardFaction::Demon: return TEXT("Demon");
-    case ECardFaction::Undead: return TEXT("Undead");
-    case ECardFaction::Angel: return TEXT("Angel");
-    default: return TEXT("Neutral");
-    }
+    return FCardDisplayDataCache::GetFactionDisplayName(Faction);
 }
 
 FLinearColor UCardUIWidget::GetFactionColor(ECardFaction Faction) const
 {
-    switch (Faction)
-    {
-    case ECardFaction::Demon:
-        return FLinearColor::Red;
-    case ECardFaction::Undead:
-        return FLinearColor(0.4f, 0.2f, 0.4f, 1.0f); // Purple-ish
-    case ECardFaction::Angel:
-        return FLinearColor(1.0f, 1.0f, 0.8f, 1.0f); // Light yellow
-    default:
-        return FLinearColor::White;
-    }
+    return FCardDisplayDataCache::GetFactionColor(Faction);
 }
 
 bool UCardUIWidget::ShouldShowAttackHealth(ECardType CardType) const
 {
-    return CardType == ECardType::Creature || CardType == ECardType::Champion;
+    return FCardDisplayDataCache::ShouldShowAttackHealth(CardType);
 }
 
 void UCardUIWidget::ForcePlayableState(bool bForcePlayable)
 {
-    UE_LOG(LogTemp, Log, TEXT("[CardUI] ForcePlayableState called: %s for card %s"),
+    UE_LOG(LogKevesCardKitUI, Log, TEXT("[CardUI] ForcePlayableState called: %s for card %s"),
         bForcePlayable ? TEXT("Playable") : TEXT("Not Playable"),
         *CurrentDisplayData.CardData.Name.ToString());
 
@@ -203,7 +211,7 @@ void UCardUIWidget::SetCardData_Implementation(const FCardDisplayData& CardDispl
     CurrentDisplayData = CardDisplayData;
     RefreshCardDisplayData();
 
-    UE_LOG(LogTemp, Log, TEXT("[CardUI] SetCardData_Implementation called for: %s"),
+    KCK_LOG_HOT(LogKevesCardKitUI, Verbose, TEXT("[CardUI] SetCardData_Implementation called for: %s"),
         *CardDisplayData.CardData.Name.ToString());
 }
 
@@ -211,14 +219,14 @@ void UCardUIWidget::UpdateCardDisplay_Implementation()
 {
     RefreshCardDisplayData();
 
-    UE_LOG(LogTemp, VeryVerbose, TEXT("[CardUI] UpdateCardDisplay_Implementation called"));
+    KCK_LOG_HOT(LogKevesCardKitUI, VeryVerbose, TEXT("[CardUI] UpdateCardDisplay_Implementation called"));
 }
 
 void UCardUIWidget::SetPlayable_Implementation(bool bCanPlay)
 {
     UpdatePlayableState(bCanPlay);
 
-    UE_LOG(LogTemp, VeryVerbose, TEXT("[CardUI] SetPlayable_Implementation called: %s"),
+    KCK_LOG_HOT(LogKevesCardKitUI, VeryVerbose, TEXT("[CardUI] SetPlayable_Implementation called: %s"),
         bCanPlay ? TEXT("Playable") : TEXT("Not Playable"));
 }
 
@@ -226,7 +234,7 @@ void UCardUIWidget::SetHovered_Implementation(bool bIsHovered)
 {
     UpdateHoverState(bIsHovered);
 
-    UE_LOG(LogTemp, VeryVerbose, TEXT("[CardUI] SetHovered_Implementation called: %s"),
+    KCK_LOG_HOT(LogKevesCardKitUI, VeryVerbose, TEXT("[CardUI] SetHovered_Implementation called: %s"),
         bIsHovered ? TEXT("Hovered") : TEXT("Not Hovered"));
 }
 
@@ -234,70 +242,15 @@ void UCardUIWidget::SetSelected_Implementation(bool bIsSelected)
 {
     UpdateSelectedState(bIsSelected);
 
-    UE_LOG(LogTemp, VeryVerbose, TEXT("[CardUI] SetSelected_Implementation called: %s"),
+    KCK_LOG_HOT(LogKevesCardKitUI, VeryVerbose, TEXT("[CardUI] SetSelected_Implementation called: %s"),
         bIsSelected ? TEXT("Selected") : TEXT("Not Selected"));
 }
 
 // === HELPER FUNCTIONS ===
 
-FCardDisplayData UCardUIWidget::BuildDisplayData() const
-{
-    FCardDisplayData Data = CurrentDisplayData; // Copy current state
-
-    // Update computed/derived values
-    Data.CardTypeDisplayName = GetCardTypeDisplayName(Data.CardData.CardType);
-    Data.FactionDisplayName = GetFactionDisplayName(Data.CardData.CardFaction);
-    Data.FactionColor = GetFactionColor(Data.CardData.CardFaction);
-    Data.bShouldShowAttackHealth = ShouldShowAttackHealth(Data.CardData.CardType);
-
-    // Set border color based on playability and faction
-    if (!Data.bIsPlayable)
-    {
-        Data.CardBorderColor = FLinearColor::Gray;
-        Data.DisplayOpacity = 0.6f;
-    }
-    else if (Data.bIsSelected)
-    {
-        Data.CardBorderColor = FLinearColor::Yellow; // Selected state
-        Data.DisplayOpacity = 1.0f;
-    }
-    else if (Data.bIsHovered)
-    {
-        Data.CardBorderColor = FLinearColor::White; // Hover state
-        Data.DisplayOpacity = 1.0f;
-    }
-    else
-    {
-        Data.CardBorderColor = Data.FactionColor;
-        Data.DisplayOpacity = 1.0f;
-    }
-
-    // Format text fields for convenience
-    Data.FormattedCostText = FString::Printf(TEXT("%d"), Data.CardData.Cost);
-
-    if (Data.bShouldShowAttackHealth)
-    {
-        Data.FormattedAttackText = FString::Printf(TEXT("%d"), Data.CardData.Attack);
-        Data.FormattedHealthText = FString::Printf(TEXT("%d"), Data.CardData.Health);
-    }
-    else
-    {
-        Data.FormattedAttackText = TEXT("");
-        Data.FormattedHealthText = TEXT("");
-    }
-
-    return Data;
-}
-
-bool UCardUIWidget::HasDisplayDataChanged(const FCardDisplayData& NewData, const FCardDisplayData& OldData) const
+FCardDisplayDataRef UCardUIWidget::FindDisplayEntry() const
 {
-    // Check if any important display data has changed
-    return (NewData.CardData.ID != OldData.CardData.ID ||
-        NewData.HandIndex != OldData.HandIndex ||
-        NewData.bIsPlayable != OldData.bIsPlayable ||
-        NewData.bIsHovered != OldData.bIsHovered ||
-        NewData.bIsSelected != OldData.bIsSelected ||
-        NewData.CardData.Cost != OldData.CardData.Cost ||
-        NewData.CardData.Attack != OldData.CardData.Attack ||
-        NewData.CardData.Health != OldData.CardData.Health);
+    // Derived values come from the shared cache; the slot index is applied by the caller
+    return FCardDisplayDataCache::Get().FindOrBuild(CurrentDisplayData.CardData,
+        CurrentDisplayData.bIsPlayable, CurrentDisplayData.bIsHovered, CurrentDisplayData.bIsSelected);
 }
\ No newline at end of file
@@ -21,7 +21,10 @@ class KEVESCARDKIT_API UCardUIWidget : public UUserWidget, public ICardWidget
 public:
     UCardUIWidget(const FObjectInitializer& ObjectInitializer);
 
+    virtual void BeginDestroy() override;
+
 protected:
+    virtual void NativeOnInitialized() override;
     virtual void NativeConstruct() override;
 
 public:
@@ -60,6 +63,10 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Card UI")
     void RefreshCardDisplayData();
 
+    // Clear per-card state so a pooled widget rebinds cleanly on its next SetCardData
+    UFUNCTION(BlueprintCallable, Category = "Card UI")
+    void ResetForReuse();
+
     // Data getters (for manual data access)
     UFUNCTION(BlueprintPure, Category = "Card UI Data")
     FCardDisplayData GetCardDisplayData() const { return CurrentDisplayData; }
@@ -109,9 +116,13 @@ protected:
 private:
     // === HELPER FUNCTIONS ===
 
-    FCardDisplayData BuildDisplayData() const;
+    FCardDisplayDataRef FindDisplayEntry() const;
     void BroadcastDisplayDataUpdate();
-    bool HasDisplayDataChanged(const FCardDisplayData& NewData, const FCardDisplayData& OldData) const;
 
-    FCardDisplayData LastDisplayData;
+    // Cache entry and slot last copied into CurrentDisplayData
+    FCardDisplayDataPtr DisplayEntry;
+    int32 DisplayedHandIndex = INDEX_NONE;
+
+    // Set once this widget has been added to KCKMemory's widget total
+    bool bCountedInMemory = false;
 };
\ No newline at end of file
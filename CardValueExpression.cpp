@@ -0,0 +1,328 @@
+// CardValueExpression.cpp - Expression parser (shunting-yard) and postfix evaluator
+#include "CardValueExpression.h"
+
+namespace
+{
+    struct FVariableName
+    {
+        const TCHAR* Name;
+        ECardValueVar Var;
+    };
+
+    const FVariableName VariableNames[] =
+    {
+        { TEXT("X"),                 ECardValueVar::EnergySpent },
+        { TEXT("EnergySpent"),       ECardValueVar::EnergySpent },
+        { TEXT("Energy"),            ECardValueVar::Energy },
+        { TEXT("Copies"),            ECardValueVar::CopiesPlayed },
+        { TEXT("OwnCreatures"),      ECardValueVar::OwnCreatures },
+        { TEXT("EnemyCreatures"),    ECardValueVar::OpposingCreatures },
+        { TEXT("OpposingCreatures"), ECardValueVar::OpposingCreatures },
+        { TEXT("Hand"),              ECardValueVar::HandSize },
+        { TEXT("Discard"),           ECardValueVar::DiscardSize },
+    };
+
+    // Entry on the shunting-yard operator stack
+    struct FPendingOp
+    {
+        enum EKind : uint8 { Operator, Function, Paren };
+
+        EKind Kind = Operator;
+        ECardExprOpcode Opcode = ECardExprOpcode::Add;
+        int32 Precedence = 0;
+        bool bRightAssoc = false;
+    };
+
+    // Results are computed in int64 and clamped, so overflow saturates instead of wrapping
+    int32 Saturate(int64 Value)
+    {
+        return (int32)FMath::Clamp<int64>(Value, MIN_int32, MAX_int32);
+    }
+
+    bool IsBinary(ECardExprOpcode Opcode)
+    {
+        return Opcode != ECardExprOpcode::PushConst && Opcode != ECardExprOpcode::PushVar && Opcode != ECardExprOpcode::Neg;
+    }
+
+    // Stack effect check: every operator has its operands, one value is left, and the stack stays shallow
+    bool ValidateStack(TConstArrayView<FCardExprInstr> Code, FString& OutError)
+    {
+        int32 Depth = 0;
+        for (const FCardExprInstr& Instr : Code)
+        {
+            if (Instr.Opcode == ECardExprOpcode::PushConst || Instr.Opcode == ECardExprOpcode::PushVar)
+            {
+                if (++Depth > KCKValueExpr::MaxStackDepth)
+                {
+                    OutError = TEXT("expression is nested too deeply");
+                    return false;
+                }
+            }
+            else if (Depth < (IsBinary(Instr.Opcode) ? 2 : 1))
+            {
+                OutError = TEXT("operator is missing an operand");
+                return false;
+            }
+            else if (IsBinary(Instr.Opcode))
+            {
+                Depth--;
+            }
+        }
+
+        if (Depth != 1)
+        {
+            OutError = TEXT("malformed expression (check function arguments)");
+            return false;
+        }
+        return true;
+    }
+}
+
+namespace KCKValueExpr
+{
+    bool Compile(const FString& Source, TArray<FCardExprInstr>& OutCode, FString& OutError)
+    {
+        TArray<FCardExprInstr, TInlineAllocator<32>> Code;
+        TArray<FPendingOp, TInlineAllocator<16>> Pending;
+        bool bExpectOperand = true;
+
+        auto Emit = [&Code](ECardExprOpcode Opcode, int32 Operand = 0)
+        {
+            FCardExprInstr& Instr = Code.AddDefaulted_GetRef();
+            Instr.Opcode = Opcode;
+            Instr.Operand = Operand;
+        };
+
+        // Pop operators down to (not including) the innermost open parenthesis
+        auto PopToParen = [&]()
+        {
+            while (Pending.Num() > 0 && Pending.Last().Kind != FPendingOp::Paren)
+            {
+                Emit(Pending.Pop().Opcode);
+            }
+            return Pending.Num() > 0;
+        };
+
+        const TCHAR* Chars = *Source;
+        int32 Pos = 0;
+        while (Chars[Pos] != 0)
+        {
+            const TCHAR Char = Chars[Pos];
+
+            if (FChar::IsWhitespace(Char))
+            {
+                Pos++;
+            }
+            else if (FChar::IsDigit(Char))
+            {
+                if (!bExpectOperand)
+                {
+                    OutError = FString::Printf(TEXT("unexpected number at %d"), Pos);
+                    return false;
+                }
+
+                int64 Value = 0;
+                while (FChar::IsDigit(Chars[Pos]))
+                {
+                    Value = Value * 10 + (Chars[Pos++] - TEXT('0'));
+                    if (Value > MAX_int32)
+                    {
+                        OutError = TEXT("number is too large");
+                        return false;
+                    }
+                }
+                Emit(ECardExprOpcode::PushConst, (int32)Value);
+                bExpectOperand = false;
+            }
+            else if (FChar::IsAlpha(Char) || Char == TEXT('_'))
+            {
+                if (!bExpectOperand)
+                {
+                    OutError = FString::Printf(TEXT("unexpected name at %d"), Pos);
+                    return false;
+                }
+
+                const int32 Start = Pos;
+                while (FChar::IsAlnum(Chars[Pos]) || Chars[Pos] == TEXT('_'))
+                {
+                    Pos++;
+                }
+                const FString Name(Pos - Start, Chars + Start);
+
+                if (Name.Equals(TEXT("min"), ESearchCase::IgnoreCase) || Name.Equals(TEXT("max"), ESearchCase::IgnoreCase))
+                {
+                    // The '(' that follows opens its argument list
+                    FPendingOp& Function = Pending.AddDefaulted_GetRef();
+                    Function.Kind = FPendingOp::Function;
+                    Function.Opcode = Name.Equals(TEXT("min"), ESearchCase::IgnoreCase) ? ECardExprOpcode::Min : ECardExprOpcode::Max;
+                    continue;
+                }
+
+                const FVariableName* Variable = nullptr;
+                for (const FVariableName& Candidate : VariableNames)
+                {
+                    if (Name.Equals(Candidate.Name, ESearchCase::IgnoreCase))
+                    {
+                        Variable = &Candidate;
+                        break;
+                    }
+                }
+                if (!Variable)
+                {
+                    OutError = FString::Printf(TEXT("unknown variable '%s'"), *Name);
+                    return false;
+                }
+
+                Emit(ECardExprOpcode::PushVar, (int32)Variable->Var);
+                bExpectOperand = false;
+            }
+            else if (Char == TEXT('('))
+            {
+                if (!bExpectOperand)
+                {
+                    OutError = FString::Printf(TEXT("unexpected '(' at %d"), Pos);
+                    return false;
+                }
+                Pending.AddDefaulted_GetRef().Kind = FPendingOp::Paren;
+                Pos++;
+            }
+            else if (Char == TEXT(')') || Char == TEXT(','))
+            {
+                if (bExpectOperand || !PopToParen())
+                {
+                    OutError = FString::Printf(TEXT("unexpected '%c' at %d"), Char, Pos);
+                    return false;
+                }
+
+                const bool bInFunction = Pending.Num() > 1 && Pending[Pending.Num() - 2].Kind == FPendingOp::Function;
+                if (Char == TEXT(','))
+                {
+                    if (!bInFunction)
+                    {
+                        OutError = FString::Printf(TEXT("',' outside a function call at %d"), Pos);
+                        return false;
+                    }
+                    bExpectOperand = true;
+                }
+                else
+                {
+                    Pending.Pop();
+                    if (bInFunction)
+                    {
+                        Emit(Pending.Pop().Opcode);
+                    }
+                }
+                Pos++;
+            }
+            else if (Char == TEXT('+') || Char == TEXT('-') || Char == TEXT('*') || Char == TEXT('/'))
+            {
+                FPendingOp Op;
+                if (bExpectOperand)
+                {
+                    if (Char == TEXT('+'))
+                    {
+                        Pos++;
+                        continue; // Unary plus changes nothing
+                    }
+                    if (Char != TEXT('-'))
+                    {
+                        OutError = FString::Printf(TEXT("unexpected '%c' at %d"), Char, Pos);
+                        return false;
+                    }
+                    Op.Opcode = ECardExprOpcode::Neg;
+                    Op.Precedence = 3;
+                    Op.bRightAssoc = true;
+                }
+                else
+                {
+                    Op.Opcode = Char == TEXT('+') ? ECardExprOpcode::Add
+                        : Char == TEXT('-') ? ECardExprOpcode::Sub
+                        : Char == TEXT('*') ? ECardExprOpcode::Mul
+                        : ECardExprOpcode::Div;
+                    Op.Precedence = (Char == TEXT('+') || Char == TEXT('-')) ? 1 : 2;
+
+                    while (Pending.Num() > 0 && Pending.Last().Kind == FPendingOp::Operator
+                        && (Pending.Last().Precedence > Op.Precedence || (Pending.Last().Precedence == Op.Precedence && !Op.bRightAssoc)))
+                    {
+                        Emit(Pending.Pop().Opcode);
+                    }
+                }
+
+                Pending.Add(Op);
+                bExpectOperand = true;
+                Pos++;
+            }
+            else
+            {
+                OutError = FString::Printf(TEXT("unexpected '%c' at %d"), Char, Pos);
+                return false;
+            }
+        }
+
+        if (bExpectOperand)
+        {
+            OutError = TEXT("expression is incomplete");
+            return false;
+        }
+
+        while (Pending.Num() > 0)
+        {
+            const FPendingOp Op = Pending.Pop();
+            if (Op.Kind != FPendingOp::Operator)
+            {
+                OutError = TEXT("unbalanced parentheses");
+                return false;
+            }
+            Emit(Op.Opcode);
+        }
+
+        if (!ValidateStack(Code, OutError))
+        {
+            return false;
+        }
+
+        OutCode.Append(Code);
+        return true;
+    }
+
+    int32 Evaluate(TConstArrayView<FCardExprInstr> Code, const FCardValueVars& Vars)
+    {
+        // Compile has checked the stack depth and every operator's operands
+        int32 Stack[MaxStackDepth];
+        int32 Top = 0;
+
+        for (const FCardExprInstr& Instr : Code)
+        {
+            switch (Instr.Opcode)
+            {
+            case ECardExprOpcode::PushConst:
+                Stack[Top++] = Instr.Operand;
+                break;
+            case ECardExprOpcode::PushVar:
+                Stack[Top++] = Vars[(ECardValueVar)Instr.Operand];
+                break;
+            case ECardExprOpcode::Neg:
+                Stack[Top - 1] = Saturate(-(int64)Stack[Top - 1]);
+                break;
+            default:
+            {
+                const int64 Right = Stack[--Top];
+                int32& Left = Stack[Top - 1];
+                switch (Instr.Opcode)
+                {
+                case ECardExprOpcode::Add: Left = Saturate(Left + Right); break;
+                case ECardExprOpcode::Sub: Left = Saturate(Left - Right); break;
+                case ECardExprOpcode::Mul: Left = Saturate(Left * Right); break;
+                case ECardExprOpcode::Div: Left = Right != 0 ? Saturate(Left / Right) : 0; break; // MIN_int32 / -1 saturates
+                case ECardExprOpcode::Min: Left = (int32)FMath::Min<int64>(Left, Right); break;
+                case ECardExprOpcode::Max: Left = (int32)FMath::Max<int64>(Left, Right); break;
+                default: break;
+                }
+                break;
+            }
+            }
+        }
+
+        return Top > 0 ? Stack[Top - 1] : 0;
+    }
+}
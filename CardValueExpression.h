@@ -0,0 +1,67 @@
+// CardValueExpression.h - "X" card values: small arithmetic expressions compiled to postfix code
+#pragma once
+
+#include "CoreMinimal.h"
+
+enum class ECardExprOpcode : uint8
+{
+    PushConst,  // Operand = value
+    PushVar,    // Operand = ECardValueVar
+    Add,
+    Sub,
+    Mul,
+    Div,        // Integer division; dividing by zero gives 0
+    Neg,
+    Min,
+    Max,
+};
+
+struct FCardExprInstr
+{
+    ECardExprOpcode Opcode = ECardExprOpcode::PushConst;
+    int32 Operand = 0;
+};
+
+// Combat values an expression can read, relative to the caster
+enum class ECardValueVar : uint8
+{
+    EnergySpent,        // "X" / "EnergySpent": energy paid for the card being played
+    Energy,             // "Energy": current energy
+    CopiesPlayed,       // "Copies": copies of this card played this turn, including this one
+    OwnCreatures,       // "OwnCreatures"
+    OpposingCreatures,  // "EnemyCreatures" / "OpposingCreatures"
+    HandSize,           // "Hand"
+    DiscardSize,        // "Discard"
+
+    Count
+};
+
+struct FCardValueVars
+{
+    int32 Values[(int32)ECardValueVar::Count] = {};
+
+    int32& operator[](ECardValueVar Var) { return Values[(int32)Var]; }
+    int32 operator[](ECardValueVar Var) const { return Values[(int32)Var]; }
+};
+
+// A compiled expression's slice of FCardCatalog's shared code array (Num = 0: no expression)
+struct FCardExprRange
+{
+    int32 First = 0;
+    int32 Num = 0;
+
+    bool IsSet() const { return Num > 0; }
+};
+
+namespace KCKValueExpr
+{
+    // Deepest evaluation stack a compiled expression may need
+    static constexpr int32 MaxStackDepth = 16;
+
+    // Parse Source (integers, variables, + - * / and parentheses, min(a, b), max(a, b)) and append its
+    // postfix code to OutCode. On error nothing is appended and OutError says why.
+    KEVESCARDKIT_API bool Compile(const FString& Source, TArray<FCardExprInstr>& OutCode, FString& OutError);
+
+    // Run code produced by Compile; no parsing or allocation. Results saturate at the int32 range.
+    KEVESCARDKIT_API int32 Evaluate(TConstArrayView<FCardExprInstr> Code, const FCardValueVars& Vars);
+}
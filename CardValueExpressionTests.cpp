@@ -0,0 +1,118 @@
+// CardValueExpressionTests.cpp - "X" value expressions: parsing, evaluation and overflow behaviour
+#include "CardValueExpression.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace CardValueExpressionTests
+{
+    // Compile Source and evaluate it against Vars, checking the result
+    static void TestValue(FAutomationTestBase& Test, const TCHAR* Source, int32 Expected, const FCardValueVars& Vars = FCardValueVars())
+    {
+        TArray<FCardExprInstr> Code;
+        FString Error;
+        if (!KCKValueExpr::Compile(Source, Code, Error))
+        {
+            Test.AddError(FString::Printf(TEXT("'%s' failed to compile: %s"), Source, *Error));
+            return;
+        }
+        Test.TestEqual(FString::Printf(TEXT("'%s'"), Source), KCKValueExpr::Evaluate(Code, Vars), Expected);
+    }
+
+    // Source must be rejected without appending any code
+    static void TestRejected(FAutomationTestBase& Test, const TCHAR* Source)
+    {
+        TArray<FCardExprInstr> Code;
+        FString Error;
+        const bool bCompiled = KCKValueExpr::Compile(Source, Code, Error);
+        Test.TestFalse(FString::Printf(TEXT("'%s' is rejected"), Source), bCompiled);
+        Test.TestEqual(FString::Printf(TEXT("'%s' appends no code"), Source), Code.Num(), 0);
+        Test.TestFalse(FString::Printf(TEXT("'%s' reports an error"), Source), Error.IsEmpty());
+    }
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCardValueExpressionPrecedenceTest, "KevesCardKit.ValueExpression.Precedence",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+bool FCardValueExpressionPrecedenceTest::RunTest(const FString& Parameters)
+{
+    using namespace CardValueExpressionTests;
+    TestValue(*this, TEXT("2 + 3 * 4"), 14);
+    TestValue(*this, TEXT("2 * 3 + 4"), 10);
+    TestValue(*this, TEXT("10 - 4 - 3"), 3);
+    TestValue(*this, TEXT("100 / 10 / 5"), 2);
+    TestValue(*this, TEXT("7 - 6 / 3"), 5);
+    TestValue(*this, TEXT("(2 + 3) * 4"), 20);
+    TestValue(*this, TEXT("((1 + 2) * (3 + 4))"), 21);
+    TestValue(*this, TEXT("max(1, min(5, 3)) * 2"), 6);
+
+    FCardValueVars Vars;
+    Vars[ECardValueVar::EnergySpent] = 3;
+    Vars[ECardValueVar::OwnCreatures] = 2;
+    TestValue(*this, TEXT("X * 2 + OwnCreatures"), 8, Vars);
+    TestValue(*this, TEXT("x * (2 + ownCreatures)"), 12, Vars);
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCardValueExpressionUnaryTest, "KevesCardKit.ValueExpression.UnaryMinus",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+bool FCardValueExpressionUnaryTest::RunTest(const FString& Parameters)
+{
+    using namespace CardValueExpressionTests;
+    TestValue(*this, TEXT("-5"), -5);
+    TestValue(*this, TEXT("--5"), 5);
+    TestValue(*this, TEXT("+5"), 5);
+    TestValue(*this, TEXT("-2 * 3"), -6);
+    TestValue(*this, TEXT("3 - -2"), 5);
+    TestValue(*this, TEXT("-(2 + 3)"), -5);
+    TestValue(*this, TEXT("min(-1, 1)"), -1);
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCardValueExpressionArithmeticTest, "KevesCardKit.ValueExpression.DivideAndOverflow",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+bool FCardValueExpressionArithmeticTest::RunTest(const FString& Parameters)
+{
+    using namespace CardValueExpressionTests;
+    TestValue(*this, TEXT("5 / 0"), 0);
+    TestValue(*this, TEXT("5 / (3 - 3)"), 0);
+    TestValue(*this, TEXT("7 / 2"), 3);
+    TestValue(*this, TEXT("-7 / 2"), -3);
+
+    // Results saturate at the int32 range instead of wrapping
+    TestValue(*this, TEXT("2147483647 + 1"), MAX_int32);
+    TestValue(*this, TEXT("-2147483647 - 2"), MIN_int32);
+    TestValue(*this, TEXT("65536 * 65536"), MAX_int32);
+    TestValue(*this, TEXT("-65536 * 65536"), MIN_int32);
+
+    // MIN_int32 cannot be written as a literal, so it comes in through a variable
+    FCardValueVars Vars;
+    Vars[ECardValueVar::Energy] = MIN_int32;
+    TestValue(*this, TEXT("Energy / -1"), MAX_int32, Vars);
+    TestValue(*this, TEXT("-Energy"), MAX_int32, Vars);
+    TestValue(*this, TEXT("Energy * -1"), MAX_int32, Vars);
+    TestValue(*this, TEXT("Energy - 1"), MIN_int32, Vars);
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCardValueExpressionMalformedTest, "KevesCardKit.ValueExpression.RejectsMalformed",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+bool FCardValueExpressionMalformedTest::RunTest(const FString& Parameters)
+{
+    using namespace CardValueExpressionTests;
+    TestRejected(*this, TEXT(""));
+    TestRejected(*this, TEXT("1 +"));
+    TestRejected(*this, TEXT("* 2"));
+    TestRejected(*this, TEXT("1 2"));
+    TestRejected(*this, TEXT("(1 + 2"));
+    TestRejected(*this, TEXT("1 + 2)"));
+    TestRejected(*this, TEXT("()"));
+    TestRejected(*this, TEXT("1, 2"));
+    TestRejected(*this, TEXT("min(1)"));
+    TestRejected(*this, TEXT("max(1, 2, 3)"));
+    TestRejected(*this, TEXT("Mana + 1"));
+    TestRejected(*this, TEXT("2147483648"));
+    TestRejected(*this, TEXT("3 % 2"));
+    return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,219 @@
+// CombatEvaluatorModel.cpp - Feature extraction, evaluation and offline training
+#include "CombatEvaluatorModel.h"
+#include "KevesCardKitLog.h"
+#include "CombatManager.h"
+#include "HandManager.h"
+#include "HeadlessCombatSim.h"
+#include "Engine/DataTable.h"
+
+// ==== FEATURES ====
+
+FCombatFeatures FCombatFeatures::Make(
+    int32 PlayerHealth, int32 PlayerMaxHealth, int32 EnemyHealth, int32 EnemyMaxHealth,
+    int32 PlayerCreatures, int32 PlayerFieldAttack, int32 PlayerFieldHealth,
+    int32 EnemyCreatures, int32 EnemyFieldAttack, int32 EnemyFieldHealth,
+    int32 PlayerHandSize, int32 PlayerDeckSize, int32 PlayerDiscardSize,
+    int32 EnemyHandSize, int32 PlayerEnergy, bool bPlayerTurn)
+{
+    FCombatFeatures Features;
+    float* V = Features.Values;
+
+    const float PlayerHealthFraction = PlayerMaxHealth > 0 ? (float)PlayerHealth / PlayerMaxHealth : 0.0f;
+    const float EnemyHealthFraction = EnemyMaxHealth > 0 ? (float)EnemyHealth / EnemyMaxHealth : 0.0f;
+
+    V[0] = PlayerHealthFraction;
+    V[1] = EnemyHealthFraction;
+    V[2] = PlayerCreatures / 6.0f;
+    V[3] = EnemyCreatures / 6.0f;
+    V[4] = PlayerFieldAttack / 10.0f;
+    V[5] = EnemyFieldAttack / 10.0f;
+    V[6] = PlayerFieldHealth / 20.0f;
+    V[7] = EnemyFieldHealth / 20.0f;
+    V[8] = PlayerHandSize / 10.0f;
+    V[9] = PlayerDeckSize / 30.0f;
+    V[10] = PlayerDiscardSize / 30.0f;
+    V[11] = EnemyHandSize / 10.0f;
+    V[12] = PlayerEnergy / 3.0f;
+    V[13] = bPlayerTurn ? 1.0f : 0.0f;
+    V[14] = (PlayerFieldAttack - EnemyFieldAttack) / 10.0f;
+    V[15] = PlayerHealthFraction - EnemyHealthFraction;
+
+    return Features;
+}
+
+FCombatFeatures FCombatFeatures::FromCombat(const ACombatManager& CombatManager)
+{
+    // Dead cards leave the field immediately, so the maintained living totals cover the whole battlefield
+    const FBattlefieldSummary Player = CombatManager.GetBattlefieldSummary(true);
+    const FBattlefieldSummary Enemy = CombatManager.GetBattlefieldSummary(false);
+
+    const AHandManager* HandManager = CombatManager.HandManager;
+    const UEnemyAIComponent* EnemyAI = CombatManager.EnemyAIComponent;
+
+    return Make(
+        CombatManager.PlayerHealth, CombatManager.PlayerMaxHealth,
+        CombatManager.CurrentEnemy.Health, CombatManager.CurrentEnemy.MaxHealth,
+        Player.CardCount, Player.TotalAttack, Player.TotalHealth,
+        Enemy.CardCount, Enemy.TotalAttack, Enemy.TotalHealth,
+        HandManager ? HandManager->GetHandSize() : 0,
+        HandManager ? HandManager->GetDeckSize() : 0,
+        HandManager ? HandManager->GetDiscardPileSize() : 0,
+        EnemyAI ? EnemyAI->GetHandSize() : 0,
+        CombatManager.CurrentEnergy,
+        CombatManager.IsPlayerTurn());
+}
+
+FCombatFeatures FCombatFeatures::FromSim(const FHeadlessCombatState& State)
+{
+    int32 FieldAttack[2] = { 0, 0 };
+    int32 FieldHealth[2] = { 0, 0 };
+    for (int32 SideIndex = 0; SideIndex < 2; SideIndex++)
+    {
+        for (const FSimCreature& Creature : State.Sides[SideIndex].Field)
+        {
+            FieldAttack[SideIndex] += Creature.Attack;
+            FieldHealth[SideIndex] += Creature.Health;
+        }
+    }
+
+    const FSimSide& Player = State.Player();
+    const FSimSide& Enemy = State.Enemy();
+
+    return Make(
+        Player.Health, Player.MaxHealth, Enemy.Health, Enemy.MaxHealth,
+        Player.Field.Num(), FieldAttack[0], FieldHealth[0],
+        Enemy.Field.Num(), FieldAttack[1], FieldHealth[1],
+        Player.Hand.Num(), Player.Deck.Num(), Player.Discard.Num(),
+        Enemy.Hand.Num(), Player.Energy,
+        State.ActiveSide == 0);
+}
+
+// ==== MODEL ====
+
+void UCombatEvaluatorModel::PostLoad()
+{
+    Super::PostLoad();
+    RefreshRuntimeWeights();
+}
+
+#if WITH_EDITOR
+void UCombatEvaluatorModel::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+    Super::PostEditChangeProperty(PropertyChangedEvent);
+    RefreshRuntimeWeights();
+}
+#endif
+
+void UCombatEvaluatorModel::RefreshRuntimeWeights()
+{
+    for (int32 i = 0; i < FCombatFeatures::Num; i++)
+    {
+        RuntimeWeights[i] = Weights.IsValidIndex(i) ? Weights[i] : 0.0f;
+    }
+    RuntimeBias = Bias;
+}
+
+void UCombatEvaluatorModel::Train()
+{
+    if (!CardDataTable || PlayerDeckCardIDs.Num() == 0 || EnemyDeckCardIDs.Num() == 0)
+    {
+        UE_LOG(LogKevesCardKitAI, Warning, TEXT("[Evaluator] %s: CardDataTable and both decks are required to train"), *GetName());
+        return;
+    }
+
+    const double StartTime = FPlatformTime::Seconds();
+
+    FHeadlessCombatSim Sim(CardDataTable);
+    FRandomStream Random(RandomSeed);
+
+    // Collect (features, outcome) pairs from random playouts, one sample per half-turn
+    TArray<FCombatFeatures> Samples;
+    TArray<float> Labels;
+    TArray<FCombatFeatures> GameSamples;
+
+    FHeadlessCombatState State;
+    for (int32 Game = 0; Game < NumTrainingCombats; Game++)
+    {
+        GameSamples.Reset();
+        Sim.StartCombat(State, PlayerDeckCardIDs, EnemyDeckCardIDs, PlayerHealth, EnemyHealth, Random);
+
+        while (Sim.GetWinner(State) == 0 && State.Turn < 40)
+        {
+            GameSamples.Add(FCombatFeatures::FromSim(State));
+            Sim.PlayRandomTurn(State, Random);
+        }
+
+        const int32 Winner = Sim.GetWinner(State);
+        if (Winner == 0)
+        {
+            continue; // Unresolved games carry no label
+        }
+
+        Samples.Append(GameSamples);
+        Labels.AddUninitialized(GameSamples.Num());
+        for (int32 i = Labels.Num() - GameSamples.Num(); i < Labels.Num(); i++)
+        {
+            Labels[i] = Winner > 0 ? 1.0f : 0.0f;
+        }
+    }
+
+    if (Samples.Num() == 0)
+    {
+        UE_LOG(LogKevesCardKitAI, Warning, TEXT("[Evaluator] %s: no decided games to train on"), *GetName());
+        return;
+    }
+
+    // Logistic regression with plain SGD over shuffled samples
+    float W[FCombatFeatures::Num] = {};
+    float B = 0.0f;
+
+    TArray<int32> Order;
+    Order.SetNumUninitialized(Samples.Num());
+    for (int32 i = 0; i < Order.Num(); i++)
+    {
+        Order[i] = i;
+    }
+
+    double LogLoss = 0.0;
+    for (int32 Epoch = 0; Epoch < NumEpochs; Epoch++)
+    {
+        for (int32 i = Order.Num() - 1; i > 0; i--)
+        {
+            Order.Swap(i, Random.RandRange(0, i));
+        }
+
+        LogLoss = 0.0;
+        for (int32 SampleIndex : Order)
+        {
+            const float* X = Samples[SampleIndex].Values;
+            float Sum = B;
+            for (int32 f = 0; f < FCombatFeatures::Num; f++)
+            {
+                Sum += W[f] * X[f];
+            }
+
+            const float Prediction = 1.0f / (1.0f + FMath::Exp(-Sum));
+            const float Error = Prediction - Labels[SampleIndex];
+            for (int32 f = 0; f < FCombatFeatures::Num; f++)
+            {
+                W[f] -= LearningRate * Error * X[f];
+            }
+            B -= LearningRate * Error;
+
+            const float Clamped = FMath::Clamp(Prediction, 1e-6f, 1.0f - 1e-6f);
+            LogLoss -= Labels[SampleIndex] > 0.5f ? FMath::Loge(Clamped) : FMath::Loge(1.0f - Clamped);
+        }
+    }
+
+    Weights.SetNumUninitialized(FCombatFeatures::Num);
+    for (int32 f = 0; f < FCombatFeatures::Num; f++)
+    {
+        Weights[f] = W[f];
+    }
+    Bias = B;
+    RefreshRuntimeWeights();
+    MarkPackageDirty();
+
+    UE_LOG(LogKevesCardKitAI, Display, TEXT("[Evaluator] %s: trained on %d samples, final log loss %.4f (%.2fs)"),
+        *GetName(), Samples.Num(), LogLoss / Samples.Num(), FPlatformTime::Seconds() - StartTime);
+}
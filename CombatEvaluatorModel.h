@@ -0,0 +1,110 @@
+// CombatEvaluatorModel.h - Fast linear win-probability estimator for combat states
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "CombatEvaluatorModel.generated.h"
+
+class ACombatManager;
+class UDataTable;
+struct FHeadlessCombatState;
+
+/**
+ * Fixed-size, normalized feature vector describing a combat state from the player's side.
+ * Layout is contiguous and 16-byte aligned so the dot product vectorizes.
+ */
+struct KEVESCARDKIT_API FCombatFeatures
+{
+    static constexpr int32 Num = 16;
+
+    alignas(16) float Values[Num] = {};
+
+    // Build from the live combat (game thread)
+    static FCombatFeatures FromCombat(const ACombatManager& CombatManager);
+
+    // Build from a headless simulation state (any thread)
+    static FCombatFeatures FromSim(const FHeadlessCombatState& State);
+
+    // Shared builder so runtime and training features can never drift apart
+    static FCombatFeatures Make(
+        int32 PlayerHealth, int32 PlayerMaxHealth, int32 EnemyHealth, int32 EnemyMaxHealth,
+        int32 PlayerCreatures, int32 PlayerFieldAttack, int32 PlayerFieldHealth,
+        int32 EnemyCreatures, int32 EnemyFieldAttack, int32 EnemyFieldHealth,
+        int32 PlayerHandSize, int32 PlayerDeckSize, int32 PlayerDiscardSize,
+        int32 EnemyHandSize, int32 PlayerEnergy, bool bPlayerTurn);
+};
+
+UCLASS(BlueprintType)
+class KEVESCARDKIT_API UCombatEvaluatorModel : public UDataAsset
+{
+    GENERATED_BODY()
+
+public:
+    // === MODEL ===
+
+    // One weight per FCombatFeatures entry
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Model")
+    TArray<float> Weights;
+
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Model")
+    float Bias = 0.0f;
+
+    // === TRAINING SETTINGS ===
+
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Model|Training")
+    UDataTable* CardDataTable = nullptr;
+
+    // The one matchup every training game plays; only the shuffles and the random turns differ between games
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Model|Training")
+    TArray<int32> PlayerDeckCardIDs;
+
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Model|Training")
+    TArray<int32> EnemyDeckCardIDs;
+
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Model|Training")
+    int32 PlayerHealth = 20;
+
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Model|Training")
+    int32 EnemyHealth = 100;
+
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Model|Training")
+    int32 NumTrainingCombats = 2000;
+
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Model|Training")
+    int32 NumEpochs = 20;
+
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Model|Training")
+    float LearningRate = 0.05f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Model|Training")
+    int32 RandomSeed = 7;
+
+    // === FUNCTIONS ===
+
+    // Player win probability in [0, 1]. A 16-wide dot product and a sigmoid, no allocations.
+    float Evaluate(const FCombatFeatures& Features) const
+    {
+        float Sum = RuntimeBias;
+        for (int32 i = 0; i < FCombatFeatures::Num; i++)
+        {
+            Sum += RuntimeWeights[i] * Features.Values[i];
+        }
+        return 1.0f / (1.0f + FMath::Exp(-Sum));
+    }
+
+    // Fit the weights with logistic regression on headless simulation outcomes
+    UFUNCTION(BlueprintCallable, Category = "Model", CallInEditor)
+    void Train();
+
+    virtual void PostLoad() override;
+#if WITH_EDITOR
+    virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+
+private:
+    // Copy of Weights in a fixed aligned block so Evaluate never touches TArray bounds checks
+    void RefreshRuntimeWeights();
+
+    alignas(16) float RuntimeWeights[FCombatFeatures::Num] = {};
+    float RuntimeBias = 0.0f;
+};
@@ -0,0 +1,155 @@
+// CombatJournal.cpp - Combat action journal file
+#include "CombatJournal.h"
+#include "KevesCardKitLog.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformFileManager.h"
+#include "GenericPlatform/GenericPlatformFile.h"
+#include "Misc/Crc.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+namespace
+{
+    // "KCKJ", little-endian
+    static constexpr uint32 JournalMagic = 0x4A4B434B;
+    static constexpr uint16 JournalVersion = 1;
+
+    // Followed by RunBytes of KCKRunSave data, then the records
+    struct FJournalHeader
+    {
+        uint32 Magic = JournalMagic;
+        uint16 Version = JournalVersion;
+        uint16 RecordSize = sizeof(FCombatJournalRecord);
+        uint32 EnemyKey = 0;
+        uint32 RunBytes = 0;
+    };
+
+    static_assert(sizeof(FCombatJournalRecord) == 16, "Journal records are written as raw 16-byte entries");
+    static_assert(STRUCT_OFFSET(FCombatJournalRecord, Check) == 12, "Check must follow the checked fields");
+}
+
+FCombatJournal::~FCombatJournal()
+{
+    Close();
+}
+
+FString FCombatJournal::GetPath(const FString& InSlotName)
+{
+    return FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("SaveGames"), InSlotName + TEXT(".kckjournal"));
+}
+
+bool FCombatJournal::Begin(const FString& InSlotName, const FRunState& Run, uint32 EnemyKey)
+{
+    Close();
+
+    TArray<uint8> RunBytes;
+    KCKRunSave::Serialize(Run, RunBytes);
+
+    FJournalHeader Header;
+    Header.EnemyKey = EnemyKey;
+    Header.RunBytes = RunBytes.Num();
+
+    const FString Path = GetPath(InSlotName);
+    IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+    PlatformFile.CreateDirectoryTree(*FPaths::GetPath(Path));
+
+    File.Reset(PlatformFile.OpenWrite(*Path));
+    if (!File.IsValid()
+        || !File->Write(reinterpret_cast<const uint8*>(&Header), sizeof(FJournalHeader))
+        || !File->Write(RunBytes.GetData(), RunBytes.Num()))
+    {
+        UE_LOG(LogKevesCardKit, Warning, TEXT("[CombatJournal] Could not start %s; this combat will not be journaled"), *Path);
+        File.Reset();
+        return false;
+    }
+
+    SlotName = InSlotName;
+    NumRecords = 0;
+    return true;
+}
+
+void FCombatJournal::Append(ECombatJournalAction Action, int32 HandIndex, int32 CardID, ECombatJournalTarget TargetKind, int32 TargetSlot)
+{
+    if (!File.IsValid())
+    {
+        return;
+    }
+
+    FCombatJournalRecord Record;
+    Record.Action = Action;
+    Record.TargetKind = TargetKind;
+    Record.TargetSlot = (uint16)FMath::Clamp(TargetSlot, 0, (int32)MAX_uint16);
+    Record.HandIndex = HandIndex;
+    Record.CardID = CardID;
+    Record.Check = ComputeCheck(Record, NumRecords);
+
+    if (!File->Write(reinterpret_cast<const uint8*>(&Record), sizeof(FCombatJournalRecord)))
+    {
+        UE_LOG(LogKevesCardKit, Warning, TEXT("[CombatJournal] Write failed; journaling stopped for this combat"));
+        File.Reset();
+        return;
+    }
+    NumRecords++;
+}
+
+void FCombatJournal::Close()
+{
+    File.Reset();
+}
+
+bool FCombatJournal::Read(const FString& InSlotName, FRunState& OutRun, uint32& OutEnemyKey, TArray<FCombatJournalRecord>& OutRecords)
+{
+    TArray<uint8> Bytes;
+    if (!FFileHelper::LoadFileToArray(Bytes, *GetPath(InSlotName), FILEREAD_Silent) || Bytes.Num() < (int32)sizeof(FJournalHeader))
+    {
+        return false;
+    }
+
+    FJournalHeader Header;
+    FMemory::Memcpy(&Header, Bytes.GetData(), sizeof(FJournalHeader));
+    const int64 RecordsOffset = (int64)sizeof(FJournalHeader) + Header.RunBytes;
+    if (Header.Magic != JournalMagic || Header.Version != JournalVersion || Header.RecordSize != sizeof(FCombatJournalRecord)
+        || RecordsOffset > Bytes.Num())
+    {
+        return false;
+    }
+
+    FRunState Run;
+    if (!KCKRunSave::Deserialize(TConstArrayView<uint8>(Bytes.GetData() + sizeof(FJournalHeader), Header.RunBytes), Run))
+    {
+        return false;
+    }
+
+    // Stop at the first record that is incomplete or fails its check (the write the crash interrupted)
+    OutRecords.Reset();
+    const int32 NumWhole = (int32)((Bytes.Num() - RecordsOffset) / sizeof(FCombatJournalRecord));
+    for (int32 Index = 0; Index < NumWhole; Index++)
+    {
+        FCombatJournalRecord Record;
+        FMemory::Memcpy(&Record, Bytes.GetData() + RecordsOffset + (int64)Index * sizeof(FCombatJournalRecord), sizeof(FCombatJournalRecord));
+        if (Record.Check != ComputeCheck(Record, Index))
+        {
+            break;
+        }
+        OutRecords.Add(Record);
+    }
+
+    OutRun = MoveTemp(Run);
+    OutEnemyKey = Header.EnemyKey;
+    return true;
+}
+
+void FCombatJournal::Delete(const FString& InSlotName)
+{
+    IFileManager::Get().Delete(*GetPath(InSlotName), false, false, true);
+}
+
+uint32 FCombatJournal::MakeEnemyKey(TConstArrayView<int32> EnemyDeckCardIDs, int32 EnemyMaxHealth)
+{
+    return FCrc::MemCrc32(EnemyDeckCardIDs.GetData(), EnemyDeckCardIDs.Num() * sizeof(int32), (uint32)EnemyMaxHealth);
+}
+
+uint32 FCombatJournal::ComputeCheck(const FCombatJournalRecord& Record, int32 Position)
+{
+    return FCrc::MemCrc32(&Record, STRUCT_OFFSET(FCombatJournalRecord, Check), (uint32)Position);
+}
@@ -0,0 +1,83 @@
+// CombatJournal.h - Write-ahead journal of combat actions for crash recovery
+#pragma once
+
+#include "CoreMinimal.h"
+#include "RunSave.h"
+
+class IFileHandle;
+
+enum class ECombatJournalAction : uint8
+{
+    PlayerCard,         // HandIndex, CardID, target
+    PlayerTurnEnded,
+    EnemyCard,          // HandIndex, CardID
+    EnemyTurnEnded,
+};
+
+// Chosen target of a player card, by battlefield slot (UniqueIDs are not stable across sessions)
+enum class ECombatJournalTarget : uint8
+{
+    None,
+    PlayerCreature,
+    EnemyCreature,
+    EnemyHero,
+};
+
+// One action; fixed 16 bytes so an append is a single small write
+struct FCombatJournalRecord
+{
+    ECombatJournalAction Action = ECombatJournalAction::PlayerCard;
+    ECombatJournalTarget TargetKind = ECombatJournalTarget::None;
+    uint16 TargetSlot = 0;
+    int32 HandIndex = INDEX_NONE;
+    int32 CardID = 0;
+
+    // Checksum of the fields above and the record's position; a torn or stale tail fails it
+    uint32 Check = 0;
+};
+
+/**
+ * Journal of the combat in progress, next to the run save of the same slot. It starts with the run as it
+ * was when the combat began (the combat's seed derives from it), followed by one record per action,
+ * written before the action is applied. Since every random draw in combat comes from the seeded stream,
+ * replaying the records on a fresh StartRunCombat reproduces the state at the last action.
+ *
+ * Appends go straight to the open file handle without a flush: they cost a few microseconds and
+ * survive the game crashing, though not the machine losing power. The journal is compacted into the
+ * run save when the combat ends (see ACombatManager::EndCombat).
+ */
+class KEVESCARDKIT_API FCombatJournal
+{
+public:
+    ~FCombatJournal();
+
+    static FString GetPath(const FString& InSlotName);
+
+    // Truncate the slot's journal and write its header
+    bool Begin(const FString& InSlotName, const FRunState& Run, uint32 EnemyKey);
+
+    void Append(ECombatJournalAction Action, int32 HandIndex = INDEX_NONE, int32 CardID = 0,
+        ECombatJournalTarget TargetKind = ECombatJournalTarget::None, int32 TargetSlot = 0);
+
+    // Stop journaling; the file stays until Delete
+    void Close();
+
+    bool IsOpen() const { return File.IsValid(); }
+
+    const FString& GetSlotName() const { return SlotName; }
+
+    // Read a journal: the run it started from, its enemy key and every intact record. False if there is none.
+    static bool Read(const FString& InSlotName, FRunState& OutRun, uint32& OutEnemyKey, TArray<FCombatJournalRecord>& OutRecords);
+
+    static void Delete(const FString& InSlotName);
+
+    // Identifies the encounter, so a journal is never replayed against a different enemy
+    static uint32 MakeEnemyKey(TConstArrayView<int32> EnemyDeckCardIDs, int32 EnemyMaxHealth);
+
+private:
+    static uint32 ComputeCheck(const FCombatJournalRecord& Record, int32 Position);
+
+    TUniquePtr<IFileHandle> File;
+    FString SlotName;
+    int32 NumRecords = 0;
+};
@@ -1,10 +1,19 @@
 #include "CombatManager.h"
+#include "KevesCardKitLog.h"
+#include "KevesCardKitTrace.h"
+#include "KevesCardKitMemory.h"
 #include "HandManager.h"
 #include "Blueprint/UserWidget.h"
 #include "CombatUIWidget.h"
 #include "PaperCharacter.h"
 #include "Engine/World.h"
 #include "TimerManager.h"
+#include "CombatEvaluatorModel.h"
+#include "CombatSequencer.h"
+#include "CardCatalog.h"
+#include "CardAbilityInterpreter.h"
+#include "BattlefieldCardActor.h"
+#include "EngineUtils.h"
 
 // Initialize static variable
 int32 ACombatManager::NextUniqueCardID = 0;
@@ -21,6 +30,8 @@ ACombatManager::ACombatManager()
     CurrentEnergy = 3;
     MaxEnergyPerTurn = 3;
     PlayerFaction = ECardFaction::Demon;
+
+    CombatSequencer = CreateDefaultSubobject<UCombatSequencer>(TEXT("CombatSequencer"));
 }
 
 void ACombatManager::BeginPlay()
@@ -41,18 +52,30 @@ void ACombatManager::SetCombatUI(UUserWidget* InCombatUI)
     }
     else
     {
-        UE_LOG(LogTemp, Warning, TEXT("[CombatManager] CombatUI set but HandManager is missing, will bind later"));
+        UE_LOG(LogKevesCardKitCombat, Warning, TEXT("[CombatManager] CombatUI set but HandManager is missing, will bind later"));
     }
 }
 
 void ACombatManager::StartCombat(const FEnemyData& Enemy, const TArray<int32>& PlayerDeckIDs)
 {
+    KCK_TRACE_SCOPE(KCK_StartCombat);
+
     if (!HandManager)
     {
-        UE_LOG(LogTemp, Error, TEXT("[CombatManager] No HandManager assigned!"));
+        UE_LOG(LogKevesCardKitCombat, Error, TEXT("[CombatManager] No HandManager assigned!"));
         return;
     }
 
+    // A plain StartCombat is not part of a journaled run
+    if (!PendingRunDeck)
+    {
+        CombatJournal.Close();
+    }
+
+    // Seed before anything shuffles
+    ActiveCombatSeed = (CombatSeed != 0) ? CombatSeed : FMath::RandRange(1, MAX_int32);
+    CombatRandom.Initialize(ActiveCombatSeed);
+
     CurrentEnemy = Enemy;
 
     // Store a reference to enemy actor
@@ -66,6 +89,11 @@ void ACombatManager::StartCombat(const FEnemyData& Enemy, const TArray<int32>& P
         {
             EnemyAIComponent = FoundEnemyAIComp;
             EnemyAIComponent->SetCombatManager(this);
+            if (Enemy.PolicyTable)
+            {
+                EnemyAIComponent->PolicyTable = Enemy.PolicyTable;
+                EnemyAIComponent->AIMode = EEnemyAIMode::PolicyTable;
+            }
             EnemyAIComponent->InitializeEnemyAI(Enemy.EnemyDeckCardIDs);
             EnemyAIComponent->ResetEnergy();
             EnemyAIComponent->OnEnemyHealthChanged.AddDynamic(this, &ACombatManager::HandleEnemyHealthChanged);
@@ -73,24 +101,39 @@ void ACombatManager::StartCombat(const FEnemyData& Enemy, const TArray<int32>& P
         }
         else
         {
-            UE_LOG(LogTemp, Warning, TEXT("[CombatManager] EnemyAIComponent not found on enemy actor %s"), *EnemyActor->GetName());
+            UE_LOG(LogKevesCardKitCombat, Warning, TEXT("[CombatManager] EnemyAIComponent not found on enemy actor %s"), *EnemyActor->GetName());
             return;
         }
     }
     else
     {
-        UE_LOG(LogTemp, Warning, TEXT("[CombatManager] EnemyActor reference is null."));
+        UE_LOG(LogKevesCardKitCombat, Warning, TEXT("[CombatManager] EnemyActor reference is null."));
         return;
     }
 
+    if (bRecordCombatMetrics)
+    {
+        MetricsRecorder.BeginCombat(CurrentEnemy.Name.ToString());
+        HandManager->ResetPilePeaks();
+    }
+    KCKMemory::ResetHighWater();
+
     // Clear battlefields
     PlayerBattlefield.Empty();
     EnemyBattlefield.Empty();
+    TriggerRegistry.Reset();
+    StatusEffects.Reset();
+    ModifierLayers.Reset();
+    CopiesPlayedThisTurn[0].Reset();
+    CopiesPlayedThisTurn[1].Reset();
+    RebuildBattlefieldLookup();
+    EmitBattlefieldDelta(EBattlefieldDeltaType::Cleared, FBattlefieldCard(), INDEX_NONE, true);
+    EmitBattlefieldDelta(EBattlefieldDeltaType::Cleared, FBattlefieldCard(), INDEX_NONE, false);
 
     // Ensure we have an existing CombatUI
     if (!CombatUI)
     {
-        UE_LOG(LogTemp, Warning, TEXT("[CombatManager] No existing CombatUI widget found! UI will not update."));
+        UE_LOG(LogKevesCardKitCombat, Warning, TEXT("[CombatManager] No existing CombatUI widget found! UI will not update."));
     }
     else
     {
@@ -101,17 +144,24 @@ void ACombatManager::StartCombat(const FEnemyData& Enemy, const TArray<int32>& P
         }
         else
         {
-            UE_LOG(LogTemp, Warning, TEXT("[CombatManager] CombatUI is not of type UCombatUIWidget."));
+            UE_LOG(LogKevesCardKitCombat, Warning, TEXT("[CombatManager] CombatUI is not of type UCombatUIWidget."));
         }
     }
 
+    // Set up cross-references between managers (before the draw, so the hand registers with ModifierLayers)
+    HandManager->SetCombatManager(this);
+
     // Set up player deck and draw starting hand (now UI is already listening if it exists)
-    HandManager->SetPlayerDeck(PlayerDeckIDs);
+    if (PendingRunDeck)
+    {
+        HandManager->SetPlayerRunDeck(*PendingRunDeck);
+    }
+    else
+    {
+        HandManager->SetPlayerDeck(PlayerDeckIDs);
+    }
     HandManager->DrawStartingHand();
 
-    // Set up cross-references between managers
-    HandManager->SetCombatManager(this);
-
     // Bind to hand manager events
     if (!HandManager->OnCardPlayed.IsBound())
     {
@@ -119,27 +169,290 @@ void ACombatManager::StartCombat(const FEnemyData& Enemy, const TArray<int32>& P
     }
 
     // Set starting energy based on faction
-    CurrentEnergy = MaxEnergyPerTurn;
+    ApplyEnergyChange(MaxEnergyPerTurn);
+
+    // Hash the fresh combat state so later changes can be applied incrementally
+    RebuildCombatStateHash();
+
+    // Max health is not hashed, so evaluations from another combat must not be reused
+    if (TranspositionCache.IsValid())
+    {
+        TranspositionCache->Clear();
+    }
 
     // Start combat in "Starting" phase
     SetCombatState(ECombatState::Starting);
 
-    // Brief delay then start player turn
-    FTimerHandle DelayTimer;
-    GetWorld()->GetTimerManager().SetTimer(DelayTimer, [this]()
+    // Start player turn once the intro presentation has finished
+    CombatSequencer->CancelAll();
+    CombatSequencer->RunAfterPresentation(TEXT("StartPlayerTurn"),
+        FSimpleDelegate::CreateUObject(this, &ACombatManager::SetCombatState, ECombatState::PlayerTurn));
+
+    UE_LOG(LogKevesCardKitCombat, Log, TEXT("[CombatManager] Combat started against %s"), *CurrentEnemy.Name.ToString());
+}
+
+void ACombatManager::StartRunCombat(const FEnemyData& Enemy, FRunState& Run)
+{
+    // The journal starts from the run before this encounter's seed is drawn, so a replay draws the same seed
+    const bool bJournaled = !CombatJournalSlot.IsEmpty()
+        && CombatJournal.Begin(CombatJournalSlot, Run, FCombatJournal::MakeEnemyKey(Enemy.EnemyDeckCardIDs, Enemy.MaxHealth));
+
+    PlayerMaxHealth = Run.PlayerMaxHealth;
+    PlayerHealth = FMath::Clamp(Run.PlayerHealth, 0, PlayerMaxHealth);
+    OnHealthChanged.Broadcast(true, PlayerHealth);
+
+    {
+        TGuardValue<int32> SeedGuard(CombatSeed, Run.NextEncounterSeed());
+        TGuardValue<const TArray<FRunDeckCard>*> DeckGuard(PendingRunDeck, &Run.Deck);
+        StartCombat(Enemy, TArray<int32>());
+    }
+
+    if (bJournaled)
+    {
+        if (CurrentState == ECombatState::Starting)
+        {
+            JournalRun = Run;
+        }
+        else
+        {
+            // StartCombat bailed out; there is no combat to recover
+            CombatJournal.Close();
+            FCombatJournal::Delete(CombatJournalSlot);
+        }
+    }
+}
+
+bool ACombatManager::FindUnfinishedRunCombat(FRunState& OutRun) const
+{
+    uint32 EnemyKey = 0;
+    TArray<FCombatJournalRecord> Records;
+    return !CombatJournalSlot.IsEmpty() && FCombatJournal::Read(CombatJournalSlot, OutRun, EnemyKey, Records);
+}
+
+bool ACombatManager::ResumeRunCombat(const FEnemyData& Enemy, FRunState& OutRun)
+{
+    FRunState Run;
+    uint32 EnemyKey = 0;
+    TArray<FCombatJournalRecord> Records;
+    if (CombatJournalSlot.IsEmpty() || !FCombatJournal::Read(CombatJournalSlot, Run, EnemyKey, Records))
+    {
+        return false;
+    }
+
+    if (EnemyKey != FCombatJournal::MakeEnemyKey(Enemy.EnemyDeckCardIDs, Enemy.MaxHealth))
+    {
+        UE_LOG(LogKevesCardKitCombat, Warning, TEXT("[CombatManager] Combat journal is for a different enemy than %s; not resuming"),
+            *Enemy.Name.ToString());
+        return false;
+    }
+
+    // Starts a fresh journal; the replayed actions are written to it again as they are applied
+    StartRunCombat(Enemy, Run);
+    if (CurrentState != ECombatState::Starting)
+    {
+        return false;
+    }
+
+    ReplayCombatJournal(Records);
+    OutRun = Run;
+    return true;
+}
+
+void ACombatManager::RecordCombatAction(ECombatJournalAction Action, int32 HandIndex, int32 CardID, AActor* Target)
+{
+    if (!CombatJournal.IsOpen())
+    {
+        return;
+    }
+
+    ECombatJournalTarget TargetKind = ECombatJournalTarget::None;
+    int32 TargetSlot = 0;
+    if (Target && Target == EnemyActor)
+    {
+        TargetKind = ECombatJournalTarget::EnemyHero;
+    }
+    else if (const ABattlefieldCardActor* Creature = Cast<ABattlefieldCardActor>(Target))
+    {
+        bool bPlayerSide = true;
+        if (FindBattlefieldCard(Creature->GetUniqueID(), &bPlayerSide))
+        {
+            TargetKind = bPlayerSide ? ECombatJournalTarget::PlayerCreature : ECombatJournalTarget::EnemyCreature;
+            TargetSlot = FindBattlefieldIndexByUniqueID(Creature->GetUniqueID(), bPlayerSide);
+        }
+    }
+
+    CombatJournal.Append(Action, HandIndex, CardID, TargetKind, TargetSlot);
+}
+
+AActor* ACombatManager::ResolveJournalTarget(const FCombatJournalRecord& Record) const
+{
+    if (Record.TargetKind == ECombatJournalTarget::EnemyHero)
+    {
+        return EnemyActor;
+    }
+    if (Record.TargetKind == ECombatJournalTarget::None || !GetWorld())
+    {
+        return nullptr;
+    }
+
+    const int32 UniqueID = GetBattlefieldUniqueIDAt(Record.TargetSlot, Record.TargetKind == ECombatJournalTarget::PlayerCreature);
+    for (TActorIterator<ABattlefieldCardActor> It(GetWorld()); It && UniqueID != -1; ++It)
+    {
+        if (It->GetUniqueID() == UniqueID)
+        {
+            return *It;
+        }
+    }
+
+    UE_LOG(LogKevesCardKitCombat, Warning, TEXT("[CombatManager] Journal replay: no actor for target slot %d"), Record.TargetSlot);
+    return nullptr;
+}
+
+void ACombatManager::ReplayCombatJournal(TConstArrayView<FCombatJournalRecord> Records)
+{
+    if (Records.Num() == 0)
+    {
+        return; // Crashed during the intro; the turn start StartCombat queued still stands
+    }
+
+    const double StartSeconds = FPlatformTime::Seconds();
+
+    // Actions are applied back to back; nothing queued behind presentation may run in between
+    CombatSequencer->CancelAll();
+    SetCombatState(ECombatState::PlayerTurn);
+
+    int32 NumReplayed = 0;
+    for (const FCombatJournalRecord& Record : Records)
+    {
+        if (!IsCombatActive())
+        {
+            break;
+        }
+
+        bool bApplied = false;
+        switch (Record.Action)
         {
-            SetCombatState(ECombatState::PlayerTurn);
-        }, 1.0f, false);
+        case ECombatJournalAction::PlayerCard:
+        {
+            const FCardData* Card = HandManager->FindCardInHand(Record.HandIndex);
+            bApplied = CurrentState == ECombatState::PlayerTurn && Card && Card->ID == Record.CardID
+                && HandManager->PlayCard(Record.HandIndex, ResolveJournalTarget(Record));
+            break;
+        }
+        case ECombatJournalAction::PlayerTurnEnded:
+            bApplied = CurrentState == ECombatState::PlayerTurn;
+            if (bApplied)
+            {
+                EndPlayerTurn();
+                CombatSequencer->CancelAll();
+                if (EnemyAIComponent)
+                {
+                    EnemyAIComponent->OnEnemyAITurnEnded.RemoveDynamic(this, &ACombatManager::OnEnemyTurnComplete);
+                    EnemyAIComponent->OnEnemyAITurnEnded.AddDynamic(this, &ACombatManager::OnEnemyTurnComplete);
+                    EnemyAIComponent->BeginTurnWithoutSteps();
+                }
+                else
+                {
+                    ProcessEnemyTurn();
+                }
+            }
+            break;
+        case ECombatJournalAction::EnemyCard:
+            bApplied = CurrentState == ECombatState::EnemyTurn && EnemyAIComponent
+                && EnemyAIComponent->GetCardInHand(Record.HandIndex).ID == Record.CardID;
+            if (bApplied)
+            {
+                // Journaled before the play, so it may have failed the first time too
+                EnemyAIComponent->TryPlayCard(Record.HandIndex);
+            }
+            break;
+        case ECombatJournalAction::EnemyTurnEnded:
+            bApplied = CurrentState == ECombatState::EnemyTurn && EnemyAIComponent;
+            if (bApplied)
+            {
+                EnemyAIComponent->ReplayEndTurn();
+            }
+            break;
+        }
+
+        if (!bApplied)
+        {
+            UE_LOG(LogKevesCardKitCombat, Warning, TEXT("[CombatManager] Journal replay diverged at action %d of %d; resuming from there"),
+                NumReplayed, Records.Num());
+            break;
+        }
+        NumReplayed++;
+    }
+
+    // The journal may stop partway through the enemy's turn
+    if (CurrentState == ECombatState::EnemyTurn && EnemyAIComponent && EnemyAIComponent->IsEnemyTurnActive())
+    {
+        EnemyAIComponent->ResumeTurnSteps();
+    }
+
+    UE_LOG(LogKevesCardKitCombat, Log, TEXT("[CombatManager] Replayed %d journaled actions in %.2f ms"),
+        NumReplayed, (FPlatformTime::Seconds() - StartSeconds) * 1000.0);
+}
+
+void ACombatManager::CompactCombatJournal()
+{
+    const FString SlotName = CombatJournal.GetSlotName();
+    CombatJournal.Close();
+
+    WriteRunState(JournalRun);
+    TWeakObjectPtr<ACombatManager> WeakThis(this);
+    KCKRunSave::SaveAsync(JournalRun, SlotName, [WeakThis, SlotName](bool bSaved)
+    {
+        // A combat started since then has already begun a new journal in the same file
+        const bool bNewCombat = WeakThis.IsValid() && WeakThis->CombatJournal.IsOpen();
+        if (bSaved && !bNewCombat)
+        {
+            FCombatJournal::Delete(SlotName);
+        }
+    });
+}
 
-    UE_LOG(LogTemp, Log, TEXT("[CombatManager] Combat started against %s"), *CurrentEnemy.Name.ToString());
+void ACombatManager::WriteRunState(FRunState& Run) const
+{
+    Run.PlayerHealth = PlayerHealth;
+    Run.PlayerMaxHealth = PlayerMaxHealth;
 }
 
 void ACombatManager::EndCombat(bool bPlayerWon)
 {
     SetCombatState(bPlayerWon ? ECombatState::Victory : ECombatState::Defeat);
 
+    if (CombatJournal.IsOpen())
+    {
+        CompactCombatJournal();
+    }
+
+    if (MetricsRecorder.IsRecording())
+    {
+        if (HandManager)
+        {
+            MetricsRecorder.NotePileSizes(HandManager->GetPeakHandSize(), HandManager->GetPeakDeckSize(), HandManager->GetPeakDiscardSize());
+        }
+        MetricsRecorder.NoteMemoryHighWater(KCKMemory::GetHighWater());
+
+        const FCombatMetricsReport& Report = MetricsRecorder.EndCombat(bPlayerWon);
+        if (bWriteCombatMetricsFile)
+        {
+            FCombatMetricsRecorder::WriteReportFile(Report);
+        }
+    }
+
+    // Drop any pending turn steps; nothing should advance a finished combat
+    CombatSequencer->CancelAll();
+
     PlayerBattlefield.Empty();
     EnemyBattlefield.Empty();
+    TriggerRegistry.Reset();
+    StatusEffects.Reset();
+    ModifierLayers.Reset();
+    RebuildBattlefieldLookup();
+    EmitBattlefieldDelta(EBattlefieldDeltaType::Cleared, FBattlefieldCard(), INDEX_NONE, true);
+    EmitBattlefieldDelta(EBattlefieldDeltaType::Cleared, FBattlefieldCard(), INDEX_NONE, false);
 
     if (CombatUI)
     {
@@ -151,12 +464,23 @@ void ACombatManager::EndCombat(bool bPlayerWon)
     {
         HandManager->ClearHand();
         HandManager->ClearDiscardPile();
+
+        // Return banished cards to player collection/deck here
+        HandManager->BanishedCardIDs.Empty();
+        HandManager->RebuildPileHash();
     }
 
-    // Return banished cards to player collection/deck here
-    HandManager->BanishedCardIDs.Empty();
+    RebuildCombatStateHash();
+
+    LastCombatMemoryHighWater = KCKMemory::GetHighWater();
+    UE_LOG(LogKevesCardKitCombat, Log, TEXT("[CombatManager] Combat ended - Player %s (card kit memory high-water %.1f KB)"),
+        bPlayerWon ? TEXT("Won") : TEXT("Lost"), LastCombatMemoryHighWater.TotalBytes / 1024.0);
+}
 
-    UE_LOG(LogTemp, Log, TEXT("[CombatManager] Combat ended - Player %s"), bPlayerWon ? TEXT("Won") : TEXT("Lost"));
+FCardKitMemoryReport ACombatManager::GetCombatMemoryHighWater() const
+{
+    const bool bInCombat = CurrentState == ECombatState::Starting || IsCombatActive();
+    return bInCombat ? KCKMemory::GetHighWater() : LastCombatMemoryHighWater;
 }
 
 
@@ -167,6 +491,8 @@ void ACombatManager::EndPlayerTurn()
         return;
     }
 
+    RecordCombatAction(ECombatJournalAction::PlayerTurnEnded);
+
     // According to your rules: "When you end your turn, you discard all cards in your hand"
     if (HandManager)
     {
@@ -181,23 +507,25 @@ void ACombatManager::EndPlayerTurn()
         }
         else
         {
-            UE_LOG(LogTemp, Warning, TEXT("[CombatManager] Cannot draw new hand - deck is empty"));
+            UE_LOG(LogKevesCardKitCombat, Warning, TEXT("[CombatManager] Cannot draw new hand - deck is empty"));
         }
     }
 
     // Reset energy for next turn  
-    CurrentEnergy = MaxEnergyPerTurn;
+    ApplyEnergyChange(MaxEnergyPerTurn);
 
     SetCombatState(ECombatState::EnemyTurn);
 
-    // Process enemy turn after a brief delay
-    FTimerHandle EnemyTurnTimer;
-    GetWorld()->GetTimerManager().SetTimer(EnemyTurnTimer, this, &ACombatManager::ProcessEnemyTurn, 1.5f, false);
+    // Process enemy turn once the discard/draw presentation has finished
+    CombatSequencer->RunAfterPresentation(TEXT("ProcessEnemyTurn"),
+        FSimpleDelegate::CreateUObject(this, &ACombatManager::ProcessEnemyTurn));
 }
 
 // Enhanced damage function - targets battlefield cards first
 void ACombatManager::ModifyPlayerHealth(int32 HealthDelta)
 {
+    KCK_TRACE_SCOPE(KCK_ModifyPlayerHealth);
+
     if (HealthDelta == 0)
         return;
 
@@ -205,28 +533,30 @@ void ACombatManager::ModifyPlayerHealth(int32 HealthDelta)
     {
         int32 Damage = -HealthDelta;
 
-        UE_LOG(LogTemp, Log, TEXT("[CombatManager] Attempting to damage player for %d"), Damage);
+        KCK_LOG_HOT(LogKevesCardKitCombat, Verbose, TEXT("[CombatManager] Attempting to damage player for %d"), Damage);
 
         // First, try to damage a player's battlefield card with health
         if (DamageFirstAvailablePlayerCard(Damage))
         {
-            UE_LOG(LogTemp, Log, TEXT("[CombatManager] Damage applied to player's battlefield card"));
+            KCK_LOG_HOT(LogKevesCardKitCombat, Verbose, TEXT("[CombatManager] Damage applied to player's battlefield card"));
             return;
         }
 
         // If no cards available, damage player directly
-        PlayerHealth = FMath::Max(0, PlayerHealth - Damage);
+        ApplyPlayerHealthChange(FMath::Max(0, PlayerHealth - Damage));
+        KCK_TRACE_BROADCAST();
         OnHealthChanged.Broadcast(true, PlayerHealth);
 
-        UE_LOG(LogTemp, Log, TEXT("[CombatManager] No player cards available - damage applied to player health, health now %d"), PlayerHealth);
+        KCK_LOG_HOT(LogKevesCardKitCombat, Verbose, TEXT("[CombatManager] No player cards available - damage applied to player health, health now %d"), PlayerHealth);
     }
     else
     {
         // Healing
-        PlayerHealth = FMath::Min(PlayerMaxHealth, PlayerHealth + HealthDelta);
+        ApplyPlayerHealthChange(FMath::Min(PlayerMaxHealth, PlayerHealth + HealthDelta));
+        KCK_TRACE_BROADCAST();
         OnHealthChanged.Broadcast(true, PlayerHealth);
 
-        UE_LOG(LogTemp, Log, TEXT("[CombatManager] Player Health heals %d, health now %d"), HealthDelta, PlayerHealth);
+        KCK_LOG_HOT(LogKevesCardKitCombat, Verbose, TEXT("[CombatManager] Player Health heals %d, health now %d"), HealthDelta, PlayerHealth);
     }
 
     CheckWinConditions();
@@ -235,6 +565,8 @@ void ACombatManager::ModifyPlayerHealth(int32 HealthDelta)
 
 void ACombatManager::DamageEnemy(int32 Damage)
 {
+    KCK_TRACE_SCOPE(KCK_DamageEnemy);
+
     if (Damage <= 0) return;
 
     if (EnemyAIComponent)
@@ -243,9 +575,10 @@ void ACombatManager::DamageEnemy(int32 Damage)
     }
     else
     {
-        UE_LOG(LogTemp, Warning, TEXT("[CombatManager] No EnemyAIComponent - apply damage directly"));
+        UE_LOG(LogKevesCardKitCombat, Warning, TEXT("[CombatManager] No EnemyAIComponent - apply damage directly"));
 
-        CurrentEnemy.Health = FMath::Max(0, CurrentEnemy.Health - Damage);
+        ApplyEnemyHealthChange(FMath::Max(0, CurrentEnemy.Health - Damage));
+        KCK_TRACE_BROADCAST();
         OnHealthChanged.Broadcast(false, CurrentEnemy.Health);
         CheckWinConditions();
     }
@@ -266,28 +599,35 @@ bool ACombatManager::DamageFirstAvailableEnemyCard(int32 Damage)
 
 void ACombatManager::SetPlayerEnergy(int32 NewEnergy)
 {
-    CurrentEnergy = FMath::Clamp(NewEnergy, 0, 99); // No hard cap mentioned in rules
-    UE_LOG(LogTemp, Log, TEXT("[CombatManager] Player energy set to %d"), CurrentEnergy);
+    ApplyEnergyChange(FMath::Clamp(NewEnergy, 0, 99)); // No hard cap mentioned in rules
+    KCK_LOG_HOT(LogKevesCardKitCombat, Verbose, TEXT("[CombatManager] Player energy set to %d"), CurrentEnergy);
 }
 
 void ACombatManager::SpendEnergy(int32 Cost)
 {
-    CurrentEnergy = FMath::Max(0, CurrentEnergy - Cost);
-    UE_LOG(LogTemp, Log, TEXT("[CombatManager] Player spends %d energy, %d remaining"), Cost, CurrentEnergy);
+    ApplyEnergyChange(FMath::Max(0, CurrentEnergy - Cost));
+    KCK_LOG_HOT(LogKevesCardKitCombat, Verbose, TEXT("[CombatManager] Player spends %d energy, %d remaining"), Cost, CurrentEnergy);
 }
 
 // Battlefield management functions
 void ACombatManager::SummonCreature(const FCardData& CreatureCard, bool bIsPlayerOwned)
 {
+    LLM_SCOPE_BYTAG(KevesCardKit_Battlefield);
+
     if (CreatureCard.CardType != ECardType::Creature && CreatureCard.CardType != ECardType::Champion)
     {
-        UE_LOG(LogTemp, Warning, TEXT("[CombatManager] Cannot summon non-creature card: %s"), *CreatureCard.Name.ToString());
+        UE_LOG(LogKevesCardKitCombat, Warning, TEXT("[CombatManager] Cannot summon non-creature card: %s"), *CreatureCard.Name.ToString());
         return;
     }
 
     FBattlefieldCard BattlefieldCard(CreatureCard, bIsPlayerOwned);
     BattlefieldCard.UniqueID = ++NextUniqueCardID; // Assign unique ID
 
+    // Standing auras apply on entry
+    const FCardInstanceStats& Stats = ModifierLayers.AddInstance(BattlefieldCard.UniqueID, CreatureCard, bIsPlayerOwned, false);
+    BattlefieldCard.CurrentAttack = FMath::Max(0, Stats.Attack);
+    BattlefieldCard.CurrentHealth = FMath::Max(1, Stats.Health);
+
     int32 NewIndex = INDEX_NONE;
     if (bIsPlayerOwned)
     {
@@ -295,8 +635,8 @@ void ACombatManager::SummonCreature(const FCardData& CreatureCard, bool bIsPlaye
         NewIndex = PlayerBattlefield.Num() - 1;
         PlayerBattlefield[NewIndex].BattlefieldIndex = NewIndex; // Set array index
 
-        UE_LOG(LogTemp, Log, TEXT("[CombatManager] Player summoned %s (ID:%d, Index:%d, %d ATK/%d HP)"),
-            *CreatureCard.Name.ToString(), BattlefieldCard.UniqueID, NewIndex, CreatureCard.Attack, CreatureCard.Health);
+        KCK_LOG_HOT(LogKevesCardKitCombat, Verbose, TEXT("[CombatManager] Player summoned %s (ID:%d, Index:%d, %d ATK/%d HP)"),
+            *CreatureCard.Name.ToString(), BattlefieldCard.UniqueID, NewIndex, BattlefieldCard.CurrentAttack, BattlefieldCard.CurrentHealth);
     }
     else
     {
@@ -304,12 +644,24 @@ void ACombatManager::SummonCreature(const FCardData& CreatureCard, bool bIsPlaye
         NewIndex = EnemyBattlefield.Num() - 1;
         EnemyBattlefield[NewIndex].BattlefieldIndex = NewIndex; // Set array index
 
-        UE_LOG(LogTemp, Log, TEXT("[CombatManager] Enemy summoned %s (ID:%d, Index:%d, %d ATK/%d HP)"),
-            *CreatureCard.Name.ToString(), BattlefieldCard.UniqueID, NewIndex, CreatureCard.Attack, CreatureCard.Health);
+        KCK_LOG_HOT(LogKevesCardKitCombat, Verbose, TEXT("[CombatManager] Enemy summoned %s (ID:%d, Index:%d, %d ATK/%d HP)"),
+            *CreatureCard.Name.ToString(), BattlefieldCard.UniqueID, NewIndex, BattlefieldCard.CurrentAttack, BattlefieldCard.CurrentHealth);
     }
 
+    AddCreatureToHash(bIsPlayerOwned, BattlefieldCard);
+    (bIsPlayerOwned ? PlayerSlotByUniqueID : EnemySlotByUniqueID).Add(BattlefieldCard.UniqueID, NewIndex);
+    AccumulateBattlefieldSummary(bIsPlayerOwned, BattlefieldCard, 1);
+    MetricsRecorder.NoteBattlefieldSize(GetBattlefieldSummary(bIsPlayerOwned).CardCount);
+    NoteBattlefieldMemory();
+
     // Fire summon event for Blueprints
+    EmitBattlefieldDelta(EBattlefieldDeltaType::Added, BattlefieldCard, NewIndex, bIsPlayerOwned);
+    KCK_TRACE_BROADCAST();
     OnCreatureSummoned.Broadcast(BattlefieldCard, NewIndex, bIsPlayerOwned);
+
+    // Registered after the summon event, so "whenever a creature is summoned" does not see itself
+    DispatchCardTrigger(ECardTriggerEvent::CreatureSummoned, bIsPlayerOwned);
+    RegisterCardTriggers(CreatureCard, BattlefieldCard.UniqueID, bIsPlayerOwned);
 }
 
 void ACombatManager::RemoveCardFromBattlefield(int32 BattlefieldIndex, bool bIsPlayerSide)
@@ -318,7 +670,7 @@ void ACombatManager::RemoveCardFromBattlefield(int32 BattlefieldIndex, bool bIsP
 
     if (!Battlefield.IsValidIndex(BattlefieldIndex))
     {
-        UE_LOG(LogTemp, Warning, TEXT("[CombatManager] Invalid battlefield index: %d"), BattlefieldIndex);
+        UE_LOG(LogKevesCardKitCombat, Warning, TEXT("[CombatManager] Invalid battlefield index: %d"), BattlefieldIndex);
         return;
     }
 
@@ -328,13 +680,22 @@ void ACombatManager::RemoveCardFromBattlefield(int32 BattlefieldIndex, bool bIsP
     int32 UniqueID = CardToRemove.UniqueID;
     int32 CardDefID = CardToRemove.CardData.ID;
 
-    // Remove from array
+    // Remove from array; the creatures that shift down keep their hash keys (see FCombatStateHash)
+    RemoveCreatureFromHash(bIsPlayerSide, CardToRemove);
     Battlefield.RemoveAt(BattlefieldIndex);
+    (bIsPlayerSide ? PlayerSlotByUniqueID : EnemySlotByUniqueID).Remove(UniqueID);
+    AccumulateBattlefieldSummary(bIsPlayerSide, CardToRemove, -1);
+    UnregisterCardTriggers(UniqueID);
+    StatusEffects.RemoveCreature(UniqueID);
+    ModifierLayers.RemoveInstance(UniqueID);
 
     // Update indices for remaining cards
     UpdateBattlefieldIndices();
+    NoteBattlefieldMemory();
 
-    UE_LOG(LogTemp, Log, TEXT("[CombatManager] Removed card '%s' (ID:%d, DefID:%d) at index %d from %s battlefield"),
+    EmitBattlefieldDelta(EBattlefieldDeltaType::Removed, CardToRemove, BattlefieldIndex, bIsPlayerSide);
+
+    KCK_LOG_HOT(LogKevesCardKitCombat, Verbose, TEXT("[CombatManager] Removed card '%s' (ID:%d, DefID:%d) at index %d from %s battlefield"),
         *CardName, UniqueID, CardDefID, BattlefieldIndex, bIsPlayerSide ? TEXT("player") : TEXT("enemy"));
 
     // If creature died (health <= 0), send its card definition to the discard pile
@@ -343,12 +704,23 @@ void ACombatManager::RemoveCardFromBattlefield(int32 BattlefieldIndex, bool bIsP
         if (HandManager)
         {
             HandManager->AddCardToDiscard(CardToRemove.CardData.ID);
-            UE_LOG(LogTemp, Log, TEXT("[CombatManager] Creature '%s' (DefID:%d) discarded after death"), *CardName, CardDefID);
+            KCK_LOG_HOT(LogKevesCardKitCombat, Verbose, TEXT("[CombatManager] Creature '%s' (DefID:%d) discarded after death"), *CardName, CardDefID);
         }
     }
 
     // Fire remove event for Blueprints
+    KCK_TRACE_BROADCAST();
     OnCreatureRemoved.Broadcast(BattlefieldIndex, bIsPlayerSide);
+
+    // Auras this creature was granting end with it
+    FCardModifierLayers::FChanges Changes;
+    ModifierLayers.RemoveModifiersFromSource(UniqueID, Changes);
+    ApplyModifierChanges(Changes);
+
+    if (CardToRemove.CurrentHealth <= 0)
+    {
+        DispatchCardTrigger(ECardTriggerEvent::CreatureDied, bIsPlayerSide);
+    }
 }
 
 
@@ -356,14 +728,14 @@ void ACombatManager::BanishCard(const FCardData& CardToBanish)
 {
     if (!HandManager)
     {
-        UE_LOG(LogTemp, Warning, TEXT("[CombatManager] Cannot banish card '%s' because HandManager is null"), *CardToBanish.Name.ToString());
+        UE_LOG(LogKevesCardKitCombat, Warning, TEXT("[CombatManager] Cannot banish card '%s' because HandManager is null"), *CardToBanish.Name.ToString());
         return;
     }
 
     // Banished in HandManager (deck/hand/discard)
     HandManager->BanishCardByID(CardToBanish.ID);
 
-    UE_LOG(LogTemp, Log, TEXT("[CombatManager] Card '%s' (ID: %d) banished for this combat"), *CardToBanish.Name.ToString(), CardToBanish.ID);
+    KCK_LOG_HOT(LogKevesCardKitCombat, Verbose, TEXT("[CombatManager] Card '%s' (ID: %d) banished for this combat"), *CardToBanish.Name.ToString(), CardToBanish.ID);
 
     // Check if card is summoned on battlefield (player or enemy)
     int32 UniqueID = FindUniqueIDByCardID(CardToBanish.ID, true);
@@ -385,6 +757,7 @@ void ACombatManager::BanishCard(const FCardData& CardToBanish)
     }
 
     // Broadcast event with summoned info and UniqueID or -1
+    KCK_TRACE_BROADCAST();
     OnCardBanished.Broadcast(CardToBanish, bWasSummoned, bWasSummoned ? UniqueID : -1);
 }
 
@@ -405,6 +778,8 @@ int32 ACombatManager::FindUniqueIDByCardID(int32 CardID, bool bIsPlayerSide) con
 
 bool ACombatManager::DamageSpecificBattlefieldCard(int32 BattlefieldIndex, bool bIsPlayerSide, int32 Damage)
 {
+    KCK_TRACE_SCOPE(KCK_DamageBattlefieldCard);
+
     TArray<FBattlefieldCard>& Battlefield = bIsPlayerSide ? PlayerBattlefield : EnemyBattlefield;
 
     if (!Battlefield.IsValidIndex(BattlefieldIndex) || Damage <= 0)
@@ -414,18 +789,37 @@ bool ACombatManager::DamageSpecificBattlefieldCard(int32 BattlefieldIndex, bool
 
     FBattlefieldCard& Card = Battlefield[BattlefieldIndex];
     int32 UniqueID = Card.UniqueID; // Store the unique ID
+
+    // Armor soaks the hit first
+    const int32 IncomingDamage = Damage;
+    Damage = StatusEffects.AbsorbDamage(UniqueID, Damage);
+    if (Damage != IncomingDamage)
+    {
+        KCK_TRACE_BROADCAST();
+        OnCardStatusChanged.Broadcast(UniqueID);
+    }
+    if (Damage <= 0)
+    {
+        return true;
+    }
+    RemoveCreatureFromHash(bIsPlayerSide, Card);
+    AccumulateBattlefieldSummary(bIsPlayerSide, Card, -1);
     Card.CurrentHealth = FMath::Max(0, Card.CurrentHealth - Damage);
+    AccumulateBattlefieldSummary(bIsPlayerSide, Card, 1);
+    AddCreatureToHash(bIsPlayerSide, Card);
 
-    UE_LOG(LogTemp, Log, TEXT("[CombatManager] %s (ID:%d, Index:%d) takes %d damage, health now %d"),
+    KCK_LOG_HOT(LogKevesCardKitCombat, Verbose, TEXT("[CombatManager] %s (ID:%d, Index:%d) takes %d damage, health now %d"),
         *Card.CardData.Name.ToString(), UniqueID, BattlefieldIndex, Damage, Card.CurrentHealth);
 
     // Broadcast events
+    EmitBattlefieldDelta(EBattlefieldDeltaType::StatsChanged, Card, BattlefieldIndex, bIsPlayerSide);
+    KCK_TRACE_BROADCAST();
     OnCardDamaged.Broadcast(UniqueID, Damage, bIsPlayerSide);
 
     // Remove card if health reaches 0
     if (Card.CurrentHealth <= 0)
     {
-        UE_LOG(LogTemp, Log, TEXT("[CombatManager] %s (ID:%d) destroyed"),
+        KCK_LOG_HOT(LogKevesCardKitCombat, Verbose, TEXT("[CombatManager] %s (ID:%d) destroyed"),
             *Card.CardData.Name.ToString(), UniqueID);
         RemoveCardFromBattlefield(BattlefieldIndex, bIsPlayerSide);
     }
@@ -433,6 +827,68 @@ bool ACombatManager::DamageSpecificBattlefieldCard(int32 BattlefieldIndex, bool
     return true;
 }
 
+bool ACombatManager::BuffBattlefieldCard(int32 BattlefieldIndex, bool bIsPlayerSide, int32 AttackDelta, int32 HealthDelta)
+{
+    const TArray<FBattlefieldCard>& Battlefield = bIsPlayerSide ? PlayerBattlefield : EnemyBattlefield;
+    if (!Battlefield.IsValidIndex(BattlefieldIndex) || (AttackDelta == 0 && HealthDelta == 0))
+    {
+        return false;
+    }
+
+    const FBattlefieldCard& Card = Battlefield[BattlefieldIndex];
+    SetBattlefieldCardStats(BattlefieldIndex, bIsPlayerSide,
+        FMath::Max(0, Card.CurrentAttack + AttackDelta), FMath::Max(0, Card.CurrentHealth + HealthDelta));
+
+    if (Battlefield[BattlefieldIndex].CurrentHealth <= 0)
+    {
+        RemoveCardFromBattlefield(BattlefieldIndex, bIsPlayerSide);
+    }
+    return true;
+}
+
+bool ACombatManager::HealBattlefieldCard(int32 BattlefieldIndex, bool bIsPlayerSide, int32 Amount)
+{
+    const TArray<FBattlefieldCard>& Battlefield = bIsPlayerSide ? PlayerBattlefield : EnemyBattlefield;
+    if (!Battlefield.IsValidIndex(BattlefieldIndex) || Amount <= 0)
+    {
+        return false;
+    }
+
+    const FBattlefieldCard& Card = Battlefield[BattlefieldIndex];
+    const int32 NewHealth = FMath::Min(GetHealCap(Card), Card.CurrentHealth + Amount);
+    if (NewHealth == Card.CurrentHealth)
+    {
+        return false;
+    }
+
+    SetBattlefieldCardStats(BattlefieldIndex, bIsPlayerSide, Card.CurrentAttack, NewHealth);
+    return true;
+}
+
+int32 ACombatManager::GetHealCap(const FBattlefieldCard& Card) const
+{
+    // Buffs and auras raise the cap
+    const FCardInstanceStats* Stats = ModifierLayers.Find(Card.UniqueID);
+    return FMath::Max(Card.CurrentHealth, Stats ? Stats->Health : Card.CardData.Health);
+}
+
+void ACombatManager::SetBattlefieldCardStats(int32 BattlefieldIndex, bool bIsPlayerSide, int32 NewAttack, int32 NewHealth)
+{
+    FBattlefieldCard& Card = (bIsPlayerSide ? PlayerBattlefield : EnemyBattlefield)[BattlefieldIndex];
+
+    RemoveCreatureFromHash(bIsPlayerSide, Card);
+    AccumulateBattlefieldSummary(bIsPlayerSide, Card, -1);
+    Card.CurrentAttack = NewAttack;
+    Card.CurrentHealth = NewHealth;
+    AccumulateBattlefieldSummary(bIsPlayerSide, Card, 1);
+    AddCreatureToHash(bIsPlayerSide, Card);
+
+    KCK_LOG_HOT(LogKevesCardKitCombat, Verbose, TEXT("[CombatManager] %s (ID:%d, Index:%d) stats now %d ATK / %d HP"),
+        *Card.CardData.Name.ToString(), Card.UniqueID, BattlefieldIndex, Card.CurrentAttack, Card.CurrentHealth);
+
+    EmitBattlefieldDelta(EBattlefieldDeltaType::StatsChanged, Card, BattlefieldIndex, bIsPlayerSide);
+}
+
 // NEW: Damage by Unique ID
 bool ACombatManager::DamageBattlefieldCardByUniqueID(int32 UniqueID, int32 Damage)
 {
@@ -452,36 +908,16 @@ bool ACombatManager::DamageBattlefieldCardByUniqueID(int32 UniqueID, int32 Damag
         return DamageSpecificBattlefieldCard(EnemyIndex, false, Damage);
     }
 
-    UE_LOG(LogTemp, Warning, TEXT("[CombatManager] No card found with Unique ID: %d"), UniqueID);
+    UE_LOG(LogKevesCardKitCombat, Warning, TEXT("[CombatManager] No card found with Unique ID: %d"), UniqueID);
     return false;
 }
 
 // NEW: Get card by Unique ID
 FBattlefieldCard ACombatManager::GetBattlefieldCardByUniqueID(int32 UniqueID, bool& bFound) const
 {
-    bFound = false;
-
-    // Check player battlefield
-    for (const FBattlefieldCard& Card : PlayerBattlefield)
-    {
-        if (Card.UniqueID == UniqueID)
-        {
-            bFound = true;
-            return Card;
-        }
-    }
-
-    // Check enemy battlefield
-    for (const FBattlefieldCard& Card : EnemyBattlefield)
-    {
-        if (Card.UniqueID == UniqueID)
-        {
-            bFound = true;
-            return Card;
-        }
-    }
-
-    return FBattlefieldCard(); // Return empty card if not found
+    const FBattlefieldCard* Card = FindBattlefieldCard(UniqueID);
+    bFound = Card != nullptr;
+    return Card ? *Card : FBattlefieldCard(); // Return empty card if not found
 }
 
 // NEW: Remove by Unique ID
@@ -508,30 +944,6 @@ bool ACombatManager::RemoveBattlefieldCardByUniqueID(int32 UniqueID)
     return false;
 }
 
-bool ACombatManager::HasPlayerCardsWithHealth() const
-{
-    for (const FBattlefieldCard& Card : PlayerBattlefield)
-    {
-        if (Card.CurrentHealth > 0)
-        {
-            return true;
-        }
-    }
-    return false;
-}
-
-bool ACombatManager::HasEnemyCardsWithHealth() const
-{
-    for (const FBattlefieldCard& Card : EnemyBattlefield)
-    {
-        if (Card.CurrentHealth > 0)
-        {
-            return true;
-        }
-    }
-    return false;
-}
-
 // Private helper functions for damage targeting
 bool ACombatManager::DamageFirstAvailablePlayerCard(int32 Damage)
 {
@@ -551,11 +963,27 @@ void ACombatManager::SetCombatState(ECombatState NewState)
 
     ECombatState OldState = CurrentState;
     CurrentState = NewState;
+    StateHash.ChangeScalar(ECombatHashScalar::CombatState, (int32)OldState, (int32)NewState);
+
+    MetricsRecorder.EndTurn();
+    if (NewState == ECombatState::PlayerTurn || NewState == ECombatState::EnemyTurn)
+    {
+        KCKTrace::BeginTurn(NewState == ECombatState::PlayerTurn);
+        MetricsRecorder.BeginTurn(NewState == ECombatState::PlayerTurn);
+    }
 
+    KCK_TRACE_BROADCAST();
     OnCombatStateChanged.Broadcast(CurrentState);
 
-    UE_LOG(LogTemp, Log, TEXT("[CombatManager] Combat state changed from %d to %d"),
+    UE_LOG(LogKevesCardKitCombat, Log, TEXT("[CombatManager] Combat state changed from %d to %d"),
         (int32)OldState, (int32)CurrentState);
+
+    if (NewState == ECombatState::PlayerTurn || NewState == ECombatState::EnemyTurn)
+    {
+        CopiesPlayedThisTurn[NewState == ECombatState::PlayerTurn ? 1 : 0].Reset();
+        ProcessStatusEffects(NewState == ECombatState::PlayerTurn);
+        DispatchCardTrigger(ECardTriggerEvent::TurnStart, NewState == ECombatState::PlayerTurn);
+    }
 }
 
 void ACombatManager::ProcessEnemyTurn()
@@ -576,7 +1004,7 @@ void ACombatManager::ProcessEnemyTurn()
     else
     {
         // Fallback or simple AI damage logic
-        ModifyPlayerHealth(-FMath::RandRange(10, 20));
+        ModifyPlayerHealth(-CombatRandom.RandRange(10, 20));
         CheckWinConditions();
         SetCombatState(ECombatState::PlayerTurn);
     }
@@ -608,37 +1036,53 @@ void ACombatManager::CheckWinConditions()
 
 void ACombatManager::OnCardPlayed(const FCardData& PlayedCard)
 {
-    // Spend energy for the card
-    SpendEnergy(PlayedCard.Cost);
+    KCK_TRACE_SCOPE(KCK_ResolveCardPlayed);
+
+    // Energy was already paid by AHandManager::PlayCard, before the card's ability ran
+
+    // Before the card's own permanent registers, so it does not trigger on itself
+    DispatchCardTrigger(ECardTriggerEvent::CardPlayed, true);
 
     // Apply card effects based on type
     if (PlayedCard.CardType == ECardType::Creature || PlayedCard.CardType == ECardType::Champion)
     {
         // Creatures and Champions go to the battlefield
-        UE_LOG(LogTemp, Log, TEXT("[CombatManager] Summoning creature '%s'"), *PlayedCard.Name.ToString());
+        KCK_LOG_HOT(LogKevesCardKitCombat, Verbose, TEXT("[CombatManager] Summoning creature '%s'"), *PlayedCard.Name.ToString());
         SummonCreature(PlayedCard, true);
     }
     else if (PlayedCard.CardType == ECardType::Spell)
     {
         // Spells have immediate effects then are discarded
         // You'll implement specific spell effects based on AbilityID
-        UE_LOG(LogTemp, Log, TEXT("[CombatManager] Spell '%s' cast"), *PlayedCard.Name.ToString());
+        KCK_LOG_HOT(LogKevesCardKitCombat, Verbose, TEXT("[CombatManager] Spell '%s' cast"), *PlayedCard.Name.ToString());
     }
     else if (PlayedCard.CardType == ECardType::Power)
     {
         // Powers are permanent for this combat
-        UE_LOG(LogTemp, Log, TEXT("[CombatManager] Power '%s' activated (permanent this combat)"), *PlayedCard.Name.ToString());
+        KCK_LOG_HOT(LogKevesCardKitCombat, Verbose, TEXT("[CombatManager] Power '%s' activated (permanent this combat)"), *PlayedCard.Name.ToString());
+        RegisterCardTriggers(PlayedCard, ++NextUniqueCardID, true);
     }
     else if (PlayedCard.CardType == ECardType::Skill)
     {
         // Skills have immediate effects then are discarded
-        UE_LOG(LogTemp, Log, TEXT("[CombatManager] Skill '%s' used"), *PlayedCard.Name.ToString());
+        KCK_LOG_HOT(LogKevesCardKitCombat, Verbose, TEXT("[CombatManager] Skill '%s' used"), *PlayedCard.Name.ToString());
     }
 
-    UE_LOG(LogTemp, Log, TEXT("[CombatManager] Card played: %s (Cost: %d Energy)"),
+    KCK_LOG_HOT(LogKevesCardKitCombat, Verbose, TEXT("[CombatManager] Card played: %s (Cost: %d Energy)"),
         *PlayedCard.Name.ToString(), PlayedCard.Cost);
 }
 
+int32 ACombatManager::GetCopiesPlayedThisTurn(int32 CardID, bool bIsPlayerSide) const
+{
+    const int32* Count = CopiesPlayedThisTurn[bIsPlayerSide ? 1 : 0].Find(CardID);
+    return Count ? *Count : 0;
+}
+
+void ACombatManager::NoteCardPlayedThisTurn(int32 CardID, bool bIsPlayerSide)
+{
+    CopiesPlayedThisTurn[bIsPlayerSide ? 1 : 0].FindOrAdd(CardID)++;
+}
+
 // Helper function to update battlefield indices after removal
 void ACombatManager::UpdateBattlefieldIndices()
 {
@@ -646,15 +1090,17 @@ void ACombatManager::UpdateBattlefieldIndices()
     for (int32 i = 0; i < PlayerBattlefield.Num(); i++)
     {
         PlayerBattlefield[i].BattlefieldIndex = i;
+        PlayerSlotByUniqueID.Add(PlayerBattlefield[i].UniqueID, i);
     }
 
     // Update enemy battlefield indices
     for (int32 i = 0; i < EnemyBattlefield.Num(); i++)
     {
         EnemyBattlefield[i].BattlefieldIndex = i;
+        EnemySlotByUniqueID.Add(EnemyBattlefield[i].UniqueID, i);
     }
 
-    UE_LOG(LogTemp, VeryVerbose, TEXT("[CombatManager] Updated battlefield indices - Player: %d, Enemy: %d"),
+    KCK_LOG_HOT(LogKevesCardKitCombat, VeryVerbose, TEXT("[CombatManager] Updated battlefield indices - Player: %d, Enemy: %d"),
         PlayerBattlefield.Num(), EnemyBattlefield.Num());
 }
 
@@ -662,50 +1108,721 @@ void ACombatManager::UpdateBattlefieldIndices()
 int32 ACombatManager::FindBattlefieldIndexByUniqueID(int32 UniqueID, bool bIsPlayerSide) const
 {
     const TArray<FBattlefieldCard>& Battlefield = bIsPlayerSide ? PlayerBattlefield : EnemyBattlefield;
+    const TMap<int32, int32>& SlotByUniqueID = bIsPlayerSide ? PlayerSlotByUniqueID : EnemySlotByUniqueID;
 
-    for (int32 i = 0; i < Battlefield.Num(); i++)
+    const int32* Slot = SlotByUniqueID.Find(UniqueID);
+    if (Slot && Battlefield.IsValidIndex(*Slot) && Battlefield[*Slot].UniqueID == UniqueID)
     {
-        if (Battlefield[i].UniqueID == UniqueID)
-        {
-            return i;
-        }
+        return *Slot;
     }
 
     return INDEX_NONE; // Not found
 }
 
-// Play enemy card (called from EnemyAIComponent)
-bool ACombatManager::PlayEnemyCard(const FCardData& CardToPlay)
-{
-    UE_LOG(LogTemp, Log, TEXT("[CombatManager] Enemy plays card %s"), *CardToPlay.Name.ToString());
+// ==== BATTLEFIELD QUERIES ====
 
-    // Apply card effects similar to player playing cards
-    if (CardToPlay.CardType == ECardType::Creature || CardToPlay.CardType == ECardType::Champion)
-    {
-        SummonCreature(CardToPlay, false);
-    }
-    else if (CardToPlay.CardType == ECardType::Spell)
-    {
-        // TODO: Spell effect logic for enemy
-    }
-    else if (CardToPlay.CardType == ECardType::Power)
+const FBattlefieldCard* ACombatManager::FindBattlefieldCard(int32 UniqueID, bool* bOutIsPlayerSide) const
+{
+    int32 Index = FindBattlefieldIndexByUniqueID(UniqueID, true);
+    if (Index != INDEX_NONE)
     {
-        // TODO: Power effect for enemy
+        if (bOutIsPlayerSide) *bOutIsPlayerSide = true;
+        return &PlayerBattlefield[Index];
     }
-    else if (CardToPlay.CardType == ECardType::Skill)
+
+    Index = FindBattlefieldIndexByUniqueID(UniqueID, false);
+    if (Index != INDEX_NONE)
     {
-        // TODO: Skill effect for enemy
+        if (bOutIsPlayerSide) *bOutIsPlayerSide = false;
+        return &EnemyBattlefield[Index];
     }
 
-    return true;
+    return nullptr;
 }
 
+int32 ACombatManager::GetBattlefieldCardHealth(int32 UniqueID) const
+{
+    const FBattlefieldCard* Card = FindBattlefieldCard(UniqueID);
+    return Card ? Card->CurrentHealth : -1;
+}
 
-
-void ACombatManager::HandleEnemyHealthChanged(int32 NewHealth)
+int32 ACombatManager::GetBattlefieldCardAttack(int32 UniqueID) const
 {
-    CurrentEnemy.Health = NewHealth;
+    const FBattlefieldCard* Card = FindBattlefieldCard(UniqueID);
+    return Card ? Card->CurrentAttack : -1;
+}
+
+int32 ACombatManager::GetBattlefieldCardDefinitionID(int32 UniqueID) const
+{
+    const FBattlefieldCard* Card = FindBattlefieldCard(UniqueID);
+    return Card ? Card->CardData.ID : -1;
+}
+
+int32 ACombatManager::GetBattlefieldUniqueIDAt(int32 BattlefieldIndex, bool bIsPlayerSide) const
+{
+    const TConstArrayView<FBattlefieldCard> Battlefield = GetBattlefieldView(bIsPlayerSide);
+    return Battlefield.IsValidIndex(BattlefieldIndex) ? Battlefield[BattlefieldIndex].UniqueID : -1;
+}
+
+void ACombatManager::AccumulateBattlefieldSummary(bool bIsPlayerSide, const FBattlefieldCard& Card, int32 Sign)
+{
+    FBattlefieldSummary& Summary = bIsPlayerSide ? PlayerSummary : EnemySummary;
+    Summary.CardCount += Sign;
+
+    if (Card.CurrentHealth > 0)
+    {
+        Summary.LivingCount += Sign;
+        Summary.TotalAttack += Sign * Card.CurrentAttack;
+        Summary.TotalHealth += Sign * Card.CurrentHealth;
+    }
+}
+
+void ACombatManager::RebuildBattlefieldLookup()
+{
+    LLM_SCOPE_BYTAG(KevesCardKit_Battlefield);
+
+    PlayerSummary = FBattlefieldSummary();
+    EnemySummary = FBattlefieldSummary();
+    PlayerSlotByUniqueID.Reset();
+    EnemySlotByUniqueID.Reset();
+
+    for (const FBattlefieldCard& Card : PlayerBattlefield)
+    {
+        AccumulateBattlefieldSummary(true, Card, 1);
+    }
+    for (const FBattlefieldCard& Card : EnemyBattlefield)
+    {
+        AccumulateBattlefieldSummary(false, Card, 1);
+    }
+
+    UpdateBattlefieldIndices();
+    NoteBattlefieldMemory();
+}
+
+void ACombatManager::NoteBattlefieldMemory() const
+{
+    KCKMemory::SetBytes(ECardKitMemoryCategory::Battlefield,
+        PlayerBattlefield.GetAllocatedSize() + EnemyBattlefield.GetAllocatedSize()
+        + PlayerSlotByUniqueID.GetAllocatedSize() + EnemySlotByUniqueID.GetAllocatedSize()
+        + BattlefieldDeltaRing.GetAllocatedSize() + StatusEffects.GetAllocatedSize() + ModifierLayers.GetAllocatedSize());
+}
+
+const FCardZoneMasks& ACombatManager::GetBattlefieldMasks(bool bIsPlayerSide) const
+{
+    // Every add, stat change and removal emits a delta, so the sequence doubles as a version number
+    if (BattlefieldMasksSequence != NextBattlefieldSequence)
+    {
+        for (const bool bSide : { true, false })
+        {
+            FCardZoneMasks& Masks = BattlefieldMasks[bSide ? 1 : 0];
+            Masks.Reset();
+
+            const TConstArrayView<FBattlefieldCard> Battlefield = GetBattlefieldView(bSide);
+            for (int32 Slot = 0; Slot < Battlefield.Num(); Slot++)
+            {
+                if (Battlefield[Slot].CurrentHealth > 0)
+                {
+                    Masks.AddSlot(Slot, Battlefield[Slot].CardData);
+                }
+            }
+        }
+        BattlefieldMasksSequence = NextBattlefieldSequence;
+    }
+
+    return BattlefieldMasks[bIsPlayerSide ? 1 : 0];
+}
+
+// ==== TARGET SETS ====
+
+void ACombatManager::GatherTargetUniqueIDs(const FCardTargetSet& Targets, TArray<TPair<int32, bool>, TInlineAllocator<16>>& OutCreatures) const
+{
+    OutCreatures.Reset();
+    for (const bool bSide : { true, false })
+    {
+        const TConstArrayView<FBattlefieldCard> Battlefield = GetBattlefieldView(bSide);
+        KCKTargeting::ForEachSlotDescending(Targets.Field(bSide), [&](int32 Slot)
+        {
+            if (Battlefield.IsValidIndex(Slot))
+            {
+                OutCreatures.Emplace(Battlefield[Slot].UniqueID, bSide);
+            }
+        });
+    }
+}
+
+void ACombatManager::DamageTargets(const FCardTargetSet& Targets, int32 Damage)
+{
+    KCK_TRACE_SCOPE(KCK_DamageTargets);
+
+    TArray<TPair<int32, bool>, TInlineAllocator<16>> Creatures;
+    GatherTargetUniqueIDs(Targets, Creatures);
+
+    for (const TPair<int32, bool>& Creature : Creatures)
+    {
+        const int32 Index = FindBattlefieldIndexByUniqueID(Creature.Key, Creature.Value);
+        if (Index != INDEX_NONE)
+        {
+            DamageSpecificBattlefieldCard(Index, Creature.Value, Damage);
+        }
+    }
+
+    // Heroes last; as with creature attacks, creatures on that side soak the hit first
+    if (Targets.bPlayerHero)
+    {
+        ModifyPlayerHealth(-Damage);
+    }
+    if (Targets.bEnemyHero)
+    {
+        DamageEnemy(Damage);
+    }
+}
+
+void ACombatManager::HealTargets(const FCardTargetSet& Targets, int32 Amount)
+{
+    TArray<TPair<int32, bool>, TInlineAllocator<16>> Creatures;
+    GatherTargetUniqueIDs(Targets, Creatures);
+
+    for (const TPair<int32, bool>& Creature : Creatures)
+    {
+        const int32 Index = FindBattlefieldIndexByUniqueID(Creature.Key, Creature.Value);
+        if (Index != INDEX_NONE)
+        {
+            HealBattlefieldCard(Index, Creature.Value, Amount);
+        }
+    }
+
+    if (Targets.bPlayerHero)
+    {
+        ModifyPlayerHealth(Amount);
+    }
+    if (Targets.bEnemyHero && EnemyAIComponent)
+    {
+        EnemyAIComponent->ModifyEnemyHealth(Amount);
+    }
+}
+
+void ACombatManager::BuffTargets(const FCardTargetSet& Targets, int32 AttackDelta, int32 HealthDelta)
+{
+    if (AttackDelta == 0 && HealthDelta == 0)
+    {
+        return;
+    }
+
+    // All modifiers go in before any stats are pushed, so a death mid-batch cannot shift the slots
+    FCardModifierLayers::FChanges Changes;
+    FCardModifier Buff;
+    Buff.Attack = AttackDelta;
+    Buff.Health = HealthDelta;
+
+    for (const bool bSide : { true, false })
+    {
+        const TConstArrayView<FBattlefieldCard> Battlefield = GetBattlefieldView(bSide);
+        KCKTargeting::ForEachSlotDescending(Targets.Field(bSide), [&](int32 Slot)
+        {
+            if (Battlefield.IsValidIndex(Slot))
+            {
+                Buff.InstanceID = Battlefield[Slot].UniqueID;
+                ModifierLayers.AddModifier(Buff, Changes);
+            }
+        });
+    }
+
+    if (Targets.PlayerHand != 0 && HandManager)
+    {
+        KCKTargeting::ForEachSlotDescending(Targets.PlayerHand, [&](int32 Slot)
+        {
+            Buff.InstanceID = HandManager->GetHandInstanceID(Slot);
+            if (Buff.InstanceID != -1)
+            {
+                ModifierLayers.AddModifier(Buff, Changes);
+            }
+        });
+    }
+
+    ApplyModifierChanges(Changes);
+}
+
+// ==== MODIFIERS ====
+
+int32 ACombatManager::AddAura(const FCardTargetSelector& Scope, bool bCasterIsPlayer, int32 AttackDelta, int32 HealthDelta, int32 CostDelta, int32 SourceID)
+{
+    FCardModifier Aura;
+    Aura.Attack = AttackDelta;
+    Aura.Health = HealthDelta;
+    Aura.Cost = CostDelta;
+    Aura.SourceID = SourceID;
+    Aura.CardTypes = Scope.CardTypes;
+
+    // Zones are relative to the caster; only the player's hand is tracked
+    const bool bOwnField = Scope.HasZone(ECardTargetZone::OwnField);
+    const bool bOpposingField = Scope.HasZone(ECardTargetZone::OpposingField);
+    Aura.bPlayerField = bCasterIsPlayer ? bOwnField : bOpposingField;
+    Aura.bEnemyField = bCasterIsPlayer ? bOpposingField : bOwnField;
+    Aura.bPlayerHand = bCasterIsPlayer && Scope.HasZone(ECardTargetZone::OwnHand);
+
+    if (!Aura.bPlayerField && !Aura.bEnemyField && !Aura.bPlayerHand)
+    {
+        UE_LOG(LogKevesCardKitCombat, Warning, TEXT("[CombatManager] AddAura: scope covers no battlefield or hand zone"));
+        return 0;
+    }
+
+    FCardModifierLayers::FChanges Changes;
+    const int32 ModifierID = ModifierLayers.AddModifier(Aura, Changes);
+
+    KCK_LOG_HOT(LogKevesCardKitCombat, Verbose, TEXT("[CombatManager] Aura %d (%+d ATK / %+d HP / %+d cost) applies to %d cards"),
+        ModifierID, AttackDelta, HealthDelta, CostDelta, Changes.Num());
+
+    ApplyModifierChanges(Changes);
+    NoteBattlefieldMemory();
+    return ModifierID;
+}
+
+void ACombatManager::RemoveCardModifier(int32 ModifierID)
+{
+    FCardModifierLayers::FChanges Changes;
+    ModifierLayers.RemoveModifier(ModifierID, Changes);
+    ApplyModifierChanges(Changes);
+}
+
+void ACombatManager::RegisterHandInstance(int32 InstanceID, FCardData& InOutCard)
+{
+    const FCardInstanceStats& Stats = ModifierLayers.AddInstance(InstanceID, InOutCard, true, true);
+    InOutCard.Attack = FMath::Max(0, Stats.Attack);
+    InOutCard.Health = FMath::Max(1, Stats.Health);
+    InOutCard.Cost = FMath::Max(0, Stats.Cost);
+}
+
+void ACombatManager::GetCarriedCardStats(int32 InstanceID, FCardData& InOutCard) const
+{
+    if (const FCardInstanceStats* Stats = ModifierLayers.Find(InstanceID))
+    {
+        InOutCard.Attack = FMath::Max(0, Stats->BaseAttack + Stats->OwnAttack);
+        InOutCard.Health = FMath::Max(1, Stats->BaseHealth + Stats->OwnHealth);
+    }
+}
+
+void ACombatManager::ApplyModifierChanges(const FCardModifierLayers::FChanges& Changes)
+{
+    TArray<int32, TInlineAllocator<8>> HandInstances;
+
+    for (const FCardStatChange& Change : Changes)
+    {
+        const FCardInstanceStats* Stats = ModifierLayers.Find(Change.InstanceID);
+        if (!Stats)
+        {
+            continue; // Left play while an earlier change in this batch was applied
+        }
+
+        if (Stats->bInHand)
+        {
+            HandInstances.Add(Change.InstanceID);
+            continue;
+        }
+
+        // Health moves by the delta so damage taken is kept; attack is rewritten from the cache
+        const bool bSide = Stats->bPlayerSide;
+        const int32 Index = FindBattlefieldIndexByUniqueID(Change.InstanceID, bSide);
+        if (Index != INDEX_NONE)
+        {
+            const int32 AttackDelta = FMath::Max(0, Stats->Attack) - GetBattlefieldView(bSide)[Index].CurrentAttack;
+            BuffBattlefieldCard(Index, bSide, AttackDelta, Change.HealthDelta);
+        }
+    }
+
+    if (HandInstances.Num() > 0 && HandManager)
+    {
+        HandManager->RefreshHandInstances(HandInstances);
+    }
+}
+
+// ==== BATTLEFIELD DELTA STREAM ====
+
+void ACombatManager::BroadcastBattlefieldUpdate(bool bPlayerSideChanged, const FBattlefieldCard* CardChanged)
+{
+    // Both paths exist for cards Blueprint edited directly. The old stats are unknown, so the summary
+    // totals and the hash cannot be adjusted incrementally; they are rebuilt from the battlefields
+    // (a few dozen creatures at most), and only the deltas stay proportional to the change.
+    RebuildBattlefieldLookup();
+    RebuildCombatStateHash();
+
+    // One card: emit its stats. No card: resync the whole side.
+    if (CardChanged)
+    {
+        EmitBattlefieldDelta(EBattlefieldDeltaType::StatsChanged, *CardChanged, CardChanged->BattlefieldIndex, bPlayerSideChanged);
+        return;
+    }
+
+    const TArray<FBattlefieldCard>& Battlefield = bPlayerSideChanged ? PlayerBattlefield : EnemyBattlefield;
+    for (int32 i = 0; i < Battlefield.Num(); i++)
+    {
+        EmitBattlefieldDelta(EBattlefieldDeltaType::StatsChanged, Battlefield[i], i, bPlayerSideChanged);
+    }
+}
+
+void ACombatManager::EmitBattlefieldDelta(EBattlefieldDeltaType Type, const FBattlefieldCard& Card, int32 BattlefieldIndex, bool bIsPlayerSide)
+{
+    if (BattlefieldDeltaRing.Num() == 0)
+    {
+        BattlefieldDeltaRing.SetNum(FMath::Max(1, BattlefieldDeltaHistorySize));
+    }
+
+    FBattlefieldDelta Delta;
+    Delta.Sequence = NextBattlefieldSequence++;
+    Delta.Type = Type;
+    Delta.bIsPlayerSide = bIsPlayerSide;
+    Delta.UniqueID = Card.UniqueID;
+    Delta.CardID = Type == EBattlefieldDeltaType::Cleared ? -1 : Card.CardData.ID;
+    Delta.BattlefieldIndex = BattlefieldIndex;
+    Delta.Health = Card.CurrentHealth;
+    Delta.Attack = Card.CurrentAttack;
+
+    BattlefieldDeltaRing[Delta.Sequence % BattlefieldDeltaRing.Num()] = Delta;
+
+    KCK_TRACE_BROADCAST();
+    OnBattlefieldDelta.Broadcast(Delta);
+}
+
+bool ACombatManager::GetBattlefieldDeltasSince(int32 LastSequence, TArray<FBattlefieldDelta>& OutDeltas) const
+{
+    const int32 Newest = NextBattlefieldSequence - 1;
+    if (LastSequence >= Newest)
+    {
+        return true;
+    }
+
+    const int32 Oldest = FMath::Max(1, NextBattlefieldSequence - BattlefieldDeltaRing.Num());
+    const bool bComplete = LastSequence + 1 >= Oldest;
+
+    for (int32 Sequence = FMath::Max(LastSequence + 1, Oldest); Sequence <= Newest; Sequence++)
+    {
+        OutDeltas.Add(BattlefieldDeltaRing[Sequence % BattlefieldDeltaRing.Num()]);
+    }
+
+    return bComplete;
+}
+
+// Play enemy card (called from EnemyAIComponent)
+bool ACombatManager::PlayEnemyCard(const FCardData& CardToPlay)
+{
+    KCK_TRACE_SCOPE(KCK_PlayEnemyCard);
+
+    KCK_LOG_HOT(LogKevesCardKitCombat, Verbose, TEXT("[CombatManager] Enemy plays card %s"), *CardToPlay.Name.ToString());
+
+    NoteCardPlayedThisTurn(CardToPlay.ID, false);
+    DispatchCardTrigger(ECardTriggerEvent::CardPlayed, false);
+
+    // Apply card effects similar to player playing cards
+    if (CardToPlay.CardType == ECardType::Creature || CardToPlay.CardType == ECardType::Champion)
+    {
+        SummonCreature(CardToPlay, false);
+    }
+    else if (CardToPlay.CardType == ECardType::Power)
+    {
+        RegisterCardTriggers(CardToPlay, ++NextUniqueCardID, false);
+    }
+
+    // Enemy abilities run through the same compiled programs as the player's, with sides mirrored
+    if (CardToPlay.AbilityID > 0 && HandManager)
+    {
+        const FCardCatalog::FRef Catalog = HandManager->GetCatalog();
+        if (Catalog->GetAbilityTrigger(CardToPlay.AbilityID) == ECardTriggerEvent::None)
+        {
+            FCardData SourceCard = CardToPlay;
+            FCardAbilityContext Context;
+            Context.HandManager = HandManager;
+            Context.CombatManager = this;
+            Context.bCasterIsPlayer = false;
+            Context.SourceCard = &SourceCard;
+            Context.EnergySpent = CardToPlay.Cost;
+            KCKAbility::Execute(*Catalog, CardToPlay.AbilityID, Context);
+        }
+    }
+
+    return true;
+}
+
+
+
+void ACombatManager::HandleEnemyHealthChanged(int32 NewHealth)
+{
+    ApplyEnemyHealthChange(NewHealth);
+    KCK_TRACE_BROADCAST();
     OnHealthChanged.Broadcast(false, NewHealth);  // false = enemy
 
     CheckWinConditions();
 }
+
+// ==== STATUS EFFECTS ====
+
+bool ACombatManager::ApplyStatusEffect(int32 UniqueID, ECardStatusEffect Effect, int32 Amount, int32 Turns)
+{
+    bool bIsPlayerSide = true;
+    if (Amount <= 0 || !FindBattlefieldCard(UniqueID, &bIsPlayerSide))
+    {
+        return false;
+    }
+
+    StatusEffects.Apply(Effect, UniqueID, bIsPlayerSide, Amount, Turns);
+    NoteBattlefieldMemory();
+
+    KCK_LOG_HOT(LogKevesCardKitCombat, Verbose, TEXT("[CombatManager] Creature ID:%d gains %d of status %d (%d turns)"),
+        UniqueID, Amount, (int32)Effect, Turns);
+
+    KCK_TRACE_BROADCAST();
+    OnCardStatusChanged.Broadcast(UniqueID);
+    return true;
+}
+
+void ACombatManager::ApplyStatusToTargets(const FCardTargetSet& Targets, ECardStatusEffect Effect, int32 Amount, int32 Turns)
+{
+    TArray<TPair<int32, bool>, TInlineAllocator<16>> Creatures;
+    GatherTargetUniqueIDs(Targets, Creatures);
+
+    for (const TPair<int32, bool>& Creature : Creatures)
+    {
+        ApplyStatusEffect(Creature.Key, Effect, Amount, Turns);
+    }
+}
+
+void ACombatManager::ProcessStatusEffects(bool bIsPlayerSide)
+{
+    KCK_TRACE_SCOPE(KCK_ProcessStatusEffects);
+
+    TArray<FCardStatusTick> Ticks;
+    StatusEffects.Tick(bIsPlayerSide, Ticks);
+    if (Ticks.Num() == 0)
+    {
+        return;
+    }
+
+    // One stat write per creature with everything it takes this turn
+    TArray<int32, TInlineAllocator<8>> DeadUniqueIDs;
+    for (const FCardStatusTick& Tick : Ticks)
+    {
+        const int32 Index = FindBattlefieldIndexByUniqueID(Tick.UniqueID, bIsPlayerSide);
+        if (Index == INDEX_NONE)
+        {
+            continue;
+        }
+
+        // Armor soaks poison like any other damage
+        const FBattlefieldCard& Card = GetBattlefieldView(bIsPlayerSide)[Index];
+        int32 NewHealth = Card.CurrentHealth - StatusEffects.AbsorbDamage(Tick.UniqueID, Tick.Damage);
+        if (Tick.Healing > 0)
+        {
+            // Same cap as HealBattlefieldCard
+            NewHealth = FMath::Min(NewHealth + Tick.Healing, GetHealCap(Card));
+        }
+        NewHealth = FMath::Max(0, NewHealth);
+
+        if (NewHealth != Card.CurrentHealth)
+        {
+            SetBattlefieldCardStats(Index, bIsPlayerSide, Card.CurrentAttack, NewHealth);
+        }
+        if (NewHealth <= 0)
+        {
+            DeadUniqueIDs.Add(Tick.UniqueID);
+        }
+    }
+
+    KCK_TRACE_BROADCAST();
+    for (const FCardStatusTick& Tick : Ticks)
+    {
+        OnCardStatusChanged.Broadcast(Tick.UniqueID);
+    }
+
+    // Death sweep after every creature has taken its share
+    for (int32 UniqueID : DeadUniqueIDs)
+    {
+        const int32 Index = FindBattlefieldIndexByUniqueID(UniqueID, bIsPlayerSide);
+        if (Index != INDEX_NONE)
+        {
+            RemoveCardFromBattlefield(Index, bIsPlayerSide);
+        }
+    }
+
+    NoteBattlefieldMemory();
+}
+
+// ==== TRIGGERS ====
+
+bool ACombatManager::RegisterCardTriggers(const FCardData& Card, int32 SourceID, bool bIsPlayerOwned)
+{
+    if (Card.AbilityID <= 0 || !HandManager)
+    {
+        return false;
+    }
+
+    ECardTriggerSide Side = ECardTriggerSide::Any;
+    const ECardTriggerEvent Event = HandManager->GetCatalog()->GetAbilityTrigger(Card.AbilityID, &Side);
+    if (Event == ECardTriggerEvent::None)
+    {
+        return false;
+    }
+
+    FCardTriggerSubscription Subscription;
+    Subscription.SourceID = SourceID;
+    Subscription.AbilityID = Card.AbilityID;
+    Subscription.bIsPlayerOwned = bIsPlayerOwned;
+    Subscription.Side = Side;
+    Subscription.SourceCard = Card;
+    TriggerRegistry.Register(Event, MoveTemp(Subscription));
+
+    KCK_LOG_HOT(LogKevesCardKitAbility, Verbose, TEXT("[CombatManager] '%s' (ID:%d) listens for trigger event %d"),
+        *Card.Name.ToString(), SourceID, (int32)Event);
+    return true;
+}
+
+void ACombatManager::DispatchCardTrigger(ECardTriggerEvent Event, bool bIsPlayerSide)
+{
+    if (TriggerRegistry.GetNumSubscribers(Event) == 0 || !HandManager)
+    {
+        return;
+    }
+
+    if (TriggerDepth >= MaxTriggerDepth)
+    {
+        UE_LOG(LogKevesCardKitAbility, Warning, TEXT("[CombatManager] Trigger event %d skipped - %d nested triggers (loop?)"), (int32)Event, TriggerDepth);
+        return;
+    }
+
+    KCK_TRACE_SCOPE(KCK_DispatchTrigger);
+
+    // Work on a copy: abilities can summon, kill or banish, which registers and unregisters permanents
+    TArray<FCardTriggerSubscription, TInlineAllocator<8>> Subscribers;
+    TriggerRegistry.GatherSubscribers(Event, bIsPlayerSide, Subscribers);
+
+    const FCardCatalog::FRef Catalog = HandManager->GetCatalog();
+
+    TriggerDepth++;
+    for (FCardTriggerSubscription& Subscription : Subscribers)
+    {
+        // An earlier trigger in this dispatch may have removed the permanent or ended the combat
+        if (!TriggerRegistry.IsRegistered(Subscription.SourceID))
+        {
+            continue;
+        }
+        if (!IsCombatActive())
+        {
+            break;
+        }
+
+        FCardAbilityContext Context;
+        Context.HandManager = HandManager;
+        Context.CombatManager = this;
+        Context.bCasterIsPlayer = Subscription.bIsPlayerOwned;
+        Context.SourceCard = &Subscription.SourceCard;
+        Context.SourceUniqueID = Subscription.SourceID;
+        KCKAbility::Execute(*Catalog, Subscription.AbilityID, Context);
+    }
+    TriggerDepth--;
+}
+
+// ==== STATE HASHING / SEARCH ====
+
+int64 ACombatManager::GetCombatStateHash() const
+{
+    FCombatStateHash Combined = StateHash;
+
+    if (HandManager)
+    {
+        Combined ^= HandManager->GetPileHash();
+    }
+
+    if (EnemyAIComponent)
+    {
+        Combined ^= EnemyAIComponent->GetStateHash();
+    }
+
+    return (int64)Combined.GetValue();
+}
+
+FCombatTranspositionStats ACombatManager::GetTranspositionStats() const
+{
+    return TranspositionCache.IsValid() ? TranspositionCache->GetStats() : FCombatTranspositionStats();
+}
+
+float ACombatManager::EstimatePlayerWinProbability() const
+{
+    if (!WinProbabilityModel)
+    {
+        return 0.5f;
+    }
+
+    // Scores are stored in millionths; the model is part of the key so swapping it never reads stale scores
+    static constexpr float ScoreScale = 1000000.0f;
+    const uint64 Key = (uint64)GetCombatStateHash() ^ (uint64)GetTypeHash(WinProbabilityModel);
+
+    const TSharedPtr<FCombatTranspositionCache, ESPMode::ThreadSafe> Cache = GetTranspositionCache();
+    FCombatTranspositionEntry Entry;
+    if (Cache->Probe(Key, Entry))
+    {
+        return Entry.Score / ScoreScale;
+    }
+
+    const float Probability = WinProbabilityModel->Evaluate(FCombatFeatures::FromCombat(*this));
+    Entry.Score = FMath::RoundToInt(Probability * ScoreScale);
+    Entry.BestMove = -1;
+    Entry.Depth = 0;
+    Cache->Store(Key, Entry);
+    return Probability;
+}
+
+void ACombatManager::RebuildCombatStateHash()
+{
+    StateHash.Reset();
+    StateHash.ToggleScalar(ECombatHashScalar::PlayerEnergy, CurrentEnergy);
+    StateHash.ToggleScalar(ECombatHashScalar::PlayerHealth, PlayerHealth);
+    StateHash.ToggleScalar(ECombatHashScalar::EnemyHealth, CurrentEnemy.Health);
+    StateHash.ToggleScalar(ECombatHashScalar::CombatState, (int32)CurrentState);
+
+    for (const FBattlefieldCard& Card : PlayerBattlefield)
+    {
+        AddCreatureToHash(true, Card);
+    }
+    for (const FBattlefieldCard& Card : EnemyBattlefield)
+    {
+        AddCreatureToHash(false, Card);
+    }
+}
+
+TSharedPtr<FCombatTranspositionCache, ESPMode::ThreadSafe> ACombatManager::GetTranspositionCache() const
+{
+    // Created on first use so level-placed managers that never search pay nothing
+    if (!TranspositionCache.IsValid())
+    {
+        TranspositionCache = MakeShared<FCombatTranspositionCache, ESPMode::ThreadSafe>(TranspositionCacheSize);
+    }
+    return TranspositionCache;
+}
+
+void ACombatManager::ApplyEnergyChange(int32 NewEnergy)
+{
+    const int32 OldEnergy = CurrentEnergy;
+    StateHash.ChangeScalar(ECombatHashScalar::PlayerEnergy, OldEnergy, NewEnergy);
+    CurrentEnergy = NewEnergy;
+
+    // Always push so the hand's playability mask is valid even if energy did not change
+    if (HandManager)
+    {
+        HandManager->SetAvailableEnergy(NewEnergy);
+    }
+
+    if (OldEnergy != NewEnergy)
+    {
+        KCK_TRACE_BROADCAST();
+        OnEnergyChanged.Broadcast(NewEnergy, MaxEnergyPerTurn);
+    }
+}
+
+void ACombatManager::ApplyPlayerHealthChange(int32 NewHealth)
+{
+    StateHash.ChangeScalar(ECombatHashScalar::PlayerHealth, PlayerHealth, NewHealth);
+    PlayerHealth = NewHealth;
+}
+
+void ACombatManager::ApplyEnemyHealthChange(int32 NewHealth)
+{
+    StateHash.ChangeScalar(ECombatHashScalar::EnemyHealth, CurrentEnemy.Health, NewHealth);
+    CurrentEnemy.Health = NewHealth;
+}
@@ -5,11 +5,22 @@
 #include "CardTypesHost.h"
 #include "CombatTypes.h"
 #include "EnemyAIComponent.h"
+#include "CombatStateHash.h"
+#include "CombatMetrics.h"
+#include "CardTriggerRegistry.h"
+#include "CardTargetSelector.h"
+#include "CardStatusEffects.h"
+#include "CardModifierLayers.h"
+#include "KevesCardKitMemory.h"
+#include "RunSave.h"
+#include "CombatJournal.h"
 #include "CombatManager.generated.h"
 
 // Forward declarations to avoid circular dependencies
 class AHandManager;
 class UCombatUIWidget;
+class UCombatEvaluatorModel;
+class UCombatSequencer;
 
 // Structure to represent a card on the battlefield
 USTRUCT(BlueprintType)
@@ -89,15 +100,22 @@ struct FEnemyData
 
     UPROPERTY(EditAnywhere, BlueprintReadWrite)
     FText FlavorText;
+
+    // Optional offline-baked policy for this deck, used when the enemy AI runs in PolicyTable mode
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    class UEnemyPolicyTable* PolicyTable = nullptr;
 };
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnCombatStateChanged, ECombatState, NewState);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnHealthChanged, bool, bIsPlayer, int32, NewHealth);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnEnergyChanged, int32, NewEnergy, int32, MaxEnergy);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FOnCreatureSummoned, const FBattlefieldCard&, Card, int32, Index, bool, bPlayerOwned);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnCreatureRemoved, int32, Index, bool, bPlayerOwned);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnBattlefieldDelta, const FBattlefieldDelta&, Delta);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FOnCardDamaged, int32, BattlefieldIndex, int32, DamageAmount, bool, bIsPlayerSide);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnCardDamagedByUniqueID, int32, UniqueID, int32, DamageAmount);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FOnCardBanishedSignature, const FCardData&, Card, bool, bWasSummoned, int32, UniqueID);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnCardStatusChanged, int32, UniqueID);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FOnCardDiscardedSignature, const FCardData&, Card, bool, bWasSummoned, int32, UniqueID);
 
 UCLASS(BlueprintType, Blueprintable)
@@ -163,6 +181,10 @@ public:
     UPROPERTY(BlueprintAssignable, Category = "Combat")
     FOnCardDiscardedSignature OnCardDiscarded;
 
+    // A creature's status effects were applied, ticked, absorbed damage or expired (read them with GetStatusEffectAmount)
+    UPROPERTY(BlueprintAssignable, Category = "Combat|Events")
+    FOnCardStatusChanged OnCardStatusChanged;
+
     // References
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "References")
     class AHandManager* HandManager;
@@ -178,12 +200,24 @@ public:
     UPROPERTY(BlueprintAssignable, Category = "Events")
     FOnHealthChanged OnHealthChanged;
 
+    // Fires whenever CurrentEnergy changes (spend, refill, SetPlayerEnergy)
+    UPROPERTY(BlueprintAssignable, Category = "Events")
+    FOnEnergyChanged OnEnergyChanged;
+
     UPROPERTY(BlueprintAssignable, Category = "Combat|Events")
     FOnCreatureSummoned OnCreatureSummoned;
 
     UPROPERTY(BlueprintAssignable, Category = "Combat|Events")
     FOnCreatureRemoved OnCreatureRemoved;
 
+    // Every battlefield add/stat change/removal, in order. Late consumers can catch up with GetBattlefieldDeltasSince.
+    UPROPERTY(BlueprintAssignable, Category = "Combat|Events")
+    FOnBattlefieldDelta OnBattlefieldDelta;
+
+    // Number of recent deltas kept for GetBattlefieldDeltasSince (read when the first delta is recorded)
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Combat|Events")
+    int32 BattlefieldDeltaHistorySize = 256;
+
     // ==== BLUEPRINT CALLABLE FUNCTIONS FOR DEVELOPERS ====
 
     UFUNCTION(BlueprintCallable, Category = "Infernal Contracts|Combat")
@@ -237,6 +271,21 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Infernal Contracts|Combat", CallInEditor)
     bool DamageSpecificBattlefieldCard(int32 BattlefieldIndex, bool bIsPlayerSide, int32 Damage);
 
+    // Raise (or lower) a creature's current attack and health; a creature buffed to 0 health dies
+    UFUNCTION(BlueprintCallable, Category = "Infernal Contracts|Combat")
+    bool BuffBattlefieldCard(int32 BattlefieldIndex, bool bIsPlayerSide, int32 AttackDelta, int32 HealthDelta);
+
+    // Restore health up to the card's printed health plus modifiers (never lowers a buffed creature)
+    UFUNCTION(BlueprintCallable, Category = "Infernal Contracts|Combat")
+    bool HealBattlefieldCard(int32 BattlefieldIndex, bool bIsPlayerSide, int32 Amount);
+
+    // Batch paths for selector results (see KCKTargeting::Select). Creatures are resolved up front, so
+    // deaths and triggers during the batch cannot redirect it. Hand slots are only affected by buffs,
+    // which are stored as modifiers on each card instance (see FCardModifierLayers).
+    void DamageTargets(const FCardTargetSet& Targets, int32 Damage);
+    void HealTargets(const FCardTargetSet& Targets, int32 Amount);
+    void BuffTargets(const FCardTargetSet& Targets, int32 AttackDelta, int32 HealthDelta);
+
     // NEW: Unique ID based functions
     UFUNCTION(BlueprintCallable, Category = "Infernal Contracts|Combat")
     bool DamageBattlefieldCardByUniqueID(int32 UniqueID, int32 Damage);
@@ -254,6 +303,13 @@ public:
     UFUNCTION(BlueprintPure, Category = "Infernal Contracts|Combat")
     bool IsCombatActive() const { return CurrentState == ECombatState::PlayerTurn || CurrentState == ECombatState::EnemyTurn; }
 
+    // Copies of a card a side has played since its turn started (the "Copies" value of X-cards)
+    UFUNCTION(BlueprintPure, Category = "Infernal Contracts|Combat")
+    int32 GetCopiesPlayedThisTurn(int32 CardID, bool bIsPlayerSide) const;
+
+    // Count a play; called before the card's ability runs so the card sees itself
+    void NoteCardPlayedThisTurn(int32 CardID, bool bIsPlayerSide);
+
     UFUNCTION(BlueprintPure, Category = "Infernal Contracts|Combat")
     float GetPlayerHealthPercent() const { return PlayerMaxHealth > 0 ? (float)PlayerHealth / PlayerMaxHealth : 0.0f; }
 
@@ -276,17 +332,60 @@ public:
     float GetEnemyHealthPercent() const { return CurrentEnemy.MaxHealth > 0 ? (float)CurrentEnemy.Health / CurrentEnemy.MaxHealth : 0.0f; }
 
     UFUNCTION(BlueprintPure, Category = "Infernal Contracts|Combat")
-    bool HasPlayerCardsWithHealth() const;
+    bool HasPlayerCardsWithHealth() const { return PlayerSummary.LivingCount > 0; }
 
     UFUNCTION(BlueprintPure, Category = "Infernal Contracts|Combat")
-    bool HasEnemyCardsWithHealth() const;
+    bool HasEnemyCardsWithHealth() const { return EnemySummary.LivingCount > 0; }
 
+    // Full copies - prefer the per-field queries below in hot Blueprint logic
     UFUNCTION(BlueprintPure, Category = "Infernal Contracts|Combat")
     TArray<FBattlefieldCard> GetPlayerBattlefield() const { return PlayerBattlefield; }
 
     UFUNCTION(BlueprintPure, Category = "Infernal Contracts|Combat")
     TArray<FBattlefieldCard> GetEnemyBattlefield() const { return EnemyBattlefield; }
 
+    // ==== BATTLEFIELD QUERIES ====
+
+    // C++ read-only access without copying
+    TConstArrayView<FBattlefieldCard> GetBattlefieldView(bool bIsPlayerSide) const { return bIsPlayerSide ? PlayerBattlefield : EnemyBattlefield; }
+
+    // O(1) lookup by UniqueID; nullptr if the card is not on either battlefield
+    const FBattlefieldCard* FindBattlefieldCard(int32 UniqueID, bool* bOutIsPlayerSide = nullptr) const;
+
+    // Per-field reads by UniqueID handle. Unknown handles return -1.
+    UFUNCTION(BlueprintPure, Category = "Infernal Contracts|Battlefield")
+    int32 GetBattlefieldCardHealth(int32 UniqueID) const;
+
+    UFUNCTION(BlueprintPure, Category = "Infernal Contracts|Battlefield")
+    int32 GetBattlefieldCardAttack(int32 UniqueID) const;
+
+    // Card definition ID (FCardData::ID) of the card with this handle
+    UFUNCTION(BlueprintPure, Category = "Infernal Contracts|Battlefield")
+    int32 GetBattlefieldCardDefinitionID(int32 UniqueID) const;
+
+    UFUNCTION(BlueprintPure, Category = "Infernal Contracts|Battlefield")
+    bool IsOnBattlefield(int32 UniqueID) const { return FindBattlefieldCard(UniqueID) != nullptr; }
+
+    UFUNCTION(BlueprintPure, Category = "Infernal Contracts|Battlefield")
+    int32 GetBattlefieldCardCount(bool bIsPlayerSide) const { return GetBattlefieldView(bIsPlayerSide).Num(); }
+
+    // Handle of the card in a slot (-1 if the slot is empty), for iterating without copying the array
+    UFUNCTION(BlueprintPure, Category = "Infernal Contracts|Battlefield")
+    int32 GetBattlefieldUniqueIDAt(int32 BattlefieldIndex, bool bIsPlayerSide) const;
+
+    // Living slots by card type and faction, for target selectors (rebuilt lazily after battlefield changes)
+    const FCardZoneMasks& GetBattlefieldMasks(bool bIsPlayerSide) const;
+
+    UFUNCTION(BlueprintPure, Category = "Infernal Contracts|Battlefield")
+    FBattlefieldSummary GetBattlefieldSummary(bool bIsPlayerSide) const { return bIsPlayerSide ? PlayerSummary : EnemySummary; }
+
+    UFUNCTION(BlueprintPure, Category = "Infernal Contracts|Battlefield")
+    int32 GetLivingCreatureCount(bool bIsPlayerSide) const { return GetBattlefieldSummary(bIsPlayerSide).LivingCount; }
+
+    UFUNCTION(BlueprintPure, Category = "Infernal Contracts|Battlefield")
+    int32 GetTotalBattlefieldAttack(bool bIsPlayerSide) const { return GetBattlefieldSummary(bIsPlayerSide).TotalAttack; }
+
+    // Resolves a card AHandManager::PlayCard has already paid for (CardPlayed triggers, summon, powers)
     UFUNCTION(BlueprintCallable, Category = "Infernal Contracts|Combat")
     void OnCardPlayed(const FCardData& PlayedCard);
 
@@ -323,4 +422,258 @@ public:
 
     UFUNCTION(BlueprintCallable, Category = "Infernal Contracts|Combat")
     int32 FindBattlefieldIndexByUniqueID(int32 UniqueID, bool bIsPlayerSide) const;
-};
\ No newline at end of file
+
+    // Sequence number of the newest battlefield delta (0 = none yet)
+    UFUNCTION(BlueprintPure, Category = "Infernal Contracts|Combat")
+    int32 GetBattlefieldSequence() const { return NextBattlefieldSequence - 1; }
+
+    // Append every delta newer than LastSequence. Returns false if some of them have already
+    // dropped out of the history, in which case the caller should resync from the full battlefield.
+    UFUNCTION(BlueprintCallable, Category = "Infernal Contracts|Combat")
+    bool GetBattlefieldDeltasSince(int32 LastSequence, TArray<FBattlefieldDelta>& OutDeltas) const;
+
+    // ==== STATUS EFFECTS ====
+
+    // Stack a status effect on a battlefield creature. Turns = 0 lasts until used up (armor) or decayed (poison).
+    UFUNCTION(BlueprintCallable, Category = "Infernal Contracts|Status Effects")
+    bool ApplyStatusEffect(int32 UniqueID, ECardStatusEffect Effect, int32 Amount, int32 Turns = 0);
+
+    void ApplyStatusToTargets(const FCardTargetSet& Targets, ECardStatusEffect Effect, int32 Amount, int32 Turns);
+
+    UFUNCTION(BlueprintPure, Category = "Infernal Contracts|Status Effects")
+    int32 GetStatusEffectAmount(int32 UniqueID, ECardStatusEffect Effect) const { return StatusEffects.GetAmount(Effect, UniqueID); }
+
+    // ==== MODIFIERS ====
+
+    // Aura over every card in the scope's zones (relative to the caster) and card types, including cards that arrive later.
+    // Faction and health filters are ignored. SourceID ties the aura to a permanent; -1 lasts until removed or the combat ends.
+    int32 AddAura(const FCardTargetSelector& Scope, bool bCasterIsPlayer, int32 AttackDelta, int32 HealthDelta, int32 CostDelta, int32 SourceID = -1);
+
+    // Remove an aura or buff by the handle AddAura returned
+    UFUNCTION(BlueprintCallable, Category = "Infernal Contracts|Modifiers")
+    void RemoveCardModifier(int32 ModifierID);
+
+    const FCardModifierLayers& GetModifierLayers() const { return ModifierLayers; }
+
+    // Hand cards are instances too (called by AHandManager). Register writes the card's effective stats into InOutCard.
+    void RegisterHandInstance(int32 InstanceID, FCardData& InOutCard);
+    void UnregisterHandInstance(int32 InstanceID) { ModifierLayers.RemoveInstance(InstanceID); }
+
+    // Stats a hand card takes into play: buffs on the card itself stay, hand auras do not. Cost is left as paid.
+    void GetCarriedCardStats(int32 InstanceID, FCardData& InOutCard) const;
+
+    // ==== TRIGGERS ====
+
+    // Run every registered triggered ability listening to this event (cost is proportional to its subscribers)
+    UFUNCTION(BlueprintCallable, Category = "Infernal Contracts|Triggers")
+    void DispatchCardTrigger(ECardTriggerEvent Event, bool bIsPlayerSide);
+
+    UFUNCTION(BlueprintPure, Category = "Infernal Contracts|Triggers")
+    int32 GetTriggerSubscriberCount(ECardTriggerEvent Event) const { return TriggerRegistry.GetNumSubscribers(Event); }
+
+    // Register the card's triggered ability, if it has one, for a permanent entering play. Returns true if registered.
+    bool RegisterCardTriggers(const FCardData& Card, int32 SourceID, bool bIsPlayerOwned);
+
+    // Called when a permanent leaves play
+    void UnregisterCardTriggers(int32 SourceID) { TriggerRegistry.Unregister(SourceID); }
+
+    // ==== RUN ====
+
+    // Start an encounter of a run: player health and the upgraded deck come from Run, and the combat's
+    // random stream is seeded from the run's stream, which advances
+    UFUNCTION(BlueprintCallable, Category = "Infernal Contracts|Run")
+    void StartRunCombat(const FEnemyData& Enemy, UPARAM(ref) FRunState& Run);
+
+    // Copy what a combat changes (player health) back into the run
+    UFUNCTION(BlueprintCallable, Category = "Infernal Contracts|Run")
+    void WriteRunState(UPARAM(ref) FRunState& Run) const;
+
+    // Seed of StartCombat's random stream; 0 picks a new seed for each combat
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Infernal Contracts|Run")
+    int32 CombatSeed = 0;
+
+    // Seed the current (or last) combat started from
+    UFUNCTION(BlueprintPure, Category = "Infernal Contracts|Run")
+    int32 GetActiveCombatSeed() const { return ActiveCombatSeed; }
+
+    // Shuffles, random targets and fallback rolls all draw from this, so the seed reproduces a combat
+    FRandomStream& GetCombatRandom() const { return CombatRandom; }
+
+    // Journal StartRunCombat's combats next to the run save of this slot so a crash can resume mid-combat
+    // (see FCombatJournal); empty disables the journal
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Infernal Contracts|Run")
+    FString CombatJournalSlot = TEXT("Run");
+
+    // After a crash: the run as it was when the unfinished journaled combat began. Pick that encounter's
+    // enemy from it, then call ResumeRunCombat.
+    UFUNCTION(BlueprintCallable, Category = "Infernal Contracts|Run")
+    bool FindUnfinishedRunCombat(FRunState& OutRun) const;
+
+    // Restart the journaled combat against Enemy and replay its actions up to the last one written.
+    // OutRun receives the run as StartRunCombat left it. False if there is no journal or it is for another enemy.
+    UFUNCTION(BlueprintCallable, Category = "Infernal Contracts|Run")
+    bool ResumeRunCombat(const FEnemyData& Enemy, FRunState& OutRun);
+
+    // Write an action to the journal ahead of applying it (called by AHandManager and UEnemyAIComponent)
+    void RecordCombatAction(ECombatJournalAction Action, int32 HandIndex = INDEX_NONE, int32 CardID = 0, AActor* Target = nullptr);
+
+    // ==== PACING ====
+
+    // Advances combat phases once presentation releases its holds (see UCombatSequencer)
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Infernal Contracts|Pacing")
+    UCombatSequencer* CombatSequencer;
+
+    UFUNCTION(BlueprintPure, Category = "Infernal Contracts|Pacing")
+    UCombatSequencer* GetCombatSequencer() const { return CombatSequencer; }
+
+    // ==== METRICS ====
+
+    // Record per-turn timings and counts for each combat (see FCombatMetricsReport)
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Infernal Contracts|Metrics")
+    bool bRecordCombatMetrics = false;
+
+    // Also write each report to Saved/Profiling/KevesCardKit as JSON when the combat ends
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Infernal Contracts|Metrics")
+    bool bWriteCombatMetricsFile = true;
+
+    // Report from the most recent recorded combat
+    UFUNCTION(BlueprintPure, Category = "Infernal Contracts|Metrics")
+    FCombatMetricsReport GetLastCombatMetrics() const { return MetricsRecorder.GetReport(); }
+
+    // Memory currently accounted to the card system (see KevesCardKitMemory.h)
+    UFUNCTION(BlueprintPure, Category = "Infernal Contracts|Metrics")
+    FCardKitMemoryReport GetCardKitMemory() const { return KCKMemory::GetCurrent(); }
+
+    // Card system memory peak of the current combat, or of the last one once it has ended
+    UFUNCTION(BlueprintPure, Category = "Infernal Contracts|Metrics")
+    FCardKitMemoryReport GetCombatMemoryHighWater() const;
+
+    // ==== STATE HASHING / SEARCH ====
+
+    // Number of slots in the shared transposition cache (rounded to a power of two)
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Infernal Contracts|Search")
+    int32 TranspositionCacheSize = 65536;
+
+    // 64-bit hash of battlefield creatures, pile contents, energy and health (O(1) to read)
+    UFUNCTION(BlueprintPure, Category = "Infernal Contracts|Search")
+    int64 GetCombatStateHash() const;
+
+    UFUNCTION(BlueprintPure, Category = "Infernal Contracts|Search")
+    FCombatTranspositionStats GetTranspositionStats() const;
+
+    // Offline-trained model used for win probability (danger meter) and as a search leaf evaluator
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Infernal Contracts|Search")
+    UCombatEvaluatorModel* WinProbabilityModel = nullptr;
+
+    // Estimated chance the player wins from the current state (0.5 when no model is set). Evaluations
+    // are cached in the transposition cache by state hash, so repeated states cost one probe.
+    UFUNCTION(BlueprintPure, Category = "Infernal Contracts|Search")
+    float EstimatePlayerWinProbability() const;
+
+    // Recompute the hash from scratch (only needed if state was edited directly from Blueprint)
+    UFUNCTION(BlueprintCallable, Category = "Infernal Contracts|Search")
+    void RebuildCombatStateHash();
+
+    // Shared cache for search threads; hold the returned pointer for the duration of a search
+    TSharedPtr<FCombatTranspositionCache, ESPMode::ThreadSafe> GetTranspositionCache() const;
+
+private:
+    // Route all energy/health writes through these so the state hash stays in sync
+    void ApplyEnergyChange(int32 NewEnergy);
+    void ApplyPlayerHealthChange(int32 NewHealth);
+    void ApplyEnemyHealthChange(int32 NewHealth);
+
+    // Record a delta in the history ring and broadcast it
+    void EmitBattlefieldDelta(EBattlefieldDeltaType Type, const FBattlefieldCard& Card, int32 BattlefieldIndex, bool bIsPlayerSide);
+
+    TArray<FBattlefieldDelta> BattlefieldDeltaRing;
+    int32 NextBattlefieldSequence = 1;
+
+    // Write new stats for a slot, keeping hash and summary in sync, and emit a StatsChanged delta
+    void SetBattlefieldCardStats(int32 BattlefieldIndex, bool bIsPlayerSide, int32 NewAttack, int32 NewHealth);
+
+    // Add (Sign = 1) or remove (Sign = -1) a card's contribution to its side's summary
+    void AccumulateBattlefieldSummary(bool bIsPlayerSide, const FBattlefieldCard& Card, int32 Sign);
+
+    // Recompute summaries and the UniqueID lookup from the battlefield arrays
+    void RebuildBattlefieldLookup();
+
+    FBattlefieldSummary PlayerSummary;
+    FBattlefieldSummary EnemySummary;
+
+    // Cache for GetBattlefieldMasks, valid while BattlefieldMasksSequence matches the delta sequence
+    mutable FCardZoneMasks BattlefieldMasks[2];
+    mutable int32 BattlefieldMasksSequence = -1;
+
+    // UniqueIDs of the selected slots on one side, highest slot first
+    void GatherTargetUniqueIDs(const FCardTargetSet& Targets, TArray<TPair<int32, bool>, TInlineAllocator<16>>& OutCreatures) const;
+
+    FCombatMetricsRecorder MetricsRecorder;
+
+    FCardTriggerRegistry TriggerRegistry;
+
+    FCardStatusEffects StatusEffects;
+
+    FCardModifierLayers ModifierLayers;
+
+    // Drawing from the stream does not change combat state, hence mutable (see GetCombatRandom)
+    mutable FRandomStream CombatRandom;
+    int32 ActiveCombatSeed = 0;
+
+    // Set by StartRunCombat for the duration of its StartCombat call
+    const TArray<FRunDeckCard>* PendingRunDeck = nullptr;
+
+    FCombatJournal CombatJournal;
+
+    // Run as the journaled combat left StartRunCombat; folded into the run save when the combat ends
+    FRunState JournalRun;
+
+    // Re-apply journaled actions synchronously, then let the turn carry on from where they stop
+    void ReplayCombatJournal(TConstArrayView<FCombatJournalRecord> Records);
+
+    // Battlefield actor or enemy for a journaled target (null if the creature has no actor in the world)
+    AActor* ResolveJournalTarget(const FCombatJournalRecord& Record) const;
+
+    // Save the run with the combat's outcome, then drop the journal once that save is on disk
+    void CompactCombatJournal();
+
+    // CardID -> plays this turn, [0] enemy / [1] player; cleared when that side's turn starts
+    TMap<int32, int32> CopiesPlayedThisTurn[2];
+
+    // Push stats changed by the modifier layers into the battlefield and hand
+    void ApplyModifierChanges(const FCardModifierLayers::FChanges& Changes);
+
+    // Health a heal can restore a creature to: printed health plus modifiers, never below its current health
+    int32 GetHealCap(const FBattlefieldCard& Card) const;
+
+    // Start-of-turn status pass for one side: combined damage/healing per creature, then one death sweep
+    void ProcessStatusEffects(bool bIsPlayerSide);
+
+    // Nesting of DispatchCardTrigger (a trigger's ability raising another event); capped to stop loops
+    int32 TriggerDepth = 0;
+    static constexpr int32 MaxTriggerDepth = 8;
+
+    // Report battlefield arrays, lookups and delta history to KCKMemory
+    void NoteBattlefieldMemory() const;
+
+    FCardKitMemoryReport LastCombatMemoryHighWater;
+
+    // UniqueID -> battlefield index, per side. Kept in step by UpdateBattlefieldIndices.
+    TMap<int32, int32> PlayerSlotByUniqueID;
+    TMap<int32, int32> EnemySlotByUniqueID;
+
+    // Add or remove one creature, with its current stats, in the state hash
+    void AddCreatureToHash(bool bIsPlayerSide, const FBattlefieldCard& Card)
+    {
+        StateHash.AddBattlefieldCreature(bIsPlayerSide, Card.CardData.ID, Card.CurrentHealth, Card.CurrentAttack);
+    }
+    void RemoveCreatureFromHash(bool bIsPlayerSide, const FBattlefieldCard& Card)
+    {
+        StateHash.RemoveBattlefieldCreature(bIsPlayerSide, Card.CardData.ID, Card.CurrentHealth, Card.CurrentAttack);
+    }
+
+    FCombatStateHash StateHash;
+
+    // Created on first use, also from const evaluators
+    mutable TSharedPtr<FCombatTranspositionCache, ESPMode::ThreadSafe> TranspositionCache;
+};
@@ -0,0 +1,164 @@
+// CombatMetrics.cpp - Per-combat performance report
+#include "CombatMetrics.h"
+#include "KevesCardKitLog.h"
+#include "KevesCardKitTrace.h"
+#include "JsonObjectConverter.h"
+#include "Misc/App.h"
+#include "Misc/DateTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "ProfilingDebugging/CsvProfiler.h"
+
+CSV_DEFINE_CATEGORY(KevesCardKit, true);
+
+FCombatMetricsRecorder::~FCombatMetricsRecorder()
+{
+    StopListening();
+}
+
+void FCombatMetricsRecorder::BeginCombat(const FString& EnemyName)
+{
+    Report = FCombatMetricsReport();
+    Report.EnemyName = EnemyName;
+    Report.BuildVersion = FString::Printf(TEXT("%s %s"), FApp::GetBuildVersion(), LexToString(FApp::GetBuildConfiguration()));
+
+    bRecording = true;
+    bTurnOpen = false;
+    ObjectsAllocated = 0;
+
+    if (!bListening)
+    {
+        GUObjectArray.AddUObjectCreateListener(this);
+        bListening = true;
+    }
+
+    CSV_EVENT(KevesCardKit, TEXT("CombatStart %s"), *EnemyName);
+}
+
+void FCombatMetricsRecorder::BeginTurn(bool bPlayerTurn)
+{
+    if (!bRecording)
+    {
+        return;
+    }
+
+    EndTurn();
+
+    CurrentTurn = FCombatTurnMetrics();
+    CurrentTurn.TurnIndex = Report.Turns.Num();
+    CurrentTurn.bPlayerTurn = bPlayerTurn;
+
+    TurnStartSeconds = FPlatformTime::Seconds();
+    TurnStartObjects = ObjectsAllocated;
+    bTurnOpen = true;
+}
+
+void FCombatMetricsRecorder::EndTurn()
+{
+    if (!bRecording || !bTurnOpen)
+    {
+        return;
+    }
+    bTurnOpen = false;
+
+    // KCKTrace tallies are zeroed at every turn start, so they hold exactly this turn's work
+    const KCKTrace::FTurnCounts& Counts = KCKTrace::GTurnCounts;
+    CurrentTurn.WallTimeMs = (float)((FPlatformTime::Seconds() - TurnStartSeconds) * 1000.0);
+    CurrentTurn.WorkTimeMs = (float)FPlatformTime::ToMilliseconds64(Counts.WorkCycles);
+    CurrentTurn.CardsDrawn = Counts.CardsDrawn;
+    CurrentTurn.EffectsResolved = Counts.EffectsResolved;
+    CurrentTurn.BroadcastsFired = Counts.BroadcastsFired;
+    CurrentTurn.ActorsSpawned = Counts.ActorsSpawned;
+    CurrentTurn.ObjectsAllocated = ObjectsAllocated - TurnStartObjects;
+
+    Report.Turns.Add(CurrentTurn);
+
+    CSV_CUSTOM_STAT(KevesCardKit, TurnWallMs, CurrentTurn.WallTimeMs, ECsvCustomStatOp::Set);
+    CSV_CUSTOM_STAT(KevesCardKit, TurnWorkMs, CurrentTurn.WorkTimeMs, ECsvCustomStatOp::Set);
+    CSV_CUSTOM_STAT(KevesCardKit, EffectsResolved, CurrentTurn.EffectsResolved, ECsvCustomStatOp::Set);
+    CSV_CUSTOM_STAT(KevesCardKit, BroadcastsFired, CurrentTurn.BroadcastsFired, ECsvCustomStatOp::Set);
+    CSV_CUSTOM_STAT(KevesCardKit, ActorsSpawned, CurrentTurn.ActorsSpawned, ECsvCustomStatOp::Set);
+    CSV_CUSTOM_STAT(KevesCardKit, ObjectsAllocated, CurrentTurn.ObjectsAllocated, ECsvCustomStatOp::Set);
+}
+
+const FCombatMetricsReport& FCombatMetricsRecorder::EndCombat(bool bPlayerWon)
+{
+    if (!bRecording)
+    {
+        return Report;
+    }
+
+    EndTurn();
+    StopListening();
+    bRecording = false;
+
+    Report.bPlayerWon = bPlayerWon;
+    for (const FCombatTurnMetrics& Turn : Report.Turns)
+    {
+        Report.TotalWallTimeMs += Turn.WallTimeMs;
+        Report.TotalWorkTimeMs += Turn.WorkTimeMs;
+        Report.TotalCardsDrawn += Turn.CardsDrawn;
+        Report.TotalEffectsResolved += Turn.EffectsResolved;
+        Report.TotalBroadcastsFired += Turn.BroadcastsFired;
+        Report.TotalActorsSpawned += Turn.ActorsSpawned;
+        Report.TotalObjectsAllocated += Turn.ObjectsAllocated;
+    }
+
+    CSV_EVENT(KevesCardKit, TEXT("CombatEnd %s"), bPlayerWon ? TEXT("Won") : TEXT("Lost"));
+
+    return Report;
+}
+
+void FCombatMetricsRecorder::NotePileSizes(int32 HandSize, int32 DeckSize, int32 DiscardSize)
+{
+    Report.PeakHandSize = FMath::Max(Report.PeakHandSize, HandSize);
+    Report.PeakDeckSize = FMath::Max(Report.PeakDeckSize, DeckSize);
+    Report.PeakDiscardSize = FMath::Max(Report.PeakDiscardSize, DiscardSize);
+}
+
+void FCombatMetricsRecorder::NoteBattlefieldSize(int32 NumCards)
+{
+    Report.PeakBattlefieldSize = FMath::Max(Report.PeakBattlefieldSize, NumCards);
+}
+
+FString FCombatMetricsRecorder::WriteReportFile(const FCombatMetricsReport& InReport)
+{
+    FString Json;
+    if (!FJsonObjectConverter::UStructToJsonObjectString(InReport, Json))
+    {
+        UE_LOG(LogKevesCardKit, Warning, TEXT("[CombatMetrics] Failed to serialize combat metrics report"));
+        return FString();
+    }
+
+    const FString Path = FPaths::Combine(FPaths::ProfilingDir(), TEXT("KevesCardKit"),
+        FString::Printf(TEXT("CombatMetrics_%s.json"), *FDateTime::Now().ToString()));
+
+    if (!FFileHelper::SaveStringToFile(Json, *Path))
+    {
+        UE_LOG(LogKevesCardKit, Warning, TEXT("[CombatMetrics] Failed to write %s"), *Path);
+        return FString();
+    }
+
+    UE_LOG(LogKevesCardKit, Log, TEXT("[CombatMetrics] Wrote %s (%d turns, %.2f ms work)"),
+        *Path, InReport.Turns.Num(), InReport.TotalWorkTimeMs);
+    return Path;
+}
+
+void FCombatMetricsRecorder::NotifyUObjectCreated(const UObjectBase* Object, int32 Index)
+{
+    ObjectsAllocated.fetch_add(1, std::memory_order_relaxed);
+}
+
+void FCombatMetricsRecorder::OnUObjectArrayShutdown()
+{
+    StopListening();
+}
+
+void FCombatMetricsRecorder::StopListening()
+{
+    if (bListening)
+    {
+        GUObjectArray.RemoveUObjectCreateListener(this);
+        bListening = false;
+    }
+}
@@ -0,0 +1,143 @@
+// CombatMetrics.h - Optional per-combat performance report (CSV profiler stats + JSON file)
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/UObjectArray.h"
+#include "KevesCardKitMemory.h"
+#include <atomic>
+#include "CombatMetrics.generated.h"
+
+USTRUCT(BlueprintType)
+struct FCombatTurnMetrics
+{
+    GENERATED_BODY()
+
+    UPROPERTY(BlueprintReadOnly, Category = "Metrics")
+    int32 TurnIndex = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Metrics")
+    bool bPlayerTurn = true;
+
+    // Real time from turn start to turn end, including waits on presentation
+    UPROPERTY(BlueprintReadOnly, Category = "Metrics")
+    float WallTimeMs = 0.0f;
+
+    // Game-thread time spent inside the kit's instrumented scopes (see KCK_TRACE_SCOPE)
+    UPROPERTY(BlueprintReadOnly, Category = "Metrics")
+    float WorkTimeMs = 0.0f;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Metrics")
+    int32 CardsDrawn = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Metrics")
+    int32 EffectsResolved = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Metrics")
+    int32 BroadcastsFired = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Metrics")
+    int32 ActorsSpawned = 0;
+
+    // UObjects created anywhere in the process during the turn (widgets, actors, components, ...)
+    UPROPERTY(BlueprintReadOnly, Category = "Metrics")
+    int32 ObjectsAllocated = 0;
+};
+
+USTRUCT(BlueprintType)
+struct FCombatMetricsReport
+{
+    GENERATED_BODY()
+
+    UPROPERTY(BlueprintReadOnly, Category = "Metrics")
+    FString EnemyName;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Metrics")
+    FString BuildVersion;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Metrics")
+    bool bPlayerWon = false;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Metrics")
+    float TotalWallTimeMs = 0.0f;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Metrics")
+    float TotalWorkTimeMs = 0.0f;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Metrics")
+    int32 TotalCardsDrawn = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Metrics")
+    int32 TotalEffectsResolved = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Metrics")
+    int32 TotalBroadcastsFired = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Metrics")
+    int32 TotalActorsSpawned = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Metrics")
+    int32 TotalObjectsAllocated = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Metrics")
+    int32 PeakHandSize = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Metrics")
+    int32 PeakDeckSize = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Metrics")
+    int32 PeakDiscardSize = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Metrics")
+    int32 PeakBattlefieldSize = 0;
+
+    // Card system memory high-water for the combat (see KCKMemory)
+    UPROPERTY(BlueprintReadOnly, Category = "Metrics")
+    FCardKitMemoryReport PeakMemory;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Metrics")
+    TArray<FCombatTurnMetrics> Turns;
+};
+
+// Collects FCombatMetricsReport for one combat. Owned by ACombatManager; idle unless BeginCombat was called.
+class KEVESCARDKIT_API FCombatMetricsRecorder : public FUObjectArray::FUObjectCreateListener
+{
+public:
+    virtual ~FCombatMetricsRecorder();
+
+    void BeginCombat(const FString& EnemyName);
+    void BeginTurn(bool bPlayerTurn);
+    void EndTurn();
+
+    // Closes any open turn, fills totals and stops recording
+    const FCombatMetricsReport& EndCombat(bool bPlayerWon);
+
+    bool IsRecording() const { return bRecording; }
+
+    void NotePileSizes(int32 HandSize, int32 DeckSize, int32 DiscardSize);
+    void NoteBattlefieldSize(int32 NumCards);
+    void NoteMemoryHighWater(const FCardKitMemoryReport& HighWater) { Report.PeakMemory = HighWater; }
+
+    const FCombatMetricsReport& GetReport() const { return Report; }
+
+    // Write the report to Saved/Profiling/KevesCardKit/CombatMetrics_<timestamp>.json; returns the path or empty on failure
+    static FString WriteReportFile(const FCombatMetricsReport& InReport);
+
+    // FUObjectCreateListener (may be called from loading threads)
+    virtual void NotifyUObjectCreated(const class UObjectBase* Object, int32 Index) override;
+    virtual void OnUObjectArrayShutdown() override;
+
+private:
+    void StopListening();
+
+    FCombatMetricsReport Report;
+    FCombatTurnMetrics CurrentTurn;
+
+    bool bRecording = false;
+    bool bTurnOpen = false;
+    bool bListening = false;
+
+    double TurnStartSeconds = 0.0;
+    int32 TurnStartObjects = 0;
+
+    std::atomic<int32> ObjectsAllocated { 0 };
+};
@@ -0,0 +1,118 @@
+// CombatSequencer.cpp - Presentation-driven combat pacing
+#include "CombatSequencer.h"
+#include "KevesCardKitLog.h"
+#include "Engine/World.h"
+#include "TimerManager.h"
+
+UWorld* UCombatSequencer::GetWorld() const
+{
+    // Outer is the owning ACombatManager; the CDO has no world
+    if (HasAnyFlags(RF_ClassDefaultObject))
+    {
+        return nullptr;
+    }
+    return GetOuter() ? GetOuter()->GetWorld() : nullptr;
+}
+
+int32 UCombatSequencer::AcquirePresentationHold(FName Reason)
+{
+    const int32 Handle = ++NextHoldHandle;
+    ActiveHolds.Add(Handle, Reason);
+    return Handle;
+}
+
+void UCombatSequencer::ReleasePresentationHold(int32 HoldHandle)
+{
+    if (ActiveHolds.Remove(HoldHandle) > 0 && ActiveHolds.Num() == 0 && PendingSteps.Num() > 0)
+    {
+        ScheduleAdvance();
+    }
+}
+
+void UCombatSequencer::RunAfterPresentation(FName StepName, FSimpleDelegate Step)
+{
+    PendingSteps.Add({ StepName, MoveTemp(Step) });
+    ScheduleAdvance();
+}
+
+void UCombatSequencer::CancelAll()
+{
+    PendingSteps.Reset();
+    ActiveHolds.Reset();
+    bAdvanceScheduled = false;
+
+    if (UWorld* World = GetWorld())
+    {
+        World->GetTimerManager().ClearTimer(TimeoutTimerHandle);
+    }
+}
+
+void UCombatSequencer::ScheduleAdvance()
+{
+    if (bAdvanceScheduled)
+    {
+        return;
+    }
+
+    UWorld* World = GetWorld();
+    if (!World)
+    {
+        // No world (e.g. headless use): run immediately
+        TryAdvance();
+        return;
+    }
+
+    bAdvanceScheduled = true;
+    World->GetTimerManager().SetTimerForNextTick(FTimerDelegate::CreateUObject(this, &UCombatSequencer::TryAdvance));
+}
+
+void UCombatSequencer::TryAdvance()
+{
+    bAdvanceScheduled = false;
+
+    UWorld* World = GetWorld();
+
+    while (PendingSteps.Num() > 0)
+    {
+        if (ActiveHolds.Num() > 0)
+        {
+            // Wait for presentation; arm the fallback once per wait
+            if (World && !World->GetTimerManager().IsTimerActive(TimeoutTimerHandle))
+            {
+                World->GetTimerManager().SetTimer(TimeoutTimerHandle, this, &UCombatSequencer::OnPresentationTimeout, PresentationTimeout, false);
+            }
+            return;
+        }
+
+        if (World)
+        {
+            World->GetTimerManager().ClearTimer(TimeoutTimerHandle);
+        }
+
+        FPendingStep Step = PendingSteps[0];
+        PendingSteps.RemoveAt(0);
+        Step.Step.ExecuteIfBound();
+
+        // The step may have started new presentation; give listeners a tick to take holds
+        if (PendingSteps.Num() > 0)
+        {
+            ScheduleAdvance();
+            return;
+        }
+    }
+}
+
+void UCombatSequencer::OnPresentationTimeout()
+{
+    const FName StepName = PendingSteps.Num() > 0 ? PendingSteps[0].Name : NAME_None;
+
+    for (const TPair<int32, FName>& Hold : ActiveHolds)
+    {
+        UE_LOG(LogKevesCardKitCombat, Warning, TEXT("[CombatSequencer] Presentation hold '%s' not released within %.1fs, continuing step '%s'"),
+            *Hold.Value.ToString(), PresentationTimeout, *StepName.ToString());
+    }
+
+    ActiveHolds.Reset();
+    OnStepTimedOut.Broadcast(StepName);
+    TryAdvance();
+}
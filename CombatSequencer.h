@@ -0,0 +1,74 @@
+// CombatSequencer.h - Advances combat flow when presentation reports it is done, with a timeout fallback
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/NoExportTypes.h"
+#include "CombatSequencer.generated.h"
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnSequencerStepTimedOut, FName, StepName);
+
+/**
+ * Gameplay queues steps with RunAfterPresentation(); presentation (widgets, battlefield actors,
+ * Blueprint animations) takes a hold while it is busy and releases it when done. A step runs on
+ * the next tick once no holds are outstanding, or after PresentationTimeout if something never
+ * reports back. Nothing waits on a guessed duration.
+ */
+UCLASS(BlueprintType)
+class KEVESCARDKIT_API UCombatSequencer : public UObject
+{
+    GENERATED_BODY()
+
+public:
+    // Longest a step waits for outstanding holds before forcing them released
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Combat Sequencer")
+    float PresentationTimeout = 5.0f;
+
+    UPROPERTY(BlueprintAssignable, Category = "Combat Sequencer")
+    FOnSequencerStepTimedOut OnStepTimedOut;
+
+    // === PRESENTATION SIDE ===
+
+    // Call when an animation/effect starts. Returns a handle to pass to ReleasePresentationHold.
+    UFUNCTION(BlueprintCallable, Category = "Combat Sequencer")
+    int32 AcquirePresentationHold(FName Reason);
+
+    // Call when the animation/effect finishes. Unknown or already released handles are ignored.
+    UFUNCTION(BlueprintCallable, Category = "Combat Sequencer")
+    void ReleasePresentationHold(int32 HoldHandle);
+
+    UFUNCTION(BlueprintPure, Category = "Combat Sequencer")
+    bool IsWaitingForPresentation() const { return ActiveHolds.Num() > 0; }
+
+    UFUNCTION(BlueprintPure, Category = "Combat Sequencer")
+    int32 GetPendingStepCount() const { return PendingSteps.Num(); }
+
+    // === GAMEPLAY SIDE ===
+
+    // Queue a step to run once presentation is idle. Steps run in the order they were queued.
+    void RunAfterPresentation(FName StepName, FSimpleDelegate Step);
+
+    // Drop all queued steps and holds (e.g. when combat ends)
+    UFUNCTION(BlueprintCallable, Category = "Combat Sequencer")
+    void CancelAll();
+
+    virtual UWorld* GetWorld() const override;
+
+private:
+    struct FPendingStep
+    {
+        FName Name;
+        FSimpleDelegate Step;
+    };
+
+    // Schedule TryAdvance for the next tick so listeners of the event that queued the step can take holds
+    void ScheduleAdvance();
+    void TryAdvance();
+    void OnPresentationTimeout();
+
+    TArray<FPendingStep> PendingSteps;
+    TMap<int32, FName> ActiveHolds;
+    int32 NextHoldHandle = 0;
+
+    bool bAdvanceScheduled = false;
+    FTimerHandle TimeoutTimerHandle;
+};
@@ -0,0 +1,154 @@
+// CombatStateHash.cpp - Zobrist hashing and transposition cache implementation
+#include "CombatStateHash.h"
+
+DEFINE_STAT(STAT_KCK_TranspositionProbes);
+DEFINE_STAT(STAT_KCK_TranspositionHits);
+DEFINE_STAT(STAT_KCK_TranspositionStores);
+
+namespace CombatStateHash
+{
+    // Domain salts keep keys for different feature kinds independent
+    constexpr uint64 CreatureDomain = 0x9E3779B97F4A7C15ull;
+    constexpr uint64 ScalarDomain = 0xC2B2AE3D27D4EB4Full;
+    constexpr uint64 PileDomain = 0x165667B19E3779F9ull;
+
+    FORCEINLINE uint64 SplitMix64(uint64 X)
+    {
+        X += 0x9E3779B97F4A7C15ull;
+        X = (X ^ (X >> 30)) * 0xBF58476D1CE4E5B9ull;
+        X = (X ^ (X >> 27)) * 0x94D049BB133111EBull;
+        return X ^ (X >> 31);
+    }
+
+    FORCEINLINE uint64 Key(uint64 Domain, uint64 A, uint64 B)
+    {
+        return SplitMix64(SplitMix64(Domain ^ A) ^ B);
+    }
+}
+
+// ==== COMBAT STATE HASH ====
+
+void FCombatStateHash::AddBattlefieldCreature(bool bPlayerSide, int32 CardID, int32 Health, int32 Attack)
+{
+    const uint64 Contents = ((uint64)(uint32)CardID << 32) | ((uint64)(uint16)Health << 16) | (uint16)Attack;
+    MultisetSum += CombatStateHash::Key(CombatStateHash::CreatureDomain, bPlayerSide ? 1 : 0, Contents);
+}
+
+void FCombatStateHash::RemoveBattlefieldCreature(bool bPlayerSide, int32 CardID, int32 Health, int32 Attack)
+{
+    const uint64 Contents = ((uint64)(uint32)CardID << 32) | ((uint64)(uint16)Health << 16) | (uint16)Attack;
+    MultisetSum -= CombatStateHash::Key(CombatStateHash::CreatureDomain, bPlayerSide ? 1 : 0, Contents);
+}
+
+void FCombatStateHash::ToggleScalar(ECombatHashScalar Scalar, int32 Value)
+{
+    FeatureBits ^= CombatStateHash::Key(CombatStateHash::ScalarDomain, (uint64)Scalar, (uint32)Value);
+}
+
+void FCombatStateHash::AddPileCard(ECombatHashPile Pile, int32 CardID)
+{
+    MultisetSum += CombatStateHash::Key(CombatStateHash::PileDomain, (uint64)Pile, (uint32)CardID);
+}
+
+void FCombatStateHash::RemovePileCard(ECombatHashPile Pile, int32 CardID)
+{
+    MultisetSum -= CombatStateHash::Key(CombatStateHash::PileDomain, (uint64)Pile, (uint32)CardID);
+}
+
+uint64 FCombatStateHash::GetValue() const
+{
+    // Mix the multiset sum so linear relations between sums do not show up in the final value
+    return FeatureBits ^ CombatStateHash::SplitMix64(MultisetSum);
+}
+
+// ==== TRANSPOSITION ENTRY ====
+
+uint64 FCombatTranspositionEntry::Pack() const
+{
+    return ((uint64)(uint32)Score << 32) | ((uint64)(uint16)BestMove << 16) | ((uint64)Depth << 8) | Flags;
+}
+
+FCombatTranspositionEntry FCombatTranspositionEntry::Unpack(uint64 Data)
+{
+    FCombatTranspositionEntry Entry;
+    Entry.Score = (int32)(uint32)(Data >> 32);
+    Entry.BestMove = (int16)(uint16)(Data >> 16);
+    Entry.Depth = (uint8)(Data >> 8);
+    Entry.Flags = (uint8)Data;
+    return Entry;
+}
+
+// ==== TRANSPOSITION CACHE ====
+
+FCombatTranspositionCache::FCombatTranspositionCache(int32 InCapacity)
+{
+    const uint32 Capacity = FMath::RoundUpToPowerOfTwo((uint32)FMath::Max(InCapacity, 2));
+    Slots = MakeUnique<FSlot[]>(Capacity);
+    IndexMask = Capacity - 1;
+    Clear();
+}
+
+bool FCombatTranspositionCache::Probe(uint64 Key, FCombatTranspositionEntry& OutEntry) const
+{
+    NumProbes.fetch_add(1, std::memory_order_relaxed);
+    INC_DWORD_STAT(STAT_KCK_TranspositionProbes);
+
+    const FSlot& Slot = Slots[Key & IndexMask];
+    const uint64 Data = Slot.Data.load(std::memory_order_relaxed);
+    const uint64 Check = Slot.KeyXorData.load(std::memory_order_relaxed);
+
+    // Empty slots and torn writes both fail this check
+    if ((Check ^ Data) != Key || (Check == 0 && Data == 0))
+    {
+        return false;
+    }
+
+    OutEntry = FCombatTranspositionEntry::Unpack(Data);
+    NumHits.fetch_add(1, std::memory_order_relaxed);
+    INC_DWORD_STAT(STAT_KCK_TranspositionHits);
+    return true;
+}
+
+void FCombatTranspositionCache::Store(uint64 Key, const FCombatTranspositionEntry& Entry)
+{
+    FSlot& Slot = Slots[Key & IndexMask];
+
+    // Keep deeper results for the same state, otherwise always replace
+    const uint64 OldData = Slot.Data.load(std::memory_order_relaxed);
+    const uint64 OldCheck = Slot.KeyXorData.load(std::memory_order_relaxed);
+    if ((OldCheck ^ OldData) == Key && FCombatTranspositionEntry::Unpack(OldData).Depth > Entry.Depth)
+    {
+        return;
+    }
+
+    const uint64 Data = Entry.Pack();
+    Slot.KeyXorData.store(Key ^ Data, std::memory_order_relaxed);
+    Slot.Data.store(Data, std::memory_order_relaxed);
+
+    NumStores.fetch_add(1, std::memory_order_relaxed);
+    INC_DWORD_STAT(STAT_KCK_TranspositionStores);
+}
+
+void FCombatTranspositionCache::Clear()
+{
+    for (uint64 i = 0; i <= IndexMask; i++)
+    {
+        Slots[i].KeyXorData.store(0, std::memory_order_relaxed);
+        Slots[i].Data.store(0, std::memory_order_relaxed);
+    }
+
+    NumProbes.store(0, std::memory_order_relaxed);
+    NumHits.store(0, std::memory_order_relaxed);
+    NumStores.store(0, std::memory_order_relaxed);
+}
+
+FCombatTranspositionStats FCombatTranspositionCache::GetStats() const
+{
+    FCombatTranspositionStats Stats;
+    Stats.Probes = (int64)NumProbes.load(std::memory_order_relaxed);
+    Stats.Hits = (int64)NumHits.load(std::memory_order_relaxed);
+    Stats.Stores = (int64)NumStores.load(std::memory_order_relaxed);
+    Stats.Capacity = (int64)(IndexMask + 1);
+    Stats.HitRate = Stats.Probes > 0 ? (float)((double)Stats.Hits / (double)Stats.Probes) : 0.0f;
+    return Stats;
+}
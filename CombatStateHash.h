@@ -0,0 +1,153 @@
+// CombatStateHash.h - Incremental Zobrist hash of combat state and a shared transposition cache
+#pragma once
+
+#include "CoreMinimal.h"
+#include "KevesCardKitStats.h"
+#include <atomic>
+#include "CombatStateHash.generated.h"
+
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Transposition Probes"), STAT_KCK_TranspositionProbes, STATGROUP_KevesCardKit, KEVESCARDKIT_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Transposition Hits"), STAT_KCK_TranspositionHits, STATGROUP_KevesCardKit, KEVESCARDKIT_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Transposition Stores"), STAT_KCK_TranspositionStores, STATGROUP_KevesCardKit, KEVESCARDKIT_API);
+
+// Piles that contribute to the hash. Piles are hashed as multisets (contents, not order),
+// so a shuffle never changes the hash and hidden draw order is not leaked to search.
+enum class ECombatHashPile : uint8
+{
+    PlayerDeck,
+    PlayerHand,
+    PlayerDiscard,
+    PlayerBanished,
+    EnemyDeck,
+    EnemyHand,
+    EnemyDiscard
+};
+
+// Single-valued features of the combat state
+enum class ECombatHashScalar : uint8
+{
+    PlayerEnergy,
+    PlayerHealth,
+    EnemyEnergy,
+    EnemyHealth,
+    CombatState
+};
+
+/**
+ * 64-bit Zobrist-style hash of a combat state, updated in O(1) per change.
+ *
+ * Scalars are XOR-toggled in and out. Pile contents and each side's creatures are multisets
+ * (a wrapping sum of per-card keys, so duplicate copies do not cancel each other out). Creatures
+ * are keyed by what they are - CardID, health and attack - not by slot or instance, so removing
+ * one leaves the others alone and the same board reached in a different order hashes the same.
+ * Keys are derived on demand with SplitMix64, so there are no tables to size for card IDs.
+ */
+struct KEVESCARDKIT_API FCombatStateHash
+{
+public:
+    void Reset()
+    {
+        FeatureBits = 0;
+        MultisetSum = 0;
+    }
+
+    // A stat change is a remove with the old stats followed by an add with the new ones
+    void AddBattlefieldCreature(bool bPlayerSide, int32 CardID, int32 Health, int32 Attack);
+    void RemoveBattlefieldCreature(bool bPlayerSide, int32 CardID, int32 Health, int32 Attack);
+
+    // Toggle a scalar feature value in or out
+    void ToggleScalar(ECombatHashScalar Scalar, int32 Value);
+
+    // Replace a scalar value that is currently hashed in
+    void ChangeScalar(ECombatHashScalar Scalar, int32 OldValue, int32 NewValue)
+    {
+        if (OldValue != NewValue)
+        {
+            ToggleScalar(Scalar, OldValue);
+            ToggleScalar(Scalar, NewValue);
+        }
+    }
+
+    void AddPileCard(ECombatHashPile Pile, int32 CardID);
+    void RemovePileCard(ECombatHashPile Pile, int32 CardID);
+
+    // Fold another partial hash (e.g. the hand manager's piles) into this one
+    FCombatStateHash& operator^=(const FCombatStateHash& Other)
+    {
+        FeatureBits ^= Other.FeatureBits;
+        MultisetSum += Other.MultisetSum;
+        return *this;
+    }
+
+    uint64 GetValue() const;
+
+private:
+    uint64 FeatureBits = 0;
+    uint64 MultisetSum = 0;
+};
+
+// Packed evaluation stored per state. Fits in 64 bits so slots can be written lock-free.
+struct FCombatTranspositionEntry
+{
+    int32 Score = 0;        // Evaluation in fixed point, owner defined
+    int16 BestMove = -1;    // Hand index (or other move encoding) of the best move found
+    uint8 Depth = 0;        // Search depth the score was computed at
+    uint8 Flags = 0;        // Bound type / user flags
+
+    uint64 Pack() const;
+    static FCombatTranspositionEntry Unpack(uint64 Data);
+};
+
+USTRUCT(BlueprintType)
+struct KEVESCARDKIT_API FCombatTranspositionStats
+{
+    GENERATED_BODY()
+
+    UPROPERTY(BlueprintReadOnly, Category = "Transposition")
+    int64 Probes = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Transposition")
+    int64 Hits = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Transposition")
+    int64 Stores = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Transposition")
+    int64 Capacity = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Transposition")
+    float HitRate = 0.0f;
+};
+
+/**
+ * Bounded, lock-free transposition cache shared by search threads.
+ *
+ * Each slot stores (Key ^ Data, Data). A torn write from two racing stores fails the
+ * key check on probe and simply reads as a miss, so no locks are required.
+ */
+class KEVESCARDKIT_API FCombatTranspositionCache
+{
+public:
+    // Capacity is rounded to a power of two
+    explicit FCombatTranspositionCache(int32 InCapacity = 1 << 16);
+
+    bool Probe(uint64 Key, FCombatTranspositionEntry& OutEntry) const;
+    void Store(uint64 Key, const FCombatTranspositionEntry& Entry);
+    void Clear();
+
+    FCombatTranspositionStats GetStats() const;
+
+private:
+    struct FSlot
+    {
+        std::atomic<uint64> KeyXorData{ 0 };
+        std::atomic<uint64> Data{ 0 };
+    };
+
+    TUniquePtr<FSlot[]> Slots;
+    uint64 IndexMask = 0;
+
+    mutable std::atomic<uint64> NumProbes{ 0 };
+    mutable std::atomic<uint64> NumHits{ 0 };
+    std::atomic<uint64> NumStores{ 0 };
+};
@@ -13,4 +13,66 @@ enum class ECombatState : uint8
     EnemyTurn       UMETA(DisplayName = "Enemy Turn"),
     Victory         UMETA(DisplayName = "Victory"),
     Defeat          UMETA(DisplayName = "Defeat")
-}; 
\ No newline at end of file
+};
+
+// Kind of change carried by an FBattlefieldDelta
+UENUM(BlueprintType)
+enum class EBattlefieldDeltaType : uint8
+{
+    Added           UMETA(DisplayName = "Added"),
+    StatsChanged    UMETA(DisplayName = "Stats Changed"),
+    Removed         UMETA(DisplayName = "Removed"),     // Slots after BattlefieldIndex shift down by one
+    Cleared         UMETA(DisplayName = "Cleared")      // Whole side emptied; UniqueID is -1
+};
+
+// One entry in ACombatManager's battlefield change stream
+USTRUCT(BlueprintType)
+struct FBattlefieldDelta
+{
+    GENERATED_BODY()
+
+    // Monotonic per combat manager, starting at 1
+    UPROPERTY(BlueprintReadOnly, Category = "Battlefield")
+    int32 Sequence = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Battlefield")
+    EBattlefieldDeltaType Type = EBattlefieldDeltaType::Added;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Battlefield")
+    bool bIsPlayerSide = true;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Battlefield")
+    int32 UniqueID = -1;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Battlefield")
+    int32 CardID = -1;
+
+    // Slot at the time of the change
+    UPROPERTY(BlueprintReadOnly, Category = "Battlefield")
+    int32 BattlefieldIndex = -1;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Battlefield")
+    int32 Health = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Battlefield")
+    int32 Attack = 0;
+};
+
+// Maintained per-side battlefield totals (see ACombatManager::GetBattlefieldSummary). Only living cards count toward the totals.
+USTRUCT(BlueprintType)
+struct FBattlefieldSummary
+{
+    GENERATED_BODY()
+
+    UPROPERTY(BlueprintReadOnly, Category = "Battlefield")
+    int32 CardCount = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Battlefield")
+    int32 LivingCount = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Battlefield")
+    int32 TotalAttack = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Battlefield")
+    int32 TotalHealth = 0;
+};
@@ -1,7 +1,11 @@
 #include "CombatUIWidget.h"
+#include "KevesCardKitLog.h"
+#include "KevesCardKitTrace.h"
+#include "KevesCardKitMemory.h"
 #include "CombatManager.h"
 #include "HandManager.h"
 #include "CardUIWidget.h"
+#include "CardDisplayCache.h"
 
 UCombatUIWidget::UCombatUIWidget(const FObjectInitializer& ObjectInitializer)
     : Super(ObjectInitializer)
@@ -32,10 +36,16 @@ void UCombatUIWidget::InitializeUI(ACombatManager* InCombatManager, AHandManager
     // Bind to new managers
     BindToManagers();
 
+    // One widget per possible hand slot, created before the first draw
+    if (HandManager)
+    {
+        PrewarmCardWidgetPool(HandManager->MaxHandSize);
+    }
+
     // Initial UI refresh - broadcast all current data
     RefreshAllUI();
 
-    UE_LOG(LogTemp, Log, TEXT("[CombatUI] Initialized with CombatManager and HandManager"));
+    UE_LOG(LogKevesCardKitUI, Log, TEXT("[CombatUI] Initialized with CombatManager and HandManager"));
 }
 
 // Registration system removed - CardUIWidgets now handle their own interactions directly
@@ -44,17 +54,21 @@ void UCombatUIWidget::InitializeUI(ACombatManager* InCombatManager, AHandManager
 
 void UCombatUIWidget::RefreshAllUI()
 {
+    KCK_TRACE_SCOPE(KCK_RefreshAllUI);
+
     BroadcastHealthUpdate();
     BroadcastEnergyUpdate();
     BroadcastEnemyUpdate();
-    BroadcastHandUpdate();
 
     if (CombatManager)
     {
-        OnManagerCombatStateChanged(CombatManager->CurrentState);
+        FString StateText = GetCombatStateDisplayText(CombatManager->CurrentState);
+        OnUICombatStateChanged.Broadcast(CombatManager->CurrentState, StateText);
     }
 
-    CheckCardPlayability();
+    // Full refresh: rebuild and broadcast every slot
+    HandView.Invalidate();
+    RefreshHandView();
 }
 
 void UCombatUIWidget::RequestEndTurn()
@@ -62,50 +76,44 @@ void UCombatUIWidget::RequestEndTurn()
     if (CombatManager && IsPlayerTurn())
     {
         CombatManager->EndPlayerTurn();
-        UE_LOG(LogTemp, Log, TEXT("[CombatUI] Player requested end turn"));
+        UE_LOG(LogKevesCardKitUI, Log, TEXT("[CombatUI] Player requested end turn"));
     }
     else
     {
-        UE_LOG(LogTemp, Warning, TEXT("[CombatUI] Cannot end turn - not player's turn or no combat manager"));
+        UE_LOG(LogKevesCardKitUI, Warning, TEXT("[CombatUI] Cannot end turn - not player's turn or no combat manager"));
     }
 }
 
 void UCombatUIWidget::RequestPlayCard(int32 HandIndex, AActor* Target)
 {
-    UE_LOG(LogTemp, Log, TEXT("[CombatUI] RequestPlayCard called with HandIndex: %d"), HandIndex);
+    KCK_LOG_HOT(LogKevesCardKitUI, Verbose, TEXT("[CombatUI] RequestPlayCard called with HandIndex: %d"), HandIndex);
     
     if (!HandManager || !CombatManager)
     {
-        UE_LOG(LogTemp, Warning, TEXT("[CombatUI] Cannot play card - missing managers"));
+        UE_LOG(LogKevesCardKitUI, Warning, TEXT("[CombatUI] Cannot play card - missing managers"));
         return;
     }
 
-    UE_LOG(LogTemp, Log, TEXT("[CombatUI] Managers found - checking turn state"));
-    
     if (!IsPlayerTurn())
     {
-        UE_LOG(LogTemp, Warning, TEXT("[CombatUI] Cannot play card - not player turn"));
+        UE_LOG(LogKevesCardKitUI, Warning, TEXT("[CombatUI] Cannot play card - not player turn"));
         return;
     }
 
-    UE_LOG(LogTemp, Log, TEXT("[CombatUI] It's player turn - checking if card can be played"));
-    
     if (!CanPlayCardAtIndex(HandIndex))
     {
-        UE_LOG(LogTemp, Warning, TEXT("[CombatUI] Cannot play card at index %d - insufficient energy or invalid card"), HandIndex);
+        UE_LOG(LogKevesCardKitUI, Warning, TEXT("[CombatUI] Cannot play card at index %d - insufficient energy or invalid card"), HandIndex);
         return;
     }
 
-    UE_LOG(LogTemp, Log, TEXT("[CombatUI] Card can be played - calling HandManager->PlayCard"));
-    
     // Play the card - this will execute the ability!
     if (HandManager->PlayCard(HandIndex, Target))
     {
-        UE_LOG(LogTemp, Log, TEXT("[CombatUI] Successfully requested play card at index %d"), HandIndex);
+        KCK_LOG_HOT(LogKevesCardKitUI, Verbose, TEXT("[CombatUI] Successfully requested play card at index %d"), HandIndex);
     }
     else
     {
-        UE_LOG(LogTemp, Warning, TEXT("[CombatUI] Failed to play card at index %d"), HandIndex);
+        UE_LOG(LogKevesCardKitUI, Warning, TEXT("[CombatUI] Failed to play card at index %d"), HandIndex);
     }
 }
 
@@ -116,7 +124,7 @@ bool UCombatUIWidget::CanPlayCardAtIndex(int32 HandIndex) const
         return false;
     }
 
-    return HandManager->CanPlayCard(HandIndex, CombatManager->CurrentEnergy);
+    return HandManager->IsCardPlayable(HandIndex);
 }
 
 bool UCombatUIWidget::IsPlayerTurn() const
@@ -135,10 +143,20 @@ FCardData UCombatUIWidget::GetCardDataAtIndex(int32 HandIndex) const
 
 FCardDisplayData UCombatUIWidget::GetCardDisplayDataAtIndex(int32 HandIndex) const
 {
-    FCardData CardData = GetCardDataAtIndex(HandIndex);
-    bool bIsPlayable = CanPlayCardAtIndex(HandIndex) && IsPlayerTurn();
+    // Blueprint takes a copy; this is the one place a hand entry is copied out of the cache
+    FCardDisplayDataPtr Entry;
+    if (HandView.HandDisplay.IsValidIndex(HandIndex) && HandManager && HandIndex < HandManager->GetHandSize())
+    {
+        Entry = HandView.HandDisplay[HandIndex];
+    }
+    if (!Entry.IsValid())
+    {
+        Entry = FindCardDisplayData(GetCardDataAtIndex(HandIndex), CanPlayCardAtIndex(HandIndex) && IsPlayerTurn());
+    }
 
-    return CreateCardDisplayData(CardData, HandIndex, bIsPlayable);
+    FCardDisplayData DisplayData = *Entry;
+    DisplayData.HandIndex = HandIndex;
+    return DisplayData;
 }
 
 float UCombatUIWidget::GetHealthPercent() const
@@ -172,94 +190,112 @@ FString UCombatUIWidget::GetCombatStateDisplayText(ECombatState State) const
 
 FString UCombatUIWidget::GetCardTypeDisplayName(ECardType CardType) const
 {
-    switch (CardType)
-    {
-    case ECardType::Creature: return TEXT("Creature");
-    case ECardType::Spell: return TEXT("Spell");
-    case ECardType::Power: return TEXT("Power");
-    case ECardType::Skill: return TEXT("Skill");
-    case ECardType::Champion: return TEXT("Champion");
-    default: return TEXT("Unknown");
-    }
+    return FCardDisplayDataCache::GetCardTypeDisplayName(CardType);
 }
 
 FString UCombatUIWidget::GetFactionDisplayName(ECardFaction Faction) const
 {
-    switch (Faction)
-    {
-    case ECardFaction::Demon: return TEXT("Demon");
-    case ECardFaction::Undead: return TEXT("Undead");
-    case ECardFaction::Angel: return TEXT("Angel");
-    default: return TEXT("Neutral");
-    }
+    return FCardDisplayDataCache::GetFactionDisplayName(Faction);
 }
 
 FLinearColor UCombatUIWidget::GetFactionColor(ECardFaction Faction) const
 {
-    switch (Faction)
-    {
-    case ECardFaction::Demon:
-        return FLinearColor::Red;
-    case ECardFaction::Undead:
-        return FLinearColor(0.4f, 0.2f, 0.4f, 1.0f); // Purple-ish
-    case ECardFaction::Angel:
-        return FLinearColor(1.0f, 1.0f, 0.8f, 1.0f); // Light yellow
-    default:
-        return FLinearColor::White;
-    }
+    return FCardDisplayDataCache::GetFactionColor(Faction);
 }
 
 bool UCombatUIWidget::ShouldShowAttackHealth(ECardType CardType) const
 {
-    return CardType == ECardType::Creature || CardType == ECardType::Champion;
+    return FCardDisplayDataCache::ShouldShowAttackHealth(CardType);
 }
 
-void UCombatUIWidget::OnManagerCombatStateChanged(ECombatState NewState)
+// === CARD WIDGET POOL ===
+
+UCardUIWidget* UCombatUIWidget::AcquireCardWidget(const FCardDisplayData& DisplayData)
 {
-    UE_LOG(LogTemp, Log, TEXT("[CombatUI] Combat state changed to: %d"), (int32)NewState);
-    
-    FString StateText = GetCombatStateDisplayText(NewState);
-    OnUICombatStateChanged.Broadcast(NewState, StateText);
+    UCardUIWidget* CardWidget = nullptr;
 
-    if (!HandManager || !CombatManager)
-        return;
+    if (FreeCardWidgets.Num() > 0)
+    {
+        CardWidget = FreeCardWidgets.Pop();
+        CardPoolHits++;
+    }
+    else
+    {
+        if (!CardWidgetClass)
+        {
+            UE_LOG(LogKevesCardKitUI, Warning, TEXT("[CombatUI] Cannot acquire card widget - CardWidgetClass is not set"));
+            return nullptr;
+        }
 
-    // Combined playability + hand broadcast loop
-    TArray<FCardDisplayData> DisplayDataArray;
-    DisplayDataArray.Reserve(HandManager->GetHandSize());
+        LLM_SCOPE_BYTAG(KevesCardKit_Widgets);
+        CardWidget = CreateWidget<UCardUIWidget>(GetOwningPlayer(), CardWidgetClass);
+        CardPoolMisses++;
+    }
 
-    for (int32 i = 0; i < HandManager->MaxHandSize; i++)
+    if (!CardWidget)
     {
-        if (i < HandManager->GetHandSize())
-        {
-            FCardData CardData = HandManager->GetCardInHand(i);
-            bool bCanPlay = HandManager->CanPlayCard(i, CombatManager->CurrentEnergy)
-                && CombatManager->IsPlayerTurn();
+        return nullptr;
+    }
 
-            UE_LOG(LogTemp, Log, TEXT("[CombatUI] Card %d playability check - Energy: %d, IsPlayerTurn: %s, CanPlay: %s"), 
-                i, CombatManager->CurrentEnergy, 
-                CombatManager->IsPlayerTurn() ? TEXT("Yes") : TEXT("No"),
-                bCanPlay ? TEXT("Yes") : TEXT("No"));
+    InUseCardWidgets.Add(CardWidget);
 
-            FCardDisplayData DisplayData = CreateCardDisplayData(CardData, i, bCanPlay);
-            DisplayDataArray.Add(DisplayData);
+    // Rebind instead of reconstructing
+    CardWidget->HandManager = HandManager;
+    CardWidget->SetVisibility(ESlateVisibility::Visible);
+    ICardWidget::Execute_SetCardData(CardWidget, DisplayData);
 
-            // Keep slot update event firing for developers
-            OnUICardSlotChanged.Broadcast(i, DisplayData, true, bCanPlay);
-        }
-        else
+    return CardWidget;
+}
+
+void UCombatUIWidget::ReleaseCardWidget(UCardUIWidget* CardWidget)
+{
+    if (!CardWidget || InUseCardWidgets.RemoveSingleSwap(CardWidget) == 0)
+    {
+        return;
+    }
+
+    CardWidget->RemoveFromParent();
+    CardWidget->ResetForReuse();
+    FreeCardWidgets.Add(CardWidget);
+}
+
+void UCombatUIWidget::PrewarmCardWidgetPool(int32 Count)
+{
+    if (!CardWidgetClass)
+    {
+        return;
+    }
+
+    LLM_SCOPE_BYTAG(KevesCardKit_Widgets);
+    for (int32 i = FreeCardWidgets.Num() + InUseCardWidgets.Num(); i < Count; i++)
+    {
+        if (UCardUIWidget* CardWidget = CreateWidget<UCardUIWidget>(GetOwningPlayer(), CardWidgetClass))
         {
-            FCardDisplayData EmptyDisplayData;
-            OnUICardSlotChanged.Broadcast(i, EmptyDisplayData, false, false);
+            CardWidget->ResetForReuse();
+            FreeCardWidgets.Add(CardWidget);
         }
     }
+}
+
+FCardWidgetPoolStats UCombatUIWidget::GetCardWidgetPoolStats() const
+{
+    FCardWidgetPoolStats Stats;
+    Stats.Hits = CardPoolHits;
+    Stats.Misses = CardPoolMisses;
+    Stats.NumFree = FreeCardWidgets.Num();
+    Stats.NumInUse = InUseCardWidgets.Num();
+    return Stats;
+}
+
+void UCombatUIWidget::OnManagerCombatStateChanged(ECombatState NewState)
+{
+    KCK_LOG_HOT(LogKevesCardKitUI, Verbose, TEXT("[CombatUI] Combat state changed to: %d"), (int32)NewState);
+    
+    FString StateText = GetCombatStateDisplayText(NewState);
+    OnUICombatStateChanged.Broadcast(NewState, StateText);
 
-    // Broadcast full hand array once
-    OnUIHandChanged.Broadcast(
-        DisplayDataArray,
-        HandManager->GetHandSize(),
-        HandManager->GetDeckSize()
-    );
+    // Turn changes flip playability; only slots whose playability actually changed are rebuilt
+    RefreshHandView();
 }
 
 void UCombatUIWidget::OnManagerHealthChanged(bool bIsPlayer, int32 NewHealth)
@@ -274,37 +310,37 @@ void UCombatUIWidget::OnManagerHealthChanged(bool bIsPlayer, int32 NewHealth)
     }
 }
 
-void UCombatUIWidget::OnManagerHandUpdated(const TArray<FCardData>& CurrentHand, int32 HandSize)
+void UCombatUIWidget::OnManagerEnergyChanged(int32 NewEnergy, int32 MaxEnergy)
+{
+    BroadcastEnergyUpdate();
+    RefreshHandView();
+}
+
+void UCombatUIWidget::OnManagerHandUpdated(const FHandChangeSet& ChangeSet)
 {
-    BroadcastHandUpdate();
-    CheckCardPlayability();
+    // Fires once per hand operation (a whole draw, a play), so this is the one refresh per batch
+    RefreshHandView();
 }
 
 void UCombatUIWidget::OnManagerCardPlayed(const FCardData& PlayedCard)
 {
-    // Energy changed after playing card
-    BroadcastEnergyUpdate();
-    CheckCardPlayability();
+    // The hand change itself arrives through OnManagerHandUpdated, energy through OnManagerEnergyChanged
 
-    UE_LOG(LogTemp, Log, TEXT("[CombatUI] Processed card played: %s"), *PlayedCard.Name.ToString());
+    KCK_LOG_HOT(LogKevesCardKitUI, Verbose, TEXT("[CombatUI] Processed card played: %s"), *PlayedCard.Name.ToString());
 }
 
 void UCombatUIWidget::OnManagerCardAddedToHand(const FCardData& AddedCard)
 {
-    // Refresh hand UI when individual cards are added
-    BroadcastHandUpdate();
-    CheckCardPlayability();
+    // No refresh per card: a draw adds several, then OnManagerHandUpdated refreshes once for the batch
 
-    UE_LOG(LogTemp, Log, TEXT("[CombatUI] Card added to hand: %s"), *AddedCard.Name.ToString());
+    KCK_LOG_HOT(LogKevesCardKitUI, Verbose, TEXT("[CombatUI] Card added to hand: %s"), *AddedCard.Name.ToString());
 }
 
 void UCombatUIWidget::OnManagerCardRemovedFromHand(const FCardData& RemovedCard, int32 FormerIndex)
 {
-    // Refresh hand UI when individual cards are removed  
-    BroadcastHandUpdate();
-    CheckCardPlayability();
+    // Refreshed once by OnManagerHandUpdated, which follows every removal
 
-    UE_LOG(LogTemp, Log, TEXT("[CombatUI] Card removed from hand: %s (was at index %d)"), *RemovedCard.Name.ToString(), FormerIndex);
+    KCK_LOG_HOT(LogKevesCardKitUI, Verbose, TEXT("[CombatUI] Card removed from hand: %s (was at index %d)"), *RemovedCard.Name.ToString(), FormerIndex);
 }
 
 // Event handler removed - CardUIWidgets now handle their own interactions directly
@@ -315,6 +351,7 @@ void UCombatUIWidget::BindToManagers()
     {
         CombatManager->OnCombatStateChanged.AddDynamic(this, &UCombatUIWidget::OnManagerCombatStateChanged);
         CombatManager->OnHealthChanged.AddDynamic(this, &UCombatUIWidget::OnManagerHealthChanged);
+        CombatManager->OnEnergyChanged.AddDynamic(this, &UCombatUIWidget::OnManagerEnergyChanged);
     }
 
     if (HandManager)
@@ -340,6 +377,7 @@ void UCombatUIWidget::UnbindFromManagers()
     {
         CombatManager->OnCombatStateChanged.RemoveDynamic(this, &UCombatUIWidget::OnManagerCombatStateChanged);
         CombatManager->OnHealthChanged.RemoveDynamic(this, &UCombatUIWidget::OnManagerHealthChanged);
+        CombatManager->OnEnergyChanged.RemoveDynamic(this, &UCombatUIWidget::OnManagerEnergyChanged);
     }
 
     if (HandManager)
@@ -390,89 +428,66 @@ void UCombatUIWidget::BroadcastEnemyUpdate()
     }
 }
 
-void UCombatUIWidget::BroadcastHandUpdate()
-{
-    if (HandManager)
-    {
-        // Create array of FCardDisplayData from current hand
-        TArray<FCardDisplayData> DisplayDataArray;
-
-        for (int32 i = 0; i < HandManager->GetHandSize(); i++)
-        {
-            FCardData CardData = HandManager->GetCardInHand(i);
-            bool bIsPlayable = CanPlayCardAtIndex(i) && IsPlayerTurn();
-
-            FCardDisplayData DisplayData = CreateCardDisplayData(CardData, i, bIsPlayable);
-            DisplayDataArray.Add(DisplayData);
-        }
-
-        // Broadcast the array of FCardDisplayData instead of FCardData
-        OnUIHandChanged.Broadcast(
-            DisplayDataArray,
-            HandManager->GetHandSize(),
-            HandManager->GetDeckSize()
-        );
-    }
-}
-
-void UCombatUIWidget::CheckCardPlayability()
+void UCombatUIWidget::RefreshHandView()
 {
-    if (!HandManager || !CombatManager) return;
+    KCK_TRACE_SCOPE(KCK_RefreshHandView);
 
-    // Only broadcast for actual cards in hand, not all possible slots
-    for (int32 i = 0; i < HandManager->GetHandSize(); i++)
+    if (!HandManager)
     {
-        FCardData CardData = HandManager->GetCardInHand(i);
-        bool bCanPlay = CanPlayCardAtIndex(i) && IsPlayerTurn();
-        FCardDisplayData DisplayData = CreateCardDisplayData(CardData, i, bCanPlay);
-        OnUICardSlotChanged.Broadcast(i, DisplayData, true, bCanPlay);
+        return;
     }
-}
-
-FCardDisplayData UCombatUIWidget::CreateCardDisplayData(const FCardData& CardData, int32 HandIndex, bool bIsPlayable) const
-{
-    FCardDisplayData DisplayData;
-
-    // Core Card Data
-    DisplayData.CardData = CardData;
-    DisplayData.HandIndex = HandIndex;
 
-    // Playability
-    DisplayData.bIsPlayable = bIsPlayable;
-    DisplayData.bIsHovered = false;
-    DisplayData.bIsSelected = false;
+    const int32 HandSize = FMath::Min(HandManager->GetHandSize(), FHandViewModel::MaxSlots);
+    const int32 DeckSize = HandManager->GetDeckSize();
+    const bool bPlayerTurn = IsPlayerTurn();
 
-    // Display Information
-    DisplayData.CardTypeDisplayName = GetCardTypeDisplayName(CardData.CardType);
-    DisplayData.FactionDisplayName = GetFactionDisplayName(CardData.CardFaction);
-    DisplayData.FactionColor = GetFactionColor(CardData.CardFaction);
-    DisplayData.bShouldShowAttackHealth = ShouldShowAttackHealth(CardData.CardType);
+    HandView.BeginUpdate(HandSize, DeckSize);
 
-    // Set border color and opacity based on playability
-    if (!DisplayData.bIsPlayable)
-    {
-        DisplayData.CardBorderColor = FLinearColor::Gray;
-        DisplayData.DisplayOpacity = 0.6f;
-    }
-    else
+    for (int32 i = 0; i < HandSize; i++)
     {
-        DisplayData.CardBorderColor = DisplayData.FactionColor;
-        DisplayData.DisplayOpacity = 1.0f;
+        const FCardData& CardData = HandManager->CurrentHand[i];
+
+        FHandSlotInputs Inputs;
+        Inputs.CardID = CardData.ID;
+        Inputs.Cost = CardData.Cost;
+        Inputs.Attack = CardData.Attack;
+        Inputs.Health = CardData.Health;
+        Inputs.bIsPlayable = bPlayerTurn && HandManager->IsCardPlayable(i);
+
+        // Shifted cards keep their display data; listeners move them using the change set's ShiftedSlotMask
+        const EHandSlotChange Change = HandView.UpdateSlot(i, HandManager->GetHandInstanceID(i), Inputs);
+        if (Change == EHandSlotChange::Changed || Change == EHandSlotChange::Inserted)
+        {
+            const FCardDisplayDataRef Entry = FindCardDisplayData(CardData, Inputs.bIsPlayable);
+            HandView.HandDisplay[i] = Entry;
+            OnUICardSlotChanged.Broadcast(i, *Entry, true, Inputs.bIsPlayable);
+        }
     }
 
-    // Format text fields for convenience
-    DisplayData.FormattedCostText = FString::Printf(TEXT("%d"), CardData.Cost);
+    HandView.EndUpdate();
 
-    if (DisplayData.bShouldShowAttackHealth)
+    // Slots the hand no longer reaches are now empty (after a full refresh, every slot up to the hand limit)
+    const int32 PreviousHandSize = HandView.GetPreviousHandSize();
+    const int32 EndEmpty = PreviousHandSize == INDEX_NONE ? FMath::Min(HandManager->MaxHandSize, FHandViewModel::MaxSlots) : PreviousHandSize;
+    for (int32 i = HandSize; i < EndEmpty; i++)
     {
-        DisplayData.FormattedAttackText = FString::Printf(TEXT("%d"), CardData.Attack);
-        DisplayData.FormattedHealthText = FString::Printf(TEXT("%d"), CardData.Health);
+        OnUICardSlotChanged.Broadcast(i, FCardDisplayData(), false, false);
     }
-    else
+
+    if (HandView.HasChanges())
     {
-        DisplayData.FormattedAttackText = TEXT("");
-        DisplayData.FormattedHealthText = TEXT("");
+        FHandChangeSet ChangeSet;
+        ChangeSet.ChangedSlotMask = (int64)HandView.GetChangedMask();
+        ChangeSet.ShiftedSlotMask = (int64)HandView.GetShiftedMask();
+        ChangeSet.RemovedSlotMask = (int64)HandView.GetRemovedMask();
+        ChangeSet.HandSize = HandSize;
+        ChangeSet.DeckSize = DeckSize;
+        ChangeSet.Version = ++HandChangeVersion;
+        OnUIHandChanged.Broadcast(ChangeSet);
     }
+}
 
-    return DisplayData;
-}
\ No newline at end of file
+FCardDisplayDataRef UCombatUIWidget::FindCardDisplayData(const FCardData& CardData, bool bIsPlayable) const
+{
+    return FCardDisplayDataCache::Get().FindOrBuild(CardData, bIsPlayable);
+}
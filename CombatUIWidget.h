@@ -12,11 +12,32 @@ class ACombatManager;
 class AHandManager;
 class UCardUIWidget;
 
+// Reuse counters for the hand card widget pool
+USTRUCT(BlueprintType)
+struct KEVESCARDKIT_API FCardWidgetPoolStats
+{
+    GENERATED_BODY()
+
+    // Acquires served from the free list
+    UPROPERTY(BlueprintReadOnly, Category = "Card Widget Pool")
+    int32 Hits = 0;
+
+    // Acquires that had to create a widget
+    UPROPERTY(BlueprintReadOnly, Category = "Card Widget Pool")
+    int32 Misses = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Card Widget Pool")
+    int32 NumFree = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Card Widget Pool")
+    int32 NumInUse = 0;
+};
+
 // UI Event Delegates - Developers can bind to these however they want
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnUIHealthChanged, int32, CurrentHealth, int32, MaxHealth);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FOnUIEnergyChanged, int32, CurrentEnergy, int32, MaxEnergy, FString, EnergyTypeName);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_FourParams(FOnUIEnemyChanged, FText, EnemyName, int32, EnemyHealth, int32, EnemyMaxHealth, UTexture2D*, EnemyPortrait);
-DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FOnUIHandChanged, const TArray<FCardDisplayData>&, CurrentHandDisplay, int32, HandSize, int32, DeckSize);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnUIHandChanged, const FHandChangeSet&, ChangeSet);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnUICombatStateChanged, ECombatState, NewState, FString, StateDisplayText);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_FourParams(FOnUICardSlotChanged, int32, SlotIndex, const FCardDisplayData&, CardDisplayData, bool, bHasCard, bool, bCanPlay);
 
@@ -44,6 +65,10 @@ public:
     // === CARD UI WIDGET REFERENCES ===
     // Note: CardUIWidgets now handle their own interactions directly
 
+    // Class used for hand cards handed out by AcquireCardWidget
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Combat UI|Card Pool")
+    TSubclassOf<UCardUIWidget> CardWidgetClass;
+
     // === UI EVENT DELEGATES - Bind to these in Blueprint ===
 
     UPROPERTY(BlueprintAssignable, Category = "UI Events")
@@ -61,6 +86,7 @@ public:
     UPROPERTY(BlueprintAssignable, Category = "UI Events")
     FOnUICombatStateChanged OnUICombatStateChanged;
 
+    // CardDisplayData is the shared cache entry, so its HandIndex is -1; SlotIndex is the slot
     UPROPERTY(BlueprintAssignable, Category = "UI Events")
     FOnUICardSlotChanged OnUICardSlotChanged;
 
@@ -91,6 +117,7 @@ public:
     UFUNCTION(BlueprintPure, Category = "Combat UI")
     FCardData GetCardDataAtIndex(int32 HandIndex) const;
 
+    // Cached display data for a hand slot; use with OnUIHandChanged's changed and shifted masks
     UFUNCTION(BlueprintPure, Category = "Combat UI")
     FCardDisplayData GetCardDisplayDataAtIndex(int32 HandIndex) const;
 
@@ -116,6 +143,24 @@ public:
     UFUNCTION(BlueprintPure, Category = "Combat UI")
     bool ShouldShowAttackHealth(ECardType CardType) const;
 
+    // === CARD WIDGET POOL ===
+
+    // Get a card widget bound to DisplayData, reusing a released one when available.
+    // The caller adds it to its container; ReleaseCardWidget removes it again.
+    UFUNCTION(BlueprintCallable, Category = "Combat UI|Card Pool")
+    UCardUIWidget* AcquireCardWidget(const FCardDisplayData& DisplayData);
+
+    // Return a widget to the pool (removes it from its parent)
+    UFUNCTION(BlueprintCallable, Category = "Combat UI|Card Pool")
+    void ReleaseCardWidget(UCardUIWidget* CardWidget);
+
+    // Create widgets up front so draws never construct one mid-combat
+    UFUNCTION(BlueprintCallable, Category = "Combat UI|Card Pool")
+    void PrewarmCardWidgetPool(int32 Count);
+
+    UFUNCTION(BlueprintPure, Category = "Combat UI|Card Pool")
+    FCardWidgetPoolStats GetCardWidgetPoolStats() const;
+
 protected:
     // === EVENT HANDLERS - Listen to manager events and convert to UI events ===
 
@@ -126,7 +171,10 @@ protected:
     void OnManagerHealthChanged(bool bIsPlayer, int32 NewHealth);
 
     UFUNCTION()
-    void OnManagerHandUpdated(const TArray<FCardData>& CurrentHand, int32 HandSize);
+    void OnManagerEnergyChanged(int32 NewEnergy, int32 MaxEnergy);
+
+    UFUNCTION()
+    void OnManagerHandUpdated(const FHandChangeSet& ChangeSet);
 
     UFUNCTION()
     void OnManagerCardPlayed(const FCardData& PlayedCard);
@@ -148,9 +196,24 @@ private:
     void BroadcastHealthUpdate();
     void BroadcastEnergyUpdate();
     void BroadcastEnemyUpdate();
-    void BroadcastHandUpdate();
-    void CheckCardPlayability();
 
-    // Helper function to create FCardDisplayData from FCardData
-    FCardDisplayData CreateCardDisplayData(const FCardData& CardData, int32 HandIndex, bool bIsPlayable) const;
+    // Diff the hand against the view model by card instance; rebuild and broadcast only changed and inserted slots
+    void RefreshHandView();
+
+    FHandViewModel HandView;
+
+    int32 HandChangeVersion = 0;
+
+    // Pooled hand card widgets (UPROPERTY keeps released widgets alive)
+    UPROPERTY()
+    TArray<UCardUIWidget*> FreeCardWidgets;
+
+    UPROPERTY()
+    TArray<UCardUIWidget*> InUseCardWidgets;
+
+    int32 CardPoolHits = 0;
+    int32 CardPoolMisses = 0;
+
+    // Shared display entry for a hand card (HandIndex -1; the slot is tracked by the caller)
+    FCardDisplayDataRef FindCardDisplayData(const FCardData& CardData, bool bIsPlayable) const;
 };
\ No newline at end of file
@@ -1,7 +1,13 @@
 #include "EnemyAIComponent.h"
+#include "KevesCardKitLog.h"
+#include "KevesCardKitTrace.h"
 #include "CombatManager.h"
+#include "HandManager.h"
+#include "CardCatalog.h"
+#include "EnemyPolicyTable.h"
 #include "Engine/World.h"
 #include "TimerManager.h"
+#include "CombatSequencer.h"
 
 UEnemyAIComponent::UEnemyAIComponent()
 {
@@ -23,22 +29,26 @@ void UEnemyAIComponent::InitializeEnemyAI(const TArray<int32>& DeckCardIDs)
     EnemyHand.Empty();
     DiscardPileCardIDs.Empty();
 
+    StateHash.Reset();
+    StateHash.ToggleScalar(ECombatHashScalar::EnemyEnergy, CurrentEnergy);
+
     for (int32 CardID : DeckCardIDs)
     {
-        if (FCardData* FoundCard = FindCardByID(CardID))
+        if (const FCardData* FoundCard = FindCardByID(CardID))
         {
             EnemyDeck.Add(*FoundCard);
+            StateHash.AddPileCard(ECombatHashPile::EnemyDeck, CardID);
         }
         else
         {
-            UE_LOG(LogTemp, Warning, TEXT("[EnemyAI] CardID %d not found in CardDataTable"), CardID);
+            UE_LOG(LogKevesCardKitAI, Warning, TEXT("[EnemyAI] CardID %d not found in CardDataTable"), CardID);
         }
     }
 
     ShuffleDeck();
     DrawCards(5); // Starting hand size
 
-    CurrentEnergy = MaxEnergyPerTurn;
+    SetCurrentEnergy(MaxEnergyPerTurn);
 }
 
 void UEnemyAIComponent::SetCombatManager(ACombatManager* InCombatManager)
@@ -46,26 +56,27 @@ void UEnemyAIComponent::SetCombatManager(ACombatManager* InCombatManager)
     CombatManager = InCombatManager;
 }
 
-FCardData* UEnemyAIComponent::FindCardByID(int32 CardID) const
+const FCardData* UEnemyAIComponent::FindCardByID(int32 CardID)
 {
     if (!CardDataTable) return nullptr;
 
-    for (const FName& RowName : CardDataTable->GetRowNames())
+    if (!Catalog.IsValid() || Catalog->IsSuperseded() || Catalog->GetCardTable() != CardDataTable)
     {
-        FCardData* FoundCard = CardDataTable->FindRow<FCardData>(RowName, TEXT("FindCardByID"));
-        if (FoundCard && FoundCard->ID == CardID)
-        {
-            return FoundCard;
-        }
+        // Share the player's catalog when both sides use the same card table
+        AHandManager* HandManager = CombatManager ? CombatManager->HandManager : nullptr;
+        Catalog = (HandManager && HandManager->CardDataTable == CardDataTable)
+            ? HandManager->GetCatalog()
+            : FCardCatalog::Get(CardDataTable, nullptr);
     }
-    return nullptr;
+    return Catalog->FindCard(CardID);
 }
 
 void UEnemyAIComponent::ShuffleDeck()
 {
+    FRandomStream* Random = CombatManager ? &CombatManager->GetCombatRandom() : nullptr;
     for (int32 i = EnemyDeck.Num() - 1; i > 0; i--)
     {
-        int32 j = FMath::RandRange(0, i);
+        int32 j = Random ? Random->RandRange(0, i) : FMath::RandRange(0, i);
         EnemyDeck.Swap(i, j);
     }
 }
@@ -79,17 +90,20 @@ void UEnemyAIComponent::DrawCards(int32 Count)
             ShuffleDiscardIntoDeck();
             if (EnemyDeck.Num() == 0)
             {
-                UE_LOG(LogTemp, Warning, TEXT("[EnemyAI] Deck and discard empty, cannot draw more cards"));
+                UE_LOG(LogKevesCardKitAI, Warning, TEXT("[EnemyAI] Deck and discard empty, cannot draw more cards"));
                 break;
             }
         }
 
         if (EnemyHand.Num() >= 7) // Max hand size
         {
-            UE_LOG(LogTemp, Warning, TEXT("[EnemyAI] Hand is full, cannot draw more cards"));
+            UE_LOG(LogKevesCardKitAI, Warning, TEXT("[EnemyAI] Hand is full, cannot draw more cards"));
             break;
         }
 
+        StateHash.RemovePileCard(ECombatHashPile::EnemyDeck, EnemyDeck[0].ID);
+        StateHash.AddPileCard(ECombatHashPile::EnemyHand, EnemyDeck[0].ID);
+
         EnemyHand.Add(EnemyDeck[0]);
         EnemyDeck.RemoveAt(0);
     }
@@ -101,9 +115,12 @@ void UEnemyAIComponent::ShuffleDiscardIntoDeck()
 
     for (int32 CardID : DiscardPileCardIDs)
     {
-        if (FCardData* FoundCard = FindCardByID(CardID))
+        StateHash.RemovePileCard(ECombatHashPile::EnemyDiscard, CardID);
+
+        if (const FCardData* FoundCard = FindCardByID(CardID))
         {
             EnemyDeck.Add(*FoundCard);
+            StateHash.AddPileCard(ECombatHashPile::EnemyDeck, CardID);
         }
     }
     DiscardPileCardIDs.Empty();
@@ -113,16 +130,23 @@ void UEnemyAIComponent::ShuffleDiscardIntoDeck()
 void UEnemyAIComponent::AddCardToDiscard(int32 CardID)
 {
     DiscardPileCardIDs.Add(CardID);
+    StateHash.AddPileCard(ECombatHashPile::EnemyDiscard, CardID);
 }
 
 void UEnemyAIComponent::ClearHand()
 {
+    for (const FCardData& Card : EnemyHand)
+    {
+        StateHash.RemovePileCard(ECombatHashPile::EnemyHand, Card.ID);
+    }
     EnemyHand.Empty();
 }
 
 void UEnemyAIComponent::SetCurrentEnergy(int32 NewEnergy)
 {
-    CurrentEnergy = FMath::Clamp(NewEnergy, 0, MaxEnergyPerTurn);
+    const int32 ClampedEnergy = FMath::Clamp(NewEnergy, 0, MaxEnergyPerTurn);
+    StateHash.ChangeScalar(ECombatHashScalar::EnemyEnergy, CurrentEnergy, ClampedEnergy);
+    CurrentEnergy = ClampedEnergy;
 }
 
 bool UEnemyAIComponent::TryPlayCard(int32 HandIndex)
@@ -132,42 +156,63 @@ bool UEnemyAIComponent::TryPlayCard(int32 HandIndex)
         return false;
     }
 
-    const FCardData& CardToPlay = EnemyHand[HandIndex];
+    // Copy: the card's abilities and triggers can draw into (or clear) the hand while it resolves
+    const FCardData CardToPlay = EnemyHand[HandIndex];
 
     if (CardToPlay.Cost > CurrentEnergy)
     {
         return false; // Can't afford
     }
 
-    bool bSuccess = CombatManager->PlayEnemyCard(CardToPlay);
+    CombatManager->RecordCombatAction(ECombatJournalAction::EnemyCard, HandIndex, CardToPlay.ID);
 
-    if (bSuccess)
-    {
-        CurrentEnergy -= CardToPlay.Cost;
-        OnEnemyAIAttemptedPlay.Broadcast(CardToPlay);
-        EnemyHand.RemoveAt(HandIndex);
-    }
+    // Same order as AHandManager::PlayCard: leave the hand and pay, then resolve
+    StateHash.RemovePileCard(ECombatHashPile::EnemyHand, CardToPlay.ID);
+    EnemyHand.RemoveAt(HandIndex);
+    SetCurrentEnergy(CurrentEnergy - CardToPlay.Cost);
+
+    const bool bSuccess = CombatManager->PlayEnemyCard(CardToPlay);
+
+    KCK_TRACE_BROADCAST();
+    OnEnemyAIAttemptedPlay.Broadcast(CardToPlay);
 
     return bSuccess;
 }
 
 void UEnemyAIComponent::StartEnemyTurn()
 {
-    CurrentEnergy = MaxEnergyPerTurn;
+    BeginTurnWithoutSteps();
+    ScheduleNextTurnStep();
+}
+
+void UEnemyAIComponent::BeginTurnWithoutSteps()
+{
+    SetCurrentEnergy(MaxEnergyPerTurn);
     NextCardToPlayIndex = 0;
     bIsEnemyTurnActive = true;
 
     ClearHand();
     DrawCards(5);
+}
 
-    if (GetWorld())
+void UEnemyAIComponent::ScheduleNextTurnStep()
+{
+    // Each play waits for the previous card's presentation instead of a fixed interval
+    if (CombatManager && CombatManager->GetCombatSequencer())
+    {
+        CombatManager->GetCombatSequencer()->RunAfterPresentation(TEXT("EnemyTurnStep"),
+            FSimpleDelegate::CreateUObject(this, &UEnemyAIComponent::ProcessEnemyTurnStep));
+    }
+    else if (GetWorld())
     {
-        GetWorld()->GetTimerManager().SetTimer(EnemyTurnStepTimerHandle, this, &UEnemyAIComponent::ProcessEnemyTurnStep, 2.5f, true);
+        GetWorld()->GetTimerManager().SetTimerForNextTick(FTimerDelegate::CreateUObject(this, &UEnemyAIComponent::ProcessEnemyTurnStep));
     }
 }
 
 void UEnemyAIComponent::ProcessEnemyTurnStep()
 {
+    KCK_TRACE_SCOPE(KCK_EnemyTurnStep);
+
     if (!bIsEnemyTurnActive)
         return;
 
@@ -187,10 +232,18 @@ void UEnemyAIComponent::ProcessEnemyTurnStep()
 
     bool bPlayed = TryPlayCard(CardIndex);
 
-    if (!bPlayed)
+    // The card may have ended the combat
+    if (!CombatManager || !CombatManager->IsCombatActive())
+    {
+        bIsEnemyTurnActive = false;
+        return;
+    }
+
+    if (!bPlayed && EnemyHand.Num() > 0)
     {
-        // Failed to play card, try next card next tick
+        // Failed to play card, try next card next step
         NextCardToPlayIndex = (NextCardToPlayIndex + 1) % EnemyHand.Num();
+        ScheduleNextTurnStep();
     }
     else
     {
@@ -198,6 +251,7 @@ void UEnemyAIComponent::ProcessEnemyTurnStep()
         if (EnemyHand.Num() > 0)
         {
             NextCardToPlayIndex = NextCardToPlayIndex % EnemyHand.Num();
+            ScheduleNextTurnStep();
         }
         else
         {
@@ -208,11 +262,22 @@ void UEnemyAIComponent::ProcessEnemyTurnStep()
 
 int32 UEnemyAIComponent::SelectCardToPlay_Implementation()
 {
+    KCK_TRACE_SCOPE(KCK_EnemySelectCard);
+
     if (EnemyHand.Num() == 0)
     {
         return -1;
     }
 
+    if (AIMode == EEnemyAIMode::PolicyTable)
+    {
+        const int32 PolicyIndex = SelectCardFromPolicyTable();
+        if (PolicyIndex != -1)
+        {
+            return PolicyIndex;
+        }
+    }
+
     for (int32 i = 0; i < EnemyHand.Num(); i++)
     {
         int32 IndexToTry = (NextCardToPlayIndex + i) % EnemyHand.Num();
@@ -225,17 +290,58 @@ int32 UEnemyAIComponent::SelectCardToPlay_Implementation()
     return -1;
 }
 
-void UEnemyAIComponent::EndTurn()
+int32 UEnemyAIComponent::SelectCardFromPolicyTable() const
 {
-    bIsEnemyTurnActive = false;
+    if (!PolicyTable || !CombatManager)
+    {
+        return -1;
+    }
+
+    // Playability must match the bake's, or the key names a hand the table never saw
+    const int32 OwnCreatures = CombatManager->EnemyBattlefield.Num();
+    FEnemyPolicyStateInput Input;
+    Input.Energy = CurrentEnergy;
+    for (const FCardData& Card : EnemyHand)
+    {
+        if (PolicyTable->IsPlayable(Card, CurrentEnergy, OwnCreatures))
+        {
+            Input.PlayableCardIDs.Add(Card.ID);
+        }
+    }
+    Input.OwnCreatures = OwnCreatures;
+    Input.OpposingCreatures = CombatManager->PlayerBattlefield.Num();
+    Input.OwnHealthFraction = CombatManager->GetEnemyHealthPercent();
+    Input.OpposingHealthFraction = CombatManager->GetPlayerHealthPercent();
+
+    const int32 BestCardID = PolicyTable->FindBestCard(Input);
+    if (BestCardID == INDEX_NONE)
+    {
+        return -1;
+    }
 
-    if (GetWorld())
+    for (int32 i = 0; i < EnemyHand.Num(); i++)
+    {
+        if (EnemyHand[i].ID == BestCardID && PolicyTable->IsPlayable(EnemyHand[i], CurrentEnergy, OwnCreatures))
+        {
+            return i;
+        }
+    }
+
+    return -1;
+}
+
+void UEnemyAIComponent::EndTurn()
+{
+    if (CombatManager)
     {
-        GetWorld()->GetTimerManager().ClearTimer(EnemyTurnStepTimerHandle);
+        CombatManager->RecordCombatAction(ECombatJournalAction::EnemyTurnEnded);
     }
 
+    bIsEnemyTurnActive = false;
+
     ClearHand();
 
+    KCK_TRACE_BROADCAST();
     OnEnemyAITurnEnded.Broadcast();
 }
 
@@ -248,11 +354,11 @@ void UEnemyAIComponent::ModifyEnemyHealth(int32 HealthDelta)
     {
         int32 Damage = -HealthDelta;
 
-        UE_LOG(LogTemp, Log, TEXT("[EnemyAI] Attempting to damage enemy for %d"), Damage);
+        KCK_LOG_HOT(LogKevesCardKitAI, Verbose, TEXT("[EnemyAI] Attempting to damage enemy for %d"), Damage);
 
         if (DamageFirstAvailableEnemyCard(Damage))
         {
-            UE_LOG(LogTemp, Log, TEXT("[EnemyAI] Damage applied to enemy battlefield card"));
+            KCK_LOG_HOT(LogKevesCardKitAI, Verbose, TEXT("[EnemyAI] Damage applied to enemy battlefield card"));
             return;
         }
 
@@ -263,6 +369,7 @@ void UEnemyAIComponent::ModifyEnemyHealth(int32 HealthDelta)
         Health = FMath::Min(MaxHealth, Health + HealthDelta);
     }
 
+    KCK_TRACE_BROADCAST();
     OnEnemyHealthChanged.Broadcast(Health);
 }
 
@@ -3,12 +3,23 @@
 #include "CoreMinimal.h"
 #include "Components/ActorComponent.h"
 #include "CardTypesHost.h"
+#include "CombatStateHash.h"
 #include "EnemyAIComponent.generated.h"
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnEnemyAIAttemptedPlay, const FCardData&, CardPlayed);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnEnemyAITurnEnded);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnEnemyHealthChanged, int32, NewHealth);
 
+class UEnemyPolicyTable;
+class FCardCatalog;
+
+UENUM(BlueprintType)
+enum class EEnemyAIMode : uint8
+{
+    Simple          UMETA(DisplayName = "Simple (first affordable card)"),
+    PolicyTable     UMETA(DisplayName = "Policy Table (offline baked)")
+};
+
 UCLASS(ClassGroup = (Custom), meta = (BlueprintSpawnableComponent))
 class KEVESCARDKIT_API UEnemyAIComponent : public UActorComponent
 {
@@ -26,6 +37,14 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Enemy AI")
     int32 MaxEnergyPerTurn = 3;
 
+    // How SelectCardToPlay chooses a card. PolicyTable falls back to Simple for unbaked states.
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Enemy AI")
+    EEnemyAIMode AIMode = EEnemyAIMode::Simple;
+
+    // Baked policy for this enemy's deck (see UEnemyPolicyTable::Bake)
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Enemy AI")
+    UEnemyPolicyTable* PolicyTable = nullptr;
+
     UPROPERTY(BlueprintAssignable, Category = "Enemy AI")
     FOnEnemyHealthChanged OnEnemyHealthChanged;
 
@@ -42,11 +61,11 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Enemy AI")
     void InitializeEnemyAI(const TArray<int32>& DeckCardIDs);
 
-    // Start the enemy turn, triggers incremental card plays every 2.5 seconds
+    // Start the enemy turn; each card play waits for the previous play's presentation to finish
     UFUNCTION(BlueprintCallable, Category = "Enemy AI")
     void StartEnemyTurn();
 
-    // Called on timer tick to process one step of enemy logic (try play one card)
+    // Called by the combat sequencer to process one step of enemy logic (try play one card)
     UFUNCTION(BlueprintCallable, Category = "Enemy AI")
     void ProcessEnemyTurnStep();
 
@@ -57,7 +76,7 @@ public:
     bool DamageFirstAvailableEnemyCard(int32 Damage);
 
     UFUNCTION(BlueprintCallable, Category = "Enemy AI")
-    void ResetEnergy() { CurrentEnergy = MaxEnergyPerTurn; }
+    void ResetEnergy() { SetCurrentEnergy(MaxEnergyPerTurn); }
 
     UFUNCTION(BlueprintCallable, Category = "Enemy AI")
     void SetCurrentEnergy(int32 NewEnergy);
@@ -69,6 +88,9 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Enemy AI")
     int32 GetHandSize() const { return EnemyHand.Num(); }
 
+    UFUNCTION(BlueprintCallable, Category = "Enemy AI")
+    int32 GetDiscardPileSize() const { return DiscardPileCardIDs.Num(); }
+
     UFUNCTION(BlueprintCallable, Category = "Enemy AI")
     FCardData GetCardInHand(int32 Index) const;
 
@@ -87,6 +109,9 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Enemy AI")
     void DrawCards(int32 Count);
 
+    // Enemy piles and energy as folded into ACombatManager::GetCombatStateHash
+    const FCombatStateHash& GetStateHash() const { return StateHash; }
+
     // Delegate when AI attempts to play a card
     UPROPERTY(BlueprintAssignable, Category = "Enemy AI")
     FOnEnemyAIAttemptedPlay OnEnemyAIAttemptedPlay;
@@ -113,7 +138,10 @@ protected:
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Enemy AI")
     UDataTable* CardDataTable;
 
-    FCardData* FindCardByID(int32 CardID) const;
+    // O(1) via the shared card catalog
+    const FCardData* FindCardByID(int32 CardID);
+
+    TSharedPtr<const FCardCatalog, ESPMode::ThreadSafe> Catalog;
 
     // BlueprintNativeEvent so AI logic can be overridden in Blueprints
     UFUNCTION(BlueprintNativeEvent, Category = "Enemy AI")
@@ -122,15 +150,35 @@ protected:
     UFUNCTION(BlueprintCallable, Category = "Enemy AI")
     void EndTurn();
 
+    // O(1) lookup in PolicyTable; returns a hand index or -1 if the state is not in the table
+    int32 SelectCardFromPolicyTable() const;
+
 public:
     UFUNCTION(BlueprintCallable, Category = "Enemy AI")
     void SetCombatManager(ACombatManager* InCombatManager);
 
+    UFUNCTION(BlueprintCallable, Category = "Enemy AI")
+    void SetCardDataTable(UDataTable* InCardDataTable) { CardDataTable = InCardDataTable; }
+
+    // True from StartEnemyTurn until EndTurn
+    UFUNCTION(BlueprintPure, Category = "Enemy AI")
+    bool IsEnemyTurnActive() const { return bIsEnemyTurnActive; }
+
+    // Journal replay (see ACombatManager::ResumeRunCombat) drives the turn itself: start it without
+    // scheduling steps, end it on the journaled record, and hand back to the step loop where the journal stops
+    void BeginTurnWithoutSteps();
+    void ReplayEndTurn() { EndTurn(); }
+    void ResumeTurnSteps() { ScheduleNextTurnStep(); }
+
 protected:
     // For incremental play logic
     int32 NextCardToPlayIndex = 0;
 
-    FTimerHandle EnemyTurnStepTimerHandle;
+    // Queue ProcessEnemyTurnStep behind any outstanding presentation holds
+    void ScheduleNextTurnStep();
 
     bool bIsEnemyTurnActive = false;
+
+    // Incrementally maintained hash of enemy deck/hand/discard contents and energy
+    FCombatStateHash StateHash;
 };
@@ -0,0 +1,185 @@
+// EnemyPolicyTable.cpp - Policy table baking and lookup
+#include "EnemyPolicyTable.h"
+#include "KevesCardKitLog.h"
+#include "HeadlessCombatSim.h"
+#include "CombatEvaluatorModel.h"
+#include "Engine/DataTable.h"
+
+namespace EnemyPolicy
+{
+    FORCEINLINE uint32 HealthBucket(float Fraction)
+    {
+        // 4 buckets: <25%, <50%, <75%, >=75%
+        return (uint32)FMath::Clamp(FMath::FloorToInt(Fraction * 4.0f), 0, 3);
+    }
+
+    void MakeInputFromSim(const FHeadlessCombatSim& Sim, const FHeadlessCombatState& State, FEnemyPolicyStateInput& OutInput)
+    {
+        const FSimSide& Own = State.Sides[State.ActiveSide];
+        const FSimSide& Opponent = State.Sides[1 - State.ActiveSide];
+
+        OutInput.Energy = Own.Energy;
+        OutInput.PlayableCardIDs.Reset();
+        for (int32 i = 0; i < Own.Hand.Num(); i++)
+        {
+            if (Sim.CanPlayCard(State, i))
+            {
+                OutInput.PlayableCardIDs.Add(Own.Hand[i]);
+            }
+        }
+        OutInput.OwnCreatures = Own.Field.Num();
+        OutInput.OpposingCreatures = Opponent.Field.Num();
+        OutInput.OwnHealthFraction = Own.MaxHealth > 0 ? (float)Own.Health / Own.MaxHealth : 0.0f;
+        OutInput.OpposingHealthFraction = Opponent.MaxHealth > 0 ? (float)Opponent.Health / Opponent.MaxHealth : 0.0f;
+    }
+}
+
+int64 UEnemyPolicyTable::MakeStateKey(const FEnemyPolicyStateInput& Input)
+{
+    // Hand signature: order-independent set of distinct playable cards
+    TArray<int32, TInlineAllocator<16>> SortedIDs(Input.PlayableCardIDs);
+    SortedIDs.Sort();
+
+    uint32 HandSignature = 0x811C9DC5u;
+    int32 PreviousID = INDEX_NONE;
+    for (int32 CardID : SortedIDs)
+    {
+        if (CardID != PreviousID)
+        {
+            HandSignature = HashCombine(HandSignature, GetTypeHash(CardID));
+            PreviousID = CardID;
+        }
+    }
+
+    // Board features packed into the low bits
+    uint32 Features = 0;
+    Features |= (uint32)FMath::Clamp(Input.Energy, 0, 15);
+    Features |= (uint32)FMath::Clamp(Input.OwnCreatures, 0, 7) << 4;
+    Features |= (uint32)FMath::Clamp(Input.OpposingCreatures, 0, 7) << 7;
+    Features |= EnemyPolicy::HealthBucket(Input.OwnHealthFraction) << 10;
+    Features |= EnemyPolicy::HealthBucket(Input.OpposingHealthFraction) << 12;
+
+    return (int64)(((uint64)HandSignature << 32) | Features);
+}
+
+int32 UEnemyPolicyTable::FindBestCard(const FEnemyPolicyStateInput& Input) const
+{
+    if (BestCardByStateKey.Num() == 0 || Input.PlayableCardIDs.Num() == 0)
+    {
+        return INDEX_NONE;
+    }
+
+    const int32* CardID = BestCardByStateKey.Find(MakeStateKey(Input));
+    return CardID ? *CardID : INDEX_NONE;
+}
+
+bool UEnemyPolicyTable::IsPlayable(const FCardData& Card, int32 Energy, int32 OwnCreatures) const
+{
+    return FHeadlessCombatSim::IsPlayable(Card.Cost, FHeadlessCombatSim::IsCreatureCard(Card), Energy, OwnCreatures, MaxCreatures);
+}
+
+void UEnemyPolicyTable::Bake()
+{
+    if (!CardDataTable || EnemyDeckCardIDs.Num() == 0)
+    {
+        UE_LOG(LogKevesCardKitAI, Warning, TEXT("[EnemyPolicy] %s: CardDataTable and EnemyDeckCardIDs are required to bake"), *GetName());
+        return;
+    }
+
+    const double StartTime = FPlatformTime::Seconds();
+
+    FHeadlessCombatSim Sim(CardDataTable);
+    Sim.MaxCreatures = MaxCreatures;
+    FRandomStream Random(RandomSeed);
+
+    BestCardByStateKey.Reset();
+    int32 StatesScored = 0;
+
+    FEnemyPolicyStateInput Input;
+    FHeadlessCombatState State;
+    FHeadlessCombatState Trial;
+
+    for (int32 Game = 0; Game < NumSampleCombats; Game++)
+    {
+        Sim.StartCombat(State, PlayerDeckCardIDs, EnemyDeckCardIDs, PlayerHealth, EnemyHealth, Random);
+
+        while (Sim.GetWinner(State) == 0 && State.Turn < 40)
+        {
+            if (State.ActiveSide == 0)
+            {
+                Sim.PlayRandomTurn(State, Random);
+                continue;
+            }
+
+            // Enemy decision point
+            EnemyPolicy::MakeInputFromSim(Sim, State, Input);
+            if (Input.PlayableCardIDs.Num() == 0)
+            {
+                Sim.EndTurn(State, Random);
+                continue;
+            }
+
+            const int64 Key = MakeStateKey(Input);
+            int32* KnownBest = BestCardByStateKey.Find(Key);
+
+            if (!KnownBest)
+            {
+                // Score each distinct playable card by enemy win rate over random playouts
+                int32 BestCardID = INDEX_NONE;
+                float BestWins = -1.0f;
+                TSet<int32, DefaultKeyFuncs<int32>, TInlineSetAllocator<16>> Tried;
+
+                const FSimSide& Enemy = State.Enemy();
+                for (int32 HandIndex = 0; HandIndex < Enemy.Hand.Num(); HandIndex++)
+                {
+                    const int32 CardID = Enemy.Hand[HandIndex];
+                    if (!Sim.CanPlayCard(State, HandIndex) || Tried.Contains(CardID))
+                    {
+                        continue;
+                    }
+                    Tried.Add(CardID);
+
+                    float Wins = 0.0f;
+                    for (int32 Rollout = 0; Rollout < RolloutsPerCandidate; Rollout++)
+                    {
+                        Trial = State;
+                        Sim.PlayCard(Trial, HandIndex, Random);
+
+                        const int32 Winner = LeafEvaluator ? Sim.Rollout(Trial, Random, LeafDepthTurns) : Sim.Rollout(Trial, Random);
+                        if (Winner != 0)
+                        {
+                            Wins += Winner < 0 ? 1.0f : 0.0f;
+                        }
+                        else if (LeafEvaluator)
+                        {
+                            // Enemy win chance is the complement of the player's
+                            Wins += 1.0f - LeafEvaluator->Evaluate(FCombatFeatures::FromSim(Trial));
+                        }
+                    }
+
+                    if (Wins > BestWins)
+                    {
+                        BestWins = Wins;
+                        BestCardID = CardID;
+                    }
+                }
+
+                KnownBest = &BestCardByStateKey.Add(Key, BestCardID);
+                StatesScored++;
+            }
+
+            // Follow the baked policy so later states are ones the enemy will actually reach
+            const int32 HandIndex = State.Enemy().Hand.IndexOfByKey(*KnownBest);
+            if (HandIndex == INDEX_NONE || !Sim.PlayCard(State, HandIndex, Random))
+            {
+                Sim.EndTurn(State, Random);
+            }
+        }
+    }
+
+    BestCardByStateKey.Compact();
+    MarkPackageDirty();
+
+    UE_LOG(LogKevesCardKitAI, Display, TEXT("[EnemyPolicy] %s: baked %d states from %d combats in %.2fs"),
+        *GetName(), StatesScored, NumSampleCombats, FPlatformTime::Seconds() - StartTime);
+}
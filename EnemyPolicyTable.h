@@ -0,0 +1,90 @@
+// EnemyPolicyTable.h - Offline-baked enemy policy (abstract state key -> best card) for O(1) AI decisions
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "EnemyPolicyTable.generated.h"
+
+class UDataTable;
+class UCombatEvaluatorModel;
+struct FCardData;
+
+// Abstracted view of an enemy decision point. Only hand cards passing UEnemyPolicyTable::IsPlayable should be listed.
+struct KEVESCARDKIT_API FEnemyPolicyStateInput
+{
+    int32 Energy = 0;
+    TArray<int32, TInlineAllocator<16>> PlayableCardIDs;
+    int32 OwnCreatures = 0;
+    int32 OpposingCreatures = 0;
+    float OwnHealthFraction = 1.0f;
+    float OpposingHealthFraction = 1.0f;
+};
+
+UCLASS(BlueprintType)
+class KEVESCARDKIT_API UEnemyPolicyTable : public UDataAsset
+{
+    GENERATED_BODY()
+
+public:
+    // === BAKE SETTINGS ===
+
+    // Enemy deck this table is baked for (copy of FEnemyData::EnemyDeckCardIDs)
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Policy|Bake")
+    TArray<int32> EnemyDeckCardIDs;
+
+    // Representative player deck to simulate against
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Policy|Bake")
+    TArray<int32> PlayerDeckCardIDs;
+
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Policy|Bake")
+    UDataTable* CardDataTable = nullptr;
+
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Policy|Bake")
+    int32 PlayerHealth = 20;
+
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Policy|Bake")
+    int32 EnemyHealth = 100;
+
+    // Number of simulated combats used to discover decision states
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Policy|Bake")
+    int32 NumSampleCombats = 200;
+
+    // Random playouts per candidate card when scoring a state
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Policy|Bake")
+    int32 RolloutsPerCandidate = 16;
+
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Policy|Bake")
+    int32 RandomSeed = 1337;
+
+    // Creature cap the enemy plays under, both in the baking simulation and when building runtime keys
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Policy|Bake", meta = (ClampMin = "1"))
+    int32 MaxCreatures = 6;
+
+    // Optional leaf evaluator. When set, playouts stop after LeafDepthTurns and are scored by the model.
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Policy|Bake")
+    UCombatEvaluatorModel* LeafEvaluator = nullptr;
+
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Policy|Bake", meta = (EditCondition = "LeafEvaluator != nullptr"))
+    int32 LeafDepthTurns = 3;
+
+    // === BAKED DATA ===
+
+    // Abstract state key -> card ID to play
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Policy|Baked")
+    TMap<int64, int32> BestCardByStateKey;
+
+    // === FUNCTIONS ===
+
+    // Build the abstract key used both when baking and at runtime
+    static int64 MakeStateKey(const FEnemyPolicyStateInput& Input);
+
+    // Returns the card ID to play for this state, or INDEX_NONE if the state was never baked
+    int32 FindBestCard(const FEnemyPolicyStateInput& Input) const;
+
+    // Whether a hand card counts as playable, by the same rule the bake used for its keys
+    bool IsPlayable(const FCardData& Card, int32 Energy, int32 OwnCreatures) const;
+
+    // Run the headless simulation and rebuild BestCardByStateKey
+    UFUNCTION(BlueprintCallable, Category = "Policy", CallInEditor)
+    void Bake();
+};
@@ -1,7 +1,11 @@
 #include "HandManager.h"
+#include "KevesCardKitLog.h"
+#include "KevesCardKitTrace.h"
+#include "KevesCardKitMemory.h"
 #include "CardActor.h"
 #include "Engine/World.h"
 #include "CombatManager.h"
+#include "CardAbilityInterpreter.h"
 
 AHandManager::AHandManager()
 {
@@ -16,41 +20,53 @@ AHandManager::AHandManager()
 void AHandManager::SetCombatManager(ACombatManager* InCombatManager)
 {
     CombatManager = InCombatManager;
-    UE_LOG(LogTemp, Log, TEXT("[HandManager] CombatManager reference set"));
+    UE_LOG(LogKevesCardKitHand, Log, TEXT("[HandManager] CombatManager reference set"));
 }
 
 void AHandManager::BeginPlay()
 {
     Super::BeginPlay();
+
+    // Compile at load so the first card played does not pay for it
+    EnsureCatalog();
 }
 
 // ==== CORE HAND MANAGEMENT ====
 
 bool AHandManager::AddCardToHand(int32 CardID)
 {
+    LLM_SCOPE_BYTAG(KevesCardKit_Piles);
+
     if (CurrentHand.Num() >= MaxHandSize)
     {
-        UE_LOG(LogTemp, Warning, TEXT("[HandManager] Hand is full! Cannot add card ID %d"), CardID);
+        UE_LOG(LogKevesCardKitHand, Warning, TEXT("[HandManager] Hand is full! Cannot add card ID %d"), CardID);
         return false;
     }
 
-    FCardData* FoundCard = FindCardByID(CardID);
+    const FCardData* FoundCard = FindCardByID(CardID);
     if (!FoundCard)
     {
-        UE_LOG(LogTemp, Warning, TEXT("[HandManager] Card ID %d not found in CardDataTable"), CardID);
+        UE_LOG(LogKevesCardKitHand, Warning, TEXT("[HandManager] Card ID %d not found in CardDataTable"), CardID);
         return false;
     }
 
     // Add to hand
-    CurrentHand.Add(*FoundCard);
+    FCardData AddedCard = *FoundCard;
+    HandInstanceIDs.Add(TrackHandInstance(AddedCard));
+    CurrentHand.Add(AddedCard);
+    PileHash.AddPileCard(ECombatHashPile::PlayerHand, CardID);
+    KCK_TRACE_CARD_DRAWN();
+
+    RecomputePlayableMask();
 
     // Broadcast individual card added event
-    OnCardAddedToHand.Broadcast(*FoundCard);
+    KCK_TRACE_BROADCAST();
+    OnCardAddedToHand.Broadcast(AddedCard);
 
     // Broadcast overall hand updated event
-    OnHandUpdated.Broadcast(CurrentHand, CurrentHand.Num());
+    BroadcastHandUpdated(SlotRangeMask(CurrentHand.Num() - 1, CurrentHand.Num()));
 
-    UE_LOG(LogTemp, Log, TEXT("[HandManager] Added card '%s' to hand (Total: %d cards)"),
+    KCK_LOG_HOT(LogKevesCardKitHand, Verbose, TEXT("[HandManager] Added card '%s' to hand (Total: %d cards)"),
         *FoundCard->Name.ToString(), CurrentHand.Num());
 
     return true;
@@ -60,20 +76,25 @@ bool AHandManager::RemoveCardFromHand(int32 HandIndex)
 {
     if (!CurrentHand.IsValidIndex(HandIndex))
     {
-        UE_LOG(LogTemp, Warning, TEXT("[HandManager] Invalid hand index: %d"), HandIndex);
+        UE_LOG(LogKevesCardKitHand, Warning, TEXT("[HandManager] Invalid hand index: %d"), HandIndex);
         return false;
     }
 
     FCardData RemovedCard = CurrentHand[HandIndex];
+    ReleaseHandInstance(HandIndex);
     CurrentHand.RemoveAt(HandIndex);
+    PileHash.RemovePileCard(ECombatHashPile::PlayerHand, RemovedCard.ID);
+
+    RecomputePlayableMask();
 
     // Broadcast individual card removed event
+    KCK_TRACE_BROADCAST();
     OnCardRemovedFromHand.Broadcast(RemovedCard, HandIndex);
 
-    // Broadcast overall hand updated event
-    OnHandUpdated.Broadcast(CurrentHand, CurrentHand.Num());
+    // Broadcast overall hand updated event (the removed slot and every slot that shifted down)
+    BroadcastHandUpdated(SlotRangeMask(HandIndex, CurrentHand.Num() + 1), SlotRangeMask(HandIndex, CurrentHand.Num()), 1ull << HandIndex);
 
-    UE_LOG(LogTemp, Log, TEXT("[HandManager] Removed card '%s' from hand (Index: %d, Remaining: %d cards)"),
+    KCK_LOG_HOT(LogKevesCardKitHand, Verbose, TEXT("[HandManager] Removed card '%s' from hand (Index: %d, Remaining: %d cards)"),
         *RemovedCard.Name.ToString(), HandIndex, CurrentHand.Num());
 
     return true;
@@ -82,12 +103,22 @@ bool AHandManager::RemoveCardFromHand(int32 HandIndex)
 void AHandManager::ClearHand()
 {
     int32 PreviousSize = CurrentHand.Num();
+    for (const FCardData& Card : CurrentHand)
+    {
+        PileHash.RemovePileCard(ECombatHashPile::PlayerHand, Card.ID);
+    }
+    for (int32 Slot = CurrentHand.Num() - 1; Slot >= 0; Slot--)
+    {
+        ReleaseHandInstance(Slot);
+    }
     CurrentHand.Empty();
 
+    RecomputePlayableMask();
+
     // Broadcast hand updated event
-    OnHandUpdated.Broadcast(CurrentHand, 0);
+    BroadcastHandUpdated(SlotRangeMask(0, PreviousSize), 0, SlotRangeMask(0, PreviousSize));
 
-    UE_LOG(LogTemp, Log, TEXT("[HandManager] Hand cleared (%d cards removed)"), PreviousSize);
+    KCK_LOG_HOT(LogKevesCardKitHand, Verbose, TEXT("[HandManager] Hand cleared (%d cards removed)"), PreviousSize);
 }
 
 void AHandManager::DrawStartingHand()
@@ -95,12 +126,16 @@ void AHandManager::DrawStartingHand()
     ClearHand();
     DrawCards(StartingHandSize);
 
-    UE_LOG(LogTemp, Log, TEXT("[HandManager] Drew starting hand of %d cards"), StartingHandSize);
+    UE_LOG(LogKevesCardKitHand, Log, TEXT("[HandManager] Drew starting hand of %d cards"), StartingHandSize);
 }
 
 void AHandManager::DrawCards(int32 Count)
 {
+    KCK_TRACE_SCOPE(KCK_DrawCards);
+    LLM_SCOPE_BYTAG(KevesCardKit_Piles);
+
     int32 CardsDrawn = 0;
+    const int32 FirstNewSlot = CurrentHand.Num();
 
     for (int32 i = 0; i < Count; i++)
     {
@@ -111,14 +146,14 @@ void AHandManager::DrawCards(int32 Count)
 
             if (PlayerDeck.Num() == 0)
             {
-                UE_LOG(LogTemp, Warning, TEXT("[HandManager] Cannot draw card - deck and discard pile empty"));
+                UE_LOG(LogKevesCardKitHand, Warning, TEXT("[HandManager] Cannot draw card - deck and discard pile empty"));
                 break;
             }
         }
 
         if (CurrentHand.Num() >= MaxHandSize)
         {
-            UE_LOG(LogTemp, Warning, TEXT("[HandManager] Cannot draw card - hand is full"));
+            UE_LOG(LogKevesCardKitHand, Warning, TEXT("[HandManager] Cannot draw card - hand is full"));
             break;
         }
 
@@ -126,17 +161,24 @@ void AHandManager::DrawCards(int32 Count)
         FCardData DrawnCard = PlayerDeck[0];
         PlayerDeck.RemoveAt(0);
 
+        HandInstanceIDs.Add(TrackHandInstance(DrawnCard));
         CurrentHand.Add(DrawnCard);
+        PileHash.RemovePileCard(ECombatHashPile::PlayerDeck, DrawnCard.ID);
+        PileHash.AddPileCard(ECombatHashPile::PlayerHand, DrawnCard.ID);
         CardsDrawn++;
+        KCK_TRACE_CARD_DRAWN();
+
+        RecomputePlayableMask();
 
         // Broadcast individual card added
+        KCK_TRACE_BROADCAST();
         OnCardAddedToHand.Broadcast(DrawnCard);
     }
 
     // Broadcast overall hand update
-    OnHandUpdated.Broadcast(CurrentHand, CurrentHand.Num());
+    BroadcastHandUpdated(SlotRangeMask(FirstNewSlot, CurrentHand.Num()));
 
-    UE_LOG(LogTemp, Log, TEXT("[HandManager] Drew %d cards (Hand: %d, Deck: %d, Discard: %d)"),
+    KCK_LOG_HOT(LogKevesCardKitHand, Verbose, TEXT("[HandManager] Drew %d cards (Hand: %d, Deck: %d, Discard: %d)"),
         CardsDrawn, CurrentHand.Num(), PlayerDeck.Num(), DiscardPileCardIDs.Num());
 }
 
@@ -145,68 +187,122 @@ void AHandManager::DrawCards(int32 Count)
 
 void AHandManager::SetPlayerDeck(const TArray<int32>& CardIDs)
 {
-    PlayerDeck.Empty();
+    LLM_SCOPE_BYTAG(KevesCardKit_Piles);
+
+    EmptyPlayerDeck();
 
     for (int32 CardID : CardIDs)
     {
-        FCardData* FoundCard = FindCardByID(CardID);
+        const FCardData* FoundCard = FindCardByID(CardID);
         if (FoundCard)
         {
             PlayerDeck.Add(*FoundCard);
+            PileHash.AddPileCard(ECombatHashPile::PlayerDeck, CardID);
         }
         else
         {
-            UE_LOG(LogTemp, Warning, TEXT("[HandManager] Card ID %d not found when building deck"), CardID);
+            UE_LOG(LogKevesCardKitHand, Warning, TEXT("[HandManager] Card ID %d not found when building deck"), CardID);
+        }
+    }
+
+    ShuffleDeck();
+    NotePilePeaks();
+    UE_LOG(LogKevesCardKitHand, Log, TEXT("[HandManager] Player deck set with %d cards"), PlayerDeck.Num());
+}
+
+void AHandManager::SetPlayerRunDeck(const TArray<FRunDeckCard>& RunDeck)
+{
+    LLM_SCOPE_BYTAG(KevesCardKit_Piles);
+
+    EmptyPlayerDeck();
+
+    for (const FRunDeckCard& RunCard : RunDeck)
+    {
+        const FCardData* FoundCard = FindCardByID(RunCard.CardID);
+        if (!FoundCard)
+        {
+            UE_LOG(LogKevesCardKitHand, Warning, TEXT("[HandManager] Card ID %d (run instance %d) not found when building deck"),
+                RunCard.CardID, RunCard.InstanceID);
+            continue;
         }
+
+        FCardData& Card = PlayerDeck.Add_GetRef(*FoundCard);
+        Card.Attack += RunCard.AttackBonus;
+        Card.Health += RunCard.HealthBonus;
+        Card.Cost = FMath::Max(0, Card.Cost + RunCard.CostDelta);
+        PileHash.AddPileCard(ECombatHashPile::PlayerDeck, Card.ID);
     }
 
     ShuffleDeck();
-    UE_LOG(LogTemp, Log, TEXT("[HandManager] Player deck set with %d cards"), PlayerDeck.Num());
+    NotePilePeaks();
+    UE_LOG(LogKevesCardKitHand, Log, TEXT("[HandManager] Player deck set from run with %d cards"), PlayerDeck.Num());
+}
+
+void AHandManager::EmptyPlayerDeck()
+{
+    for (const FCardData& Card : PlayerDeck)
+    {
+        PileHash.RemovePileCard(ECombatHashPile::PlayerDeck, Card.ID);
+    }
+    PlayerDeck.Empty();
 }
 
 void AHandManager::AddCardToDeck(int32 CardID)
 {
+    LLM_SCOPE_BYTAG(KevesCardKit_Piles);
+
     // Get a copy of the card by ID from the card datatable and add a fresh copy to the deck.
-    FCardData* FoundCard = FindCardByID(CardID);
+    const FCardData* FoundCard = FindCardByID(CardID);
     if (FoundCard)
     {
         PlayerDeck.Add(*FoundCard);
-        UE_LOG(LogTemp, Log, TEXT("[HandManager] Added card '%s' to deck"), *FoundCard->Name.ToString());
+        PileHash.AddPileCard(ECombatHashPile::PlayerDeck, CardID);
+        KCK_LOG_HOT(LogKevesCardKitHand, Verbose, TEXT("[HandManager] Added card '%s' to deck"), *FoundCard->Name.ToString());
     }
 }
 
 void AHandManager::ShuffleDeck()
 {
-    // Simple shuffle algorithm
+    // Simple shuffle algorithm, on the combat's stream when there is one so a seed reproduces the draw order
+    FRandomStream* Random = CombatManager ? &CombatManager->GetCombatRandom() : nullptr;
     for (int32 i = PlayerDeck.Num() - 1; i > 0; i--)
     {
-        int32 j = FMath::RandRange(0, i);
+        int32 j = Random ? Random->RandRange(0, i) : FMath::RandRange(0, i);
         PlayerDeck.Swap(i, j);
     }
-    UE_LOG(LogTemp, Log, TEXT("[HandManager] Deck shuffled"));
+    UE_LOG(LogKevesCardKitHand, Log, TEXT("[HandManager] Deck shuffled"));
 }
 
 // DISCARD AND BANISH
 
 void AHandManager::AddCardToDiscard(int32 CardID)
 {
+    LLM_SCOPE_BYTAG(KevesCardKit_Piles);
+
     DiscardPileCardIDs.Add(CardID);
+    PileHash.AddPileCard(ECombatHashPile::PlayerDiscard, CardID);
+    NotePilePeaks();
     // Use the CardID since it will be used later to find from the card datatable to reshuffle into the deck.
-    FCardData* FoundCard = FindCardByID(CardID);
+    const FCardData* FoundCard = FindCardByID(CardID);
     if (FoundCard)
     {
-        UE_LOG(LogTemp, Log, TEXT("[HandManager] Card '%s' added to discard pile"), *FoundCard->Name.ToString());
+        KCK_LOG_HOT(LogKevesCardKitHand, Verbose, TEXT("[HandManager] Card '%s' added to discard pile"), *FoundCard->Name.ToString());
     }
     else
     {
-        UE_LOG(LogTemp, Warning, TEXT("[HandManager] Card of CardID %d added to discard pile (no matching data found)"), CardID);
+        UE_LOG(LogKevesCardKitHand, Warning, TEXT("[HandManager] Card of CardID %d added to discard pile (no matching data found)"), CardID);
     }
 }
 
 void AHandManager::ClearDiscardPile()
 {
+    for (int32 CardID : DiscardPileCardIDs)
+    {
+        PileHash.RemovePileCard(ECombatHashPile::PlayerDiscard, CardID);
+    }
     DiscardPileCardIDs.Empty();
-    UE_LOG(LogTemp, Log, TEXT("[HandManager] Discard pile cleared"));
+    NotePilePeaks();
+    KCK_LOG_HOT(LogKevesCardKitHand, Verbose, TEXT("[HandManager] Discard pile cleared"));
 }
 
 void AHandManager::ShuffleDiscardIntoDeck()
@@ -214,40 +310,184 @@ void AHandManager::ShuffleDiscardIntoDeck()
     if (DiscardPileCardIDs.Num() == 0)
         return;
 
+    LLM_SCOPE_BYTAG(KevesCardKit_Piles);
+
     // Get a fresh copy of each discarded card by loading it from the card datatable and adding the copy to the deck
     for (int32 UniqueID : DiscardPileCardIDs)
     {
-        FCardData* FoundCard = FindCardByID(UniqueID);
+        PileHash.RemovePileCard(ECombatHashPile::PlayerDiscard, UniqueID);
+
+        const FCardData* FoundCard = FindCardByID(UniqueID);
         if (FoundCard)
         {
             PlayerDeck.Add(*FoundCard);
+            PileHash.AddPileCard(ECombatHashPile::PlayerDeck, UniqueID);
         }
     }
 
     DiscardPileCardIDs.Empty();
     ShuffleDeck();
+    NotePilePeaks();
 
-    UE_LOG(LogTemp, Log, TEXT("[HandManager] Discard pile shuffled back into deck"));
+    KCK_LOG_HOT(LogKevesCardKitHand, Verbose, TEXT("[HandManager] Discard pile shuffled back into deck"));
 }
 
 void AHandManager::RemoveCardFromAllPilesByCardID(int32 CardID)
 {
-    PlayerDeck.RemoveAll([CardID](const FCardData& Card) { return Card.ID == CardID; });
-    CurrentHand.RemoveAll([CardID](const FCardData& Card) { return Card.ID == CardID; });
-    DiscardPileCardIDs.RemoveAll([CardID](int32 ID) { return ID == CardID; });
+    const int32 RemovedFromDeck = PlayerDeck.RemoveAll([CardID](const FCardData& Card) { return Card.ID == CardID; });
+    int32 RemovedFromHand = 0;
+    for (int32 Slot = CurrentHand.Num() - 1; Slot >= 0; Slot--)
+    {
+        if (CurrentHand[Slot].ID == CardID)
+        {
+            ReleaseHandInstance(Slot);
+            CurrentHand.RemoveAt(Slot);
+            RemovedFromHand++;
+        }
+    }
+    const int32 RemovedFromDiscard = DiscardPileCardIDs.RemoveAll([CardID](int32 ID) { return ID == CardID; });
+
+    for (int32 i = 0; i < RemovedFromDeck; i++)
+    {
+        PileHash.RemovePileCard(ECombatHashPile::PlayerDeck, CardID);
+    }
+    for (int32 i = 0; i < RemovedFromHand; i++)
+    {
+        PileHash.RemovePileCard(ECombatHashPile::PlayerHand, CardID);
+    }
+    if (RemovedFromHand > 0)
+    {
+        RecomputePlayableMask();
+        BroadcastHandUpdated(SlotRangeMask(0, CurrentHand.Num() + RemovedFromHand));
+    }
+    for (int32 i = 0; i < RemovedFromDiscard; i++)
+    {
+        PileHash.RemovePileCard(ECombatHashPile::PlayerDiscard, CardID);
+    }
 
-    UE_LOG(LogTemp, Log, TEXT("[HandManager] Card ID %d removed from all piles"), CardID);
+    KCK_LOG_HOT(LogKevesCardKitHand, Verbose, TEXT("[HandManager] Card ID %d removed from all piles"), CardID);
 }
 
 void AHandManager::BanishCardByID(int32 CardID)
 {
+    LLM_SCOPE_BYTAG(KevesCardKit_Piles);
+
     if (!BanishedCardIDs.Contains(CardID))
     {
         BanishedCardIDs.Add(CardID);
-        UE_LOG(LogTemp, Log, TEXT("[HandManager] Card ID %d added to banished pile"), CardID);
+        PileHash.AddPileCard(ECombatHashPile::PlayerBanished, CardID);
+        KCK_LOG_HOT(LogKevesCardKitHand, Verbose, TEXT("[HandManager] Card ID %d added to banished pile"), CardID);
     }
 
     RemoveCardFromAllPilesByCardID(CardID);
+    NotePilePeaks();
+
+    if (CombatManager)
+    {
+        CombatManager->DispatchCardTrigger(ECardTriggerEvent::CardBanished, true);
+    }
+}
+
+bool AHandManager::BanishCardFromHand(int32 HandIndex)
+{
+    if (!CurrentHand.IsValidIndex(HandIndex))
+    {
+        UE_LOG(LogKevesCardKitHand, Warning, TEXT("[HandManager] BanishCardFromHand: Invalid hand index %d"), HandIndex);
+        return false;
+    }
+
+    const int32 CardID = CurrentHand[HandIndex].ID;
+    RemoveCardFromHand(HandIndex);
+    AddCardToBanishPile(CardID);
+    return true;
+}
+
+void AHandManager::AddCardToBanishPile(int32 CardID)
+{
+    LLM_SCOPE_BYTAG(KevesCardKit_Piles);
+
+    BanishedCardIDs.Add(CardID);
+    PileHash.AddPileCard(ECombatHashPile::PlayerBanished, CardID);
+    NotePilePeaks();
+    KCK_LOG_HOT(LogKevesCardKitHand, Verbose, TEXT("[HandManager] Card ID %d banished"), CardID);
+
+    if (CombatManager)
+    {
+        CombatManager->DispatchCardTrigger(ECardTriggerEvent::CardBanished, true);
+    }
+}
+
+void AHandManager::BuffHandSlots(uint64 SlotMask, int32 AttackDelta, int32 HealthDelta)
+{
+    const uint64 ChangedSlots = SlotMask & SlotRangeMask(0, CurrentHand.Num());
+    KCKTargeting::ForEachSlotDescending(ChangedSlots, [this, AttackDelta, HealthDelta](int32 Slot)
+    {
+        FCardData& Card = CurrentHand[Slot];
+        Card.Attack = FMath::Max(0, Card.Attack + AttackDelta);
+        Card.Health = FMath::Max(1, Card.Health + HealthDelta);
+    });
+
+    if (ChangedSlots != 0)
+    {
+        BroadcastHandUpdated(ChangedSlots);
+    }
+}
+
+void AHandManager::RefreshHandInstances(TConstArrayView<int32> InstanceIDs)
+{
+    if (!CombatManager)
+    {
+        return;
+    }
+
+    const FCardModifierLayers& Layers = CombatManager->GetModifierLayers();
+    uint64 ChangedSlots = 0;
+    for (int32 InstanceID : InstanceIDs)
+    {
+        const int32 Slot = HandInstanceIDs.IndexOfByKey(InstanceID);
+        const FCardInstanceStats* Stats = Layers.Find(InstanceID);
+        if (!Stats || !CurrentHand.IsValidIndex(Slot))
+        {
+            continue;
+        }
+
+        FCardData& Card = CurrentHand[Slot];
+        Card.Attack = FMath::Max(0, Stats->Attack);
+        Card.Health = FMath::Max(1, Stats->Health);
+        Card.Cost = FMath::Max(0, Stats->Cost);
+        ChangedSlots |= SlotRangeMask(Slot, Slot + 1);
+    }
+
+    if (ChangedSlots != 0)
+    {
+        // Costs may have moved
+        RecomputePlayableMask();
+        BroadcastHandUpdated(ChangedSlots);
+    }
+}
+
+int32 AHandManager::TrackHandInstance(FCardData& Card)
+{
+    const int32 InstanceID = ++ACombatManager::NextUniqueCardID;
+    if (CombatManager)
+    {
+        CombatManager->RegisterHandInstance(InstanceID, Card);
+    }
+    return InstanceID;
+}
+
+void AHandManager::ReleaseHandInstance(int32 HandIndex)
+{
+    if (!HandInstanceIDs.IsValidIndex(HandIndex))
+    {
+        return;
+    }
+
+    if (CombatManager)
+    {
+        CombatManager->UnregisterHandInstance(HandInstanceIDs[HandIndex]);
+    }
+    HandInstanceIDs.RemoveAt(HandIndex);
 }
 
 
@@ -255,15 +495,22 @@ void AHandManager::BanishCardByID(int32 CardID)
 
 bool AHandManager::PlayCard(int32 HandIndex, AActor* Target)
 {
+    KCK_TRACE_SCOPE(KCK_PlayCard);
+
     if (!CurrentHand.IsValidIndex(HandIndex))
     {
-        UE_LOG(LogTemp, Warning, TEXT("[HandManager] PlayCard: Invalid hand index %d"), HandIndex);
+        UE_LOG(LogKevesCardKitHand, Warning, TEXT("[HandManager] PlayCard: Invalid hand index %d"), HandIndex);
         return false;
     }
 
     FCardData PlayedCard = CurrentHand[HandIndex];
 
-    UE_LOG(LogTemp, Log, TEXT("[HandManager] Playing card: %s at index %d"),
+    if (CombatManager)
+    {
+        CombatManager->RecordCombatAction(ECombatJournalAction::PlayerCard, HandIndex, PlayedCard.ID, Target);
+    }
+
+    KCK_LOG_HOT(LogKevesCardKitHand, Verbose, TEXT("[HandManager] Playing card: %s at index %d"),
         *PlayedCard.Name.ToString(), HandIndex);
 
     // Step 1: Deal damage if card has Attack > 0
@@ -271,44 +518,49 @@ bool AHandManager::PlayCard(int32 HandIndex, AActor* Target)
     {
         if (CombatManager)
         {
-            UE_LOG(LogTemp, Log, TEXT("[HandManager] Card has %d Attack - dealing damage to enemy"), PlayedCard.Attack);
+            KCK_LOG_HOT(LogKevesCardKitHand, Verbose, TEXT("[HandManager] Card has %d Attack - dealing damage to enemy"), PlayedCard.Attack);
             CombatManager->DamageEnemy(PlayedCard.Attack);
         }
         else
         {
-            UE_LOG(LogTemp, Warning, TEXT("[HandManager] Cannot deal damage - CombatManager is null"));
+            UE_LOG(LogKevesCardKitHand, Warning, TEXT("[HandManager] Cannot deal damage - CombatManager is null"));
         }
     }
 
-    // Step 2: Execute ability if card has one
-    if (CardActorClass)
-    {
-        UE_LOG(LogTemp, Log, TEXT("[HandManager] Creating CardActor for ability execution"));
-        ACardActor* TempCardActor = GetWorld()->SpawnActor<ACardActor>(CardActorClass);
-        if (TempCardActor)
-        {
-            UE_LOG(LogTemp, Log, TEXT("[HandManager] CardActor created successfully"));
-            TempCardActor->InitializeCard(PlayedCard, CardDataTable, AbilityDataTable);
-            TempCardActor->ActivateAbility(Target);
-            TempCardActor->Destroy();
-        }
-        else
-        {
-            UE_LOG(LogTemp, Warning, TEXT("[HandManager] Failed to create CardActor"));
-        }
-    }
-    else
+    // Buffs on the card itself go into play with it; hand auras stay behind (cost stays as paid)
+    const int32 EnergySpent = PlayedCard.Cost;
+    if (CombatManager)
     {
-        UE_LOG(LogTemp, Warning, TEXT("[HandManager] No CardActorClass set - ability will not execute"));
+        CombatManager->GetCarriedCardStats(GetHandInstanceID(HandIndex), PlayedCard);
+        CombatManager->NoteCardPlayedThisTurn(PlayedCard.ID, true);
+
+        // Pay before the ability runs, as the enemy does, so "Energy" in value expressions means the same on both sides
+        CombatManager->SpendEnergy(EnergySpent);
     }
 
-    // Remove card from hand (this will broadcast the removal automatically)
+    // Step 2: Remove card from hand before its ability runs, so draws and banishes see the freed slot
+    // (this will broadcast the removal automatically)
     RemoveCardFromHand(HandIndex);
 
+    // Step 3: Run the card's compiled ability program (triggered abilities register when the permanent enters play instead)
+    const FCardCatalog::FRef CatalogRef = GetCatalog();
+    if (PlayedCard.AbilityID > 0 && CatalogRef->GetAbilityTrigger(PlayedCard.AbilityID) == ECardTriggerEvent::None)
+    {
+        FCardAbilityContext Context;
+        Context.HandManager = this;
+        Context.CombatManager = CombatManager;
+        Context.bCasterIsPlayer = true;
+        Context.SourceCard = &PlayedCard;
+        Context.ChosenTarget = Target;
+        Context.EnergySpent = EnergySpent;
+        KCKAbility::Execute(*CatalogRef, PlayedCard.AbilityID, Context);
+    }
+
     // Broadcast card played event
+    KCK_TRACE_BROADCAST();
     OnCardPlayed.Broadcast(PlayedCard);
 
-    UE_LOG(LogTemp, Log, TEXT("[HandManager] Successfully played card: %s"), *PlayedCard.Name.ToString());
+    KCK_LOG_HOT(LogKevesCardKitHand, Verbose, TEXT("[HandManager] Successfully played card: %s"), *PlayedCard.Name.ToString());
 
     return true;
 }
@@ -317,18 +569,15 @@ bool AHandManager::PlayCard(int32 HandIndex, AActor* Target)
 
 FCardData AHandManager::GetCardInHand(int32 Index) const
 {
-    if (CurrentHand.IsValidIndex(Index))
-    {
-        return CurrentHand[Index];
-    }
-    return FCardData(); // Return empty card data if invalid
+    const FCardData* Card = FindCardInHand(Index);
+    return Card ? *Card : FCardData(); // Return empty card data if invalid
 }
 
 bool AHandManager::CanPlayCard(int32 HandIndex, int32 CurrentEnergy) const
 {
     if (!CurrentHand.IsValidIndex(HandIndex))
     {
-        UE_LOG(LogTemp, VeryVerbose, TEXT("[HandManager] CanPlayCard: Invalid hand index %d"), HandIndex);
+        KCK_LOG_HOT(LogKevesCardKitHand, VeryVerbose, TEXT("[HandManager] CanPlayCard: Invalid hand index %d"), HandIndex);
         return false;
     }
 
@@ -342,26 +591,137 @@ bool AHandManager::CanPlayCard(int32 HandIndex, int32 CurrentEnergy) const
 
     bool bCanAfford = Card.Cost <= CurrentEnergy;
 
-    UE_LOG(LogTemp, VeryVerbose, TEXT("[HandManager] CanPlayCard: %s (Cost: %d, Available: %d) = %s"),
+    KCK_LOG_HOT(LogKevesCardKitHand, VeryVerbose, TEXT("[HandManager] CanPlayCard: %s (Cost: %d, Available: %d) = %s"),
         *Card.Name.ToString(), Card.Cost, CurrentEnergy, bCanAfford ? TEXT("Yes") : TEXT("No"));
 
     return bCanAfford;
 }
 
-// ==== PRIVATE HELPER FUNCTIONS ====
+void AHandManager::SetAvailableEnergy(int32 NewEnergy)
+{
+    if (AvailableEnergy != NewEnergy)
+    {
+        AvailableEnergy = NewEnergy;
+        RecomputePlayableMask();
+    }
+}
 
-FCardData* AHandManager::FindCardByID(int32 CardID)
+void AHandManager::NotifyHandCardsChanged()
 {
-    // This is only for finding BASE data from the card datatable, NOT for tracking realtime cards!
-    if (!CardDataTable) return nullptr;
+    RecomputePlayableMask();
+}
 
-    for (const FName& RowName : CardDataTable->GetRowNames())
+bool AHandManager::IsCardPlayable(int32 HandIndex) const
+{
+    return HandIndex >= 0 && HandIndex < 64 && (PlayableHandMask & (1ull << HandIndex)) != 0;
+}
+
+void AHandManager::RecomputePlayableMask()
+{
+    uint64 Mask = 0;
+    const int32 NumSlots = FMath::Min(CurrentHand.Num(), 64);
+    for (int32 i = 0; i < NumSlots; i++)
     {
-        FCardData* FoundCard = CardDataTable->FindRow<FCardData>(RowName, TEXT("FindCardByID"));
-        if (FoundCard && FoundCard->ID == CardID)
+        const FCardData& Card = CurrentHand[i];
+
+        // Same rule as CanPlayCard: zero-cost champions are always playable
+        if ((Card.CardType == ECardType::Champion && Card.Cost == 0) || Card.Cost <= AvailableEnergy)
         {
-            return FoundCard;
+            Mask |= 1ull << i;
         }
     }
-    return nullptr;
+    PlayableHandMask = Mask;
+}
+
+void AHandManager::BroadcastHandUpdated(uint64 ChangedSlotMask, uint64 ShiftedSlotMask, uint64 RemovedSlotMask)
+{
+    LastHandChange.ChangedSlotMask = (int64)ChangedSlotMask;
+    LastHandChange.ShiftedSlotMask = (int64)ShiftedSlotMask;
+    LastHandChange.RemovedSlotMask = (int64)RemovedSlotMask;
+    LastHandChange.HandSize = CurrentHand.Num();
+    LastHandChange.DeckSize = PlayerDeck.Num();
+    LastHandChange.Version++;
+
+    NotePilePeaks();
+
+    KCK_TRACE_BROADCAST();
+    OnHandUpdated.Broadcast(LastHandChange);
+}
+
+void AHandManager::ResetPilePeaks()
+{
+    PeakHandSize = 0;
+    PeakDeckSize = 0;
+    PeakDiscardSize = 0;
+    NotePilePeaks();
+}
+
+void AHandManager::NotePilePeaks()
+{
+    PeakHandSize = FMath::Max(PeakHandSize, CurrentHand.Num());
+    PeakDeckSize = FMath::Max(PeakDeckSize, PlayerDeck.Num());
+    PeakDiscardSize = FMath::Max(PeakDiscardSize, DiscardPileCardIDs.Num());
+
+    KCKMemory::SetBytes(ECardKitMemoryCategory::Piles, PlayerDeck.GetAllocatedSize() + CurrentHand.GetAllocatedSize()
+        + HandInstanceIDs.GetAllocatedSize() + DiscardPileCardIDs.GetAllocatedSize() + BanishedCardIDs.GetAllocatedSize());
+}
+
+
+uint64 AHandManager::SlotRangeMask(int32 FirstSlot, int32 EndSlot)
+{
+    FirstSlot = FMath::Clamp(FirstSlot, 0, 64);
+    EndSlot = FMath::Clamp(EndSlot, FirstSlot, 64);
+    if (FirstSlot == EndSlot)
+    {
+        return 0;
+    }
+
+    const uint64 BelowEnd = EndSlot == 64 ? ~0ull : ((1ull << EndSlot) - 1);
+    const uint64 BelowFirst = (1ull << FirstSlot) - 1;
+    return BelowEnd & ~BelowFirst;
+}
+
+void AHandManager::RebuildPileHash()
+{
+    PileHash.Reset();
+
+    for (const FCardData& Card : PlayerDeck)
+    {
+        PileHash.AddPileCard(ECombatHashPile::PlayerDeck, Card.ID);
+    }
+    for (const FCardData& Card : CurrentHand)
+    {
+        PileHash.AddPileCard(ECombatHashPile::PlayerHand, Card.ID);
+    }
+    for (int32 CardID : DiscardPileCardIDs)
+    {
+        PileHash.AddPileCard(ECombatHashPile::PlayerDiscard, CardID);
+    }
+    for (int32 CardID : BanishedCardIDs)
+    {
+        PileHash.AddPileCard(ECombatHashPile::PlayerBanished, CardID);
+    }
+}
+
+// ==== PRIVATE HELPER FUNCTIONS ====
+
+FCardCatalog::FRef AHandManager::GetCatalog()
+{
+    EnsureCatalog();
+    return Catalog.ToSharedRef();
+}
+
+const FCardCatalog& AHandManager::EnsureCatalog()
+{
+    if (!Catalog || Catalog->IsSuperseded() || Catalog->GetCardTable() != CardDataTable || Catalog->GetAbilityTable() != AbilityDataTable)
+    {
+        Catalog = FCardCatalog::Get(CardDataTable, AbilityDataTable);
+    }
+    return *Catalog;
+}
+
+const FCardData* AHandManager::FindCardByID(int32 CardID)
+{
+    // This is only for finding BASE data from the card datatable, NOT for tracking realtime cards!
+    return EnsureCatalog().FindCard(CardID);
 }
\ No newline at end of file
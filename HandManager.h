@@ -5,9 +5,12 @@
 #include "GameFramework/Actor.h"
 #include "CardTypesHost.h"
 #include "CardActor.h"
+#include "CombatStateHash.h"
+#include "CardCatalog.h"
+#include "RunSave.h"
 #include "HandManager.generated.h"
 
-DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnHandUpdated, const TArray<FCardData>&, CurrentHand, int32, HandSize);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnHandUpdated, const FHandChangeSet&, ChangeSet);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnCardPlayed, const FCardData&, PlayedCard);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnCardAddedToHand, const FCardData&, AddedCard);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnCardRemovedFromHand, const FCardData&, RemovedCard, int32, FormerIndex);
@@ -25,6 +28,7 @@ protected:
 
 public:
     // === CORE DATA ===
+    // Card actor class for Blueprints that want one in the world. PlayCard runs abilities natively and does not spawn it.
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Card System")
     TSubclassOf<ACardActor> CardActorClass;
 
@@ -93,6 +97,10 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Infernal Contracts|Deck", CallInEditor)
     void SetPlayerDeck(const TArray<int32>& CardIDs);
 
+    // Deck of a run, with each copy's permanent upgrades applied
+    UFUNCTION(BlueprintCallable, Category = "Infernal Contracts|Deck")
+    void SetPlayerRunDeck(const TArray<FRunDeckCard>& RunDeck);
+
     UFUNCTION(BlueprintCallable, Category = "Infernal Contracts|Deck", CallInEditor)
     void AddCardToDeck(int32 CardID);
 
@@ -115,6 +123,23 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Card System")
     void BanishCardByID(int32 CardID);
 
+    // Banish one card instance: the one in this hand slot / one that is in no pile (e.g. a card just played)
+    UFUNCTION(BlueprintCallable, Category = "Card System")
+    bool BanishCardFromHand(int32 HandIndex);
+
+    UFUNCTION(BlueprintCallable, Category = "Card System")
+    void AddCardToBanishPile(int32 CardID);
+
+    // Give the cards in the masked hand slots +Attack/+Health (bit N = slot N, see FCardTargetSet).
+    // Edits the slots directly; in combat, ACombatManager::BuffTargets records the buffs as modifiers instead.
+    void BuffHandSlots(uint64 SlotMask, int32 AttackDelta, int32 HealthDelta);
+
+    // Modifier-layer instance of a hand slot (-1 for an invalid slot)
+    int32 GetHandInstanceID(int32 HandIndex) const { return HandInstanceIDs.IsValidIndex(HandIndex) ? HandInstanceIDs[HandIndex] : -1; }
+
+    // Rewrite these instances' slots from the combat manager's modifier layers (called when a modifier changed them)
+    void RefreshHandInstances(TConstArrayView<int32> InstanceIDs);
+
     // Card Playing
     UFUNCTION(BlueprintCallable, Category = "Infernal Contracts|Gameplay", CallInEditor)
     bool PlayCard(int32 HandIndex, AActor* Target = nullptr);
@@ -133,16 +158,116 @@ public:
     UFUNCTION(BlueprintPure, Category = "Infernal Contracts|Info")
     FCardData GetCardInHand(int32 Index) const;
 
+    // Compiled card/ability catalog for CardDataTable + AbilityDataTable (re-fetched if either table is swapped or edited)
+    FCardCatalog::FRef GetCatalog();
+
+    // C++ read-only access to the piles without copying
+    TConstArrayView<FCardData> GetHandView() const { return CurrentHand; }
+    TConstArrayView<FCardData> GetDeckView() const { return PlayerDeck; }
+    TConstArrayView<int32> GetDiscardPileView() const { return DiscardPileCardIDs; }
+    TConstArrayView<int32> GetBanishedView() const { return BanishedCardIDs; }
+
+    // nullptr for an invalid slot
+    const FCardData* FindCardInHand(int32 Index) const { return CurrentHand.IsValidIndex(Index) ? &CurrentHand[Index] : nullptr; }
+
+    UFUNCTION(BlueprintPure, Category = "Infernal Contracts|Info")
+    int32 GetDiscardPileSize() const { return DiscardPileCardIDs.Num(); }
+
+    // Per-field reads for change-set listeners (no FCardData copy). Invalid slots return -1.
+    UFUNCTION(BlueprintPure, Category = "Infernal Contracts|Info")
+    int32 GetCardIDInHand(int32 Index) const { return CurrentHand.IsValidIndex(Index) ? CurrentHand[Index].ID : -1; }
+
+    UFUNCTION(BlueprintPure, Category = "Infernal Contracts|Info")
+    int32 GetCardCostInHand(int32 Index) const { return CurrentHand.IsValidIndex(Index) ? CurrentHand[Index].Cost : -1; }
+
+    UFUNCTION(BlueprintPure, Category = "Infernal Contracts|Info")
+    int32 GetCardAttackInHand(int32 Index) const { return CurrentHand.IsValidIndex(Index) ? CurrentHand[Index].Attack : -1; }
+
+    UFUNCTION(BlueprintPure, Category = "Infernal Contracts|Info")
+    int32 GetCardHealthInHand(int32 Index) const { return CurrentHand.IsValidIndex(Index) ? CurrentHand[Index].Health : -1; }
+
+    // Most recent payload of OnHandUpdated
+    UFUNCTION(BlueprintPure, Category = "Infernal Contracts|Info")
+    FHandChangeSet GetLastHandChange() const { return LastHandChange; }
+
     UFUNCTION(BlueprintPure, Category = "Infernal Contracts|Info")
     bool CanPlayCard(int32 HandIndex, int32 CurrentEnergy = 0) const;
 
+    // O(1) playability against the energy last pushed by the combat manager (ignores turn state)
+    UFUNCTION(BlueprintPure, Category = "Infernal Contracts|Info")
+    bool IsCardPlayable(int32 HandIndex) const;
+
+    // Bit i set = hand slot i is affordable. Kept current on energy, hand and cost changes.
+    UFUNCTION(BlueprintPure, Category = "Infernal Contracts|Info")
+    int64 GetPlayableHandMask() const { return (int64)PlayableHandMask; }
+
+    // Called by ACombatManager whenever player energy changes
+    void SetAvailableEnergy(int32 NewEnergy);
+
+    // Call after editing CurrentHand entries directly (e.g. changing a card's cost)
+    UFUNCTION(BlueprintCallable, Category = "Infernal Contracts|Info")
+    void NotifyHandCardsChanged();
+
     UFUNCTION(BlueprintPure, Category = "Infernal Contracts|Info")
     bool IsHandFull() const { return CurrentHand.Num() >= MaxHandSize; }
 
     UFUNCTION(BlueprintPure, Category = "Infernal Contracts|Info")
     bool IsHandEmpty() const { return CurrentHand.Num() == 0; }
 
+    // High-water marks since the last ResetPilePeaks (read by the combat metrics report)
+    int32 GetPeakHandSize() const { return PeakHandSize; }
+    int32 GetPeakDeckSize() const { return PeakDeckSize; }
+    int32 GetPeakDiscardSize() const { return PeakDiscardSize; }
+    void ResetPilePeaks();
+
+    // State hashing - pile contents as tracked by ACombatManager::GetCombatStateHash
+    const FCombatStateHash& GetPileHash() const { return PileHash; }
+
+    // Recompute the pile hash from scratch (only needed if piles were edited directly from Blueprint)
+    UFUNCTION(BlueprintCallable, Category = "Card System")
+    void RebuildPileHash();
+
 private:
+    // Incrementally maintained hash of deck/hand/discard/banish contents
+    FCombatStateHash PileHash;
+
+    // Fill LastHandChange (bumping its version) and broadcast OnHandUpdated
+    void BroadcastHandUpdated(uint64 ChangedSlotMask, uint64 ShiftedSlotMask = 0, uint64 RemovedSlotMask = 0);
+
+    // Mask with bits [FirstSlot, EndSlot) set
+    static uint64 SlotRangeMask(int32 FirstSlot, int32 EndSlot);
+
+    FHandChangeSet LastHandChange;
+
+    // Playability cache (see IsCardPlayable)
+    void RecomputePlayableMask();
+
+    uint64 PlayableHandMask = 0;
+    int32 AvailableEnergy = 0;
+
+    // One modifier-layer instance per hand slot, kept parallel to CurrentHand
+    TArray<int32> HandInstanceIDs;
+
+    // New instance ID for a card entering the hand; writes its effective stats into Card when in combat
+    int32 TrackHandInstance(FCardData& Card);
+
+    // Drop the instance of a slot that is about to be removed
+    void ReleaseHandInstance(int32 HandIndex);
+
+    // Track pile size peaks for the metrics report and pile storage for KCKMemory
+    void NotePilePeaks();
+
+    int32 PeakHandSize = 0;
+    int32 PeakDeckSize = 0;
+    int32 PeakDiscardSize = 0;
+
+    const FCardCatalog& EnsureCatalog();
+
+    TSharedPtr<const FCardCatalog, ESPMode::ThreadSafe> Catalog;
+
     // Internal helper functions
-    FCardData* FindCardByID(int32 CardID);
+    const FCardData* FindCardByID(int32 CardID);
+
+    // Empty the deck and take its cards out of the pile hash
+    void EmptyPlayerDeck();
 };
@@ -0,0 +1,229 @@
+// HeadlessCombatSim.cpp - Actor-free combat simulation implementation
+#include "HeadlessCombatSim.h"
+#include "Engine/DataTable.h"
+
+FHeadlessCombatSim::FHeadlessCombatSim(const UDataTable* CardDataTable)
+{
+    SetCards(CardDataTable);
+}
+
+void FHeadlessCombatSim::SetCards(const UDataTable* CardDataTable)
+{
+    Cards.Reset();
+
+    if (!CardDataTable) return;
+
+    CardDataTable->ForeachRow<FCardData>(TEXT("HeadlessCombatSim"), [this](const FName& RowName, const FCardData& Card)
+        {
+            AddCard(Card);
+        });
+}
+
+void FHeadlessCombatSim::AddCard(const FCardData& Card)
+{
+    FSimCardInfo& Info = Cards.Add(Card.ID);
+    Info.Cost = Card.Cost;
+    Info.Attack = Card.Attack;
+    Info.Health = Card.Health;
+    Info.bIsCreature = IsCreatureCard(Card);
+}
+
+void FHeadlessCombatSim::StartCombat(FHeadlessCombatState& State, const TArray<int32>& PlayerDeck, const TArray<int32>& EnemyDeck,
+    int32 PlayerHealth, int32 EnemyHealth, FRandomStream& Random) const
+{
+    State = FHeadlessCombatState();
+
+    const TArray<int32>* Decks[2] = { &PlayerDeck, &EnemyDeck };
+    const int32 Healths[2] = { PlayerHealth, EnemyHealth };
+
+    for (int32 SideIndex = 0; SideIndex < 2; SideIndex++)
+    {
+        FSimSide& Side = State.Sides[SideIndex];
+        Side.Health = Side.MaxHealth = Healths[SideIndex];
+
+        // Unknown card IDs are dropped, same as AHandManager::SetPlayerDeck
+        for (int32 CardID : *Decks[SideIndex])
+        {
+            if (Cards.Contains(CardID))
+            {
+                Side.Deck.Add(CardID);
+            }
+        }
+        Shuffle(Side.Deck, Random);
+    }
+
+    State.ActiveSide = 0;
+    StartTurn(State, Random);
+}
+
+bool FHeadlessCombatSim::CanPlayCard(const FHeadlessCombatState& State, int32 HandIndex) const
+{
+    const FSimSide& Side = State.Sides[State.ActiveSide];
+    if (!Side.Hand.IsValidIndex(HandIndex)) return false;
+
+    const FSimCardInfo* Card = Cards.Find(Side.Hand[HandIndex]);
+    return Card && IsPlayable(Card->Cost, Card->bIsCreature, Side.Energy, Side.Field.Num(), MaxCreatures);
+}
+
+bool FHeadlessCombatSim::PlayCard(FHeadlessCombatState& State, int32 HandIndex, FRandomStream& Random) const
+{
+    if (!CanPlayCard(State, HandIndex)) return false;
+
+    FSimSide& Side = State.Sides[State.ActiveSide];
+    FSimSide& Opponent = State.Sides[1 - State.ActiveSide];
+
+    const int32 CardID = Side.Hand[HandIndex];
+    const FSimCardInfo& Card = Cards.FindChecked(CardID);
+
+    Side.Energy -= Card.Cost;
+    Side.Hand.RemoveAtSwap(HandIndex);
+
+    if (Card.bIsCreature)
+    {
+        // Creatures occupy their card until they die
+        FSimCreature& Creature = Side.Field.AddDefaulted_GetRef();
+        Creature.CardID = CardID;
+        Creature.Attack = Card.Attack;
+        Creature.Health = Card.Health;
+    }
+    else
+    {
+        if (Card.Attack > 0)
+        {
+            DamageSide(Opponent, Card.Attack);
+        }
+        Side.Discard.Add(CardID);
+    }
+
+    return true;
+}
+
+void FHeadlessCombatSim::EndTurn(FHeadlessCombatState& State, FRandomStream& Random) const
+{
+    FSimSide& Side = State.Sides[State.ActiveSide];
+    FSimSide& Opponent = State.Sides[1 - State.ActiveSide];
+
+    // Creatures attack automatically when their owner ends the turn
+    for (int32 i = 0; i < Side.Field.Num() && Opponent.Health > 0; i++)
+    {
+        if (Side.Field[i].Attack > 0)
+        {
+            DamageSide(Opponent, Side.Field[i].Attack);
+        }
+    }
+
+    // End of turn discards the hand
+    Side.Discard.Append(Side.Hand);
+    Side.Hand.Reset();
+
+    State.ActiveSide = 1 - State.ActiveSide;
+    if (State.ActiveSide == 0)
+    {
+        State.Turn++;
+    }
+
+    StartTurn(State, Random);
+}
+
+int32 FHeadlessCombatSim::GetWinner(const FHeadlessCombatState& State) const
+{
+    if (State.Player().Health <= 0) return -1;
+    if (State.Enemy().Health <= 0) return 1;
+    return 0;
+}
+
+void FHeadlessCombatSim::PlayRandomTurn(FHeadlessCombatState& State, FRandomStream& Random) const
+{
+    TArray<int32, TInlineAllocator<16>> Playable;
+
+    while (GetWinner(State) == 0)
+    {
+        Playable.Reset();
+        const FSimSide& Side = State.Sides[State.ActiveSide];
+        for (int32 i = 0; i < Side.Hand.Num(); i++)
+        {
+            if (CanPlayCard(State, i))
+            {
+                Playable.Add(i);
+            }
+        }
+
+        if (Playable.Num() == 0)
+        {
+            break;
+        }
+
+        PlayCard(State, Playable[Random.RandRange(0, Playable.Num() - 1)], Random);
+    }
+
+    if (GetWinner(State) == 0)
+    {
+        EndTurn(State, Random);
+    }
+}
+
+int32 FHeadlessCombatSim::Rollout(FHeadlessCombatState& State, FRandomStream& Random, int32 MaxTurns) const
+{
+    const int32 LastTurn = State.Turn + MaxTurns;
+    while (GetWinner(State) == 0 && State.Turn < LastTurn)
+    {
+        PlayRandomTurn(State, Random);
+    }
+    return GetWinner(State);
+}
+
+void FHeadlessCombatSim::StartTurn(FHeadlessCombatState& State, FRandomStream& Random) const
+{
+    FSimSide& Side = State.Sides[State.ActiveSide];
+    Side.Energy = EnergyPerTurn;
+    DrawCards(Side, CardsPerTurn, Random);
+}
+
+void FHeadlessCombatSim::DrawCards(FSimSide& Side, int32 Count, FRandomStream& Random) const
+{
+    for (int32 i = 0; i < Count && Side.Hand.Num() < MaxHandSize; i++)
+    {
+        if (Side.Deck.Num() == 0)
+        {
+            if (Side.Discard.Num() == 0)
+            {
+                break;
+            }
+
+            Side.Deck = MoveTemp(Side.Discard);
+            Side.Discard.Reset();
+            Shuffle(Side.Deck, Random);
+        }
+
+        Side.Hand.Add(Side.Deck.Pop());
+    }
+}
+
+void FHeadlessCombatSim::Shuffle(TArray<int32>& Pile, FRandomStream& Random) const
+{
+    for (int32 i = Pile.Num() - 1; i > 0; i--)
+    {
+        Pile.Swap(i, Random.RandRange(0, i));
+    }
+}
+
+void FHeadlessCombatSim::DamageSide(FSimSide& Side, int32 Damage) const
+{
+    for (int32 i = 0; i < Side.Field.Num(); i++)
+    {
+        FSimCreature& Creature = Side.Field[i];
+        if (Creature.Health > 0)
+        {
+            // Damage is not carried over to the life crystal
+            Creature.Health = FMath::Max(0, Creature.Health - Damage);
+            if (Creature.Health == 0)
+            {
+                Side.Discard.Add(Creature.CardID);
+                Side.Field.RemoveAt(i);
+            }
+            return;
+        }
+    }
+
+    Side.Health = FMath::Max(0, Side.Health - Damage);
+}
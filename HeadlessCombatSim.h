@@ -0,0 +1,113 @@
+// HeadlessCombatSim.h - Actor-free combat simulation for offline tools (policy baking, training, benchmarks)
+#pragma once
+
+#include "CoreMinimal.h"
+#include "CardTypesHost.h"
+
+class UDataTable;
+
+// The subset of a card definition the simulation needs
+struct FSimCardInfo
+{
+    int32 Cost = 0;
+    int32 Attack = 0;
+    int32 Health = 0;
+    bool bIsCreature = false;
+};
+
+struct FSimCreature
+{
+    int32 CardID = 0;
+    int32 Attack = 0;
+    int32 Health = 0;
+};
+
+struct FSimSide
+{
+    int32 Health = 0;
+    int32 MaxHealth = 0;
+    int32 Energy = 0;
+    TArray<int32> Deck;
+    TArray<int32> Hand;
+    TArray<int32> Discard;
+    TArray<FSimCreature> Field;
+};
+
+struct FHeadlessCombatState
+{
+    // Index 0 is the player, index 1 is the enemy
+    FSimSide Sides[2];
+    int32 Turn = 0;
+    int32 ActiveSide = 0;
+
+    FSimSide& Player() { return Sides[0]; }
+    FSimSide& Enemy() { return Sides[1]; }
+    const FSimSide& Player() const { return Sides[0]; }
+    const FSimSide& Enemy() const { return Sides[1]; }
+};
+
+/**
+ * Plain-data model of a combat between the player and an enemy deck, following the rules doc:
+ * draw 5 and refill energy each turn, creatures go to the field (max 6), other cards with Attack
+ * deal damage, creatures attack when their owner ends the turn, damage hits creatures before the
+ * life crystal and never overflows. No actors, timers or delegates, so thousands of games run per second.
+ */
+class KEVESCARDKIT_API FHeadlessCombatSim
+{
+public:
+    FHeadlessCombatSim() = default;
+    explicit FHeadlessCombatSim(const UDataTable* CardDataTable);
+
+    // Card definitions the simulation plays with (keyed by FCardData::ID)
+    void SetCards(const UDataTable* CardDataTable);
+    void AddCard(const FCardData& Card);
+    const FSimCardInfo* FindCard(int32 CardID) const { return Cards.Find(CardID); }
+
+    // Rule settings
+    int32 EnergyPerTurn = 3;
+    int32 CardsPerTurn = 5;
+    int32 MaxHandSize = 7;
+    int32 MaxCreatures = 6;
+
+    // Set up a fresh combat; the player acts first
+    void StartCombat(FHeadlessCombatState& State, const TArray<int32>& PlayerDeck, const TArray<int32>& EnemyDeck,
+        int32 PlayerHealth, int32 EnemyHealth, FRandomStream& Random) const;
+
+    bool CanPlayCard(const FHeadlessCombatState& State, int32 HandIndex) const;
+
+    // The playability rule behind CanPlayCard, for callers holding real combat state (see UEnemyPolicyTable::IsPlayable)
+    static bool IsPlayable(int32 Cost, bool bIsCreature, int32 Energy, int32 NumCreatures, int32 MaxCreatures)
+    {
+        return Cost <= Energy && (!bIsCreature || NumCreatures < MaxCreatures);
+    }
+
+    static bool IsCreatureCard(const FCardData& Card)
+    {
+        return Card.CardType == ECardType::Creature || Card.CardType == ECardType::Champion;
+    }
+
+    // Play a card from the active side's hand. Returns false if it cannot be played.
+    bool PlayCard(FHeadlessCombatState& State, int32 HandIndex, FRandomStream& Random) const;
+
+    // Resolve creature attacks for the active side, then pass the turn
+    void EndTurn(FHeadlessCombatState& State, FRandomStream& Random) const;
+
+    // 1 = player won, -1 = enemy won, 0 = undecided
+    int32 GetWinner(const FHeadlessCombatState& State) const;
+
+    // Plays random affordable cards for the active side until none remain, then ends the turn
+    void PlayRandomTurn(FHeadlessCombatState& State, FRandomStream& Random) const;
+
+    // Random playout to the end of combat (or MaxTurns). Returns GetWinner() of the final state.
+    int32 Rollout(FHeadlessCombatState& State, FRandomStream& Random, int32 MaxTurns = 40) const;
+
+private:
+    void StartTurn(FHeadlessCombatState& State, FRandomStream& Random) const;
+    void DrawCards(FSimSide& Side, int32 Count, FRandomStream& Random) const;
+    void Shuffle(TArray<int32>& Pile, FRandomStream& Random) const;
+
+    // Damage the first living creature, otherwise the life crystal. Dead creatures go to the owner's discard.
+    void DamageSide(FSimSide& Side, int32 Damage) const;
+
+    TMap<int32, FSimCardInfo> Cards;
+};
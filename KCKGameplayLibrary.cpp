@@ -1,4 +1,5 @@
 #include "KCKGameplayLibrary.h"
+#include "KevesCardKitLog.h"
 #include "Engine/World.h"
 #include "Engine/Engine.h"
 #include "GameFramework/Actor.h"
@@ -6,102 +7,49 @@
 #include "CardTypesHost.h"
 #include "Engine/Level.h"
 #include "Kismet/GameplayStatics.h"
+#include "CardCatalog.h"
+#include "CardAbilityInterpreter.h"
+#include "CardTargetSelector.h"
+#include "CombatManager.h"
+#include "GameFramework/DamageType.h"
 
 void UKCKGameplayLibrary::ExecuteAbilityByID(int32 AbilityID, UDataTable* AbilityTable, UDataTable* CardTable, FCardData& CardData, AActor* Caster, AActor* Target)
 {
     if (!AbilityTable || !Caster)
     {
-        UE_LOG(LogTemp, Error, TEXT("[KCK] ExecuteAbilityByID: Missing AbilityTable or Caster"));
+        UE_LOG(LogKevesCardKitAbility, Error, TEXT("[KCK] ExecuteAbilityByID: Missing AbilityTable or Caster"));
         return;
     }
 
-    const FCardAbility* Ability = nullptr;
-
-    // Find the ability by ID
-    for (const FName& Row : AbilityTable->GetRowNames())
+    // Callers traditionally pass the HandManager as Target when nothing was chosen
+    AHandManager* HandManager = Cast<AHandManager>(Target);
+    if (!HandManager)
     {
-        const FCardAbility* TestAbility = AbilityTable->FindRow<FCardAbility>(Row, TEXT("ExecuteAbility"));
-        if (TestAbility && TestAbility->ID == AbilityID)
-        {
-            Ability = TestAbility;
-            break;
-        }
+        HandManager = Cast<AHandManager>(UGameplayStatics::GetActorOfClass(Caster, AHandManager::StaticClass()));
     }
 
-    if (!Ability)
-    {
-        UE_LOG(LogTemp, Warning, TEXT("[KCK] Ability ID %d not found."), AbilityID);
-        return;
-    }
+    const FCardCatalog::FRef Catalog = (HandManager && HandManager->CardDataTable == CardTable && HandManager->AbilityDataTable == AbilityTable)
+        ? HandManager->GetCatalog()
+        : FCardCatalog::Get(CardTable, AbilityTable);
 
-    UE_LOG(LogTemp, Log, TEXT("[KCK] Executing ability: %s (ID: %d, Type: %d)"),
-        *Ability->Name.ToString(), Ability->ID, (int32)Ability->AbilityType);
-    UE_LOG(LogTemp, Log, TEXT("[KCK] - CardIDsToAffect: %d items"), Ability->CardIDsToAffect.Num());
-    if (Ability->CardIDsToAffect.Num() > 0)
-    {
-        UE_LOG(LogTemp, Log, TEXT("[KCK] - First CardID: %d"), Ability->CardIDsToAffect[0]);
-    }
-    UE_LOG(LogTemp, Log, TEXT("[KCK] - Count: %d"), Ability->Count);
+    FCardAbilityContext Context;
+    Context.HandManager = HandManager;
+    Context.CombatManager = HandManager ? HandManager->CombatManager : nullptr;
+    Context.bCasterIsPlayer = true;
+    Context.SourceCard = &CardData;
+    Context.ChosenTarget = (Target == HandManager) ? nullptr : Target;
 
-    switch (Ability->AbilityType)
-    {
-    case ECardAbilityType::DrawSpecificCard:
-        if (Ability->CardIDsToAffect.Num() > 0)
-        {
-            UE_LOG(LogTemp, Log, TEXT("[KCK] DrawSpecificCard: CardID %d, Count %d"),
-                Ability->CardIDsToAffect[0], Ability->Count);
-            DrawSpecificCard(CardTable, Ability->CardIDsToAffect[0], Ability->Count, Target);
-        }
-        else
-        {
-            UE_LOG(LogTemp, Warning, TEXT("[KCK] DrawSpecificCard: No CardIDsToAffect specified"));
-        }
-        break;
-
-    case ECardAbilityType::DrawMultipleCards:
-        UE_LOG(LogTemp, Log, TEXT("[KCK] DrawMultipleCards: %d card types, Count %d"),
-            Ability->CardIDsToAffect.Num(), Ability->Count);
-        DrawMultipleCards(CardTable, Ability->CardIDsToAffect, Ability->Count, Target);
-        break;
-
-    case ECardAbilityType::BuffAllCreatures:
-        UE_LOG(LogTemp, Log, TEXT("[KCK] BuffAllCreatures: +%d ATK/HP"), Ability->Amount);
-        BuffAllOwnedCreatures(Caster, Ability->Amount, Ability->Amount);
-        break;
-
-    case ECardAbilityType::ApplyDamage:
-        UE_LOG(LogTemp, Log, TEXT("[KCK] ApplyDamage: %d damage"), Ability->Amount);
-        ApplyDamage(Target, Ability->Amount);
-        break;
-
-    case ECardAbilityType::HealActor:
-        UE_LOG(LogTemp, Log, TEXT("[KCK] HealActor: %d healing"), Ability->Amount);
-        HealActor(Target, Ability->Amount);
-        break;
-
-    case ECardAbilityType::BuffCard:
-        UE_LOG(LogTemp, Log, TEXT("[KCK] BuffCard: +%d ATK/HP"), Ability->Amount);
-        BuffCard(CardData, Ability->Amount, Ability->Amount);
-        break;
-
-    case ECardAbilityType::None:
-        UE_LOG(LogTemp, Log, TEXT("[KCK] Ability type is None - no effect"));
-        break;
-
-    default:
-        UE_LOG(LogTemp, Warning, TEXT("[KCK] Unknown ability type: %d"), (int32)Ability->AbilityType);
-        break;
-    }
+    KCKAbility::Execute(*Catalog, AbilityID, Context);
 }
 
 void UKCKGameplayLibrary::DrawSpecificCard(UDataTable* CardTable, int32 CardID, int32 Count, AActor* Target)
 {
-    UE_LOG(LogTemp, Log, TEXT("[KCK] DrawSpecificCard called - CardID: %d, Count: %d, Target: %s"),
+    KCK_LOG_HOT(LogKevesCardKitAbility, Verbose, TEXT("[KCK] DrawSpecificCard called - CardID: %d, Count: %d, Target: %s"),
         CardID, Count, Target ? *Target->GetName() : TEXT("nullptr"));
     
     if (!CardTable || Count <= 0)
     {
-        UE_LOG(LogTemp, Warning, TEXT("[KCK] DrawSpecificCard: Invalid parameters"));
+        UE_LOG(LogKevesCardKitAbility, Warning, TEXT("[KCK] DrawSpecificCard: Invalid parameters"));
         return;
     }
 
@@ -110,7 +58,7 @@ void UKCKGameplayLibrary::DrawSpecificCard(UDataTable* CardTable, int32 CardID,
     if (Target && Target->IsA<AHandManager>())
     {
         HandManager = Cast<AHandManager>(Target);
-        UE_LOG(LogTemp, Log, TEXT("[KCK] Found HandManager from Target parameter"));
+        KCK_LOG_HOT(LogKevesCardKitAbility, Verbose, TEXT("[KCK] Found HandManager from Target parameter"));
     }
     else
     {
@@ -119,52 +67,52 @@ void UKCKGameplayLibrary::DrawSpecificCard(UDataTable* CardTable, int32 CardID,
         {
             TArray<AActor*> FoundActors;
             UGameplayStatics::GetAllActorsOfClass(World, AHandManager::StaticClass(), FoundActors);
-            UE_LOG(LogTemp, Log, TEXT("[KCK] Found %d HandManager actors in world"), FoundActors.Num());
+            KCK_LOG_HOT(LogKevesCardKitAbility, Verbose, TEXT("[KCK] Found %d HandManager actors in world"), FoundActors.Num());
             if (FoundActors.Num() > 0)
             {
                 HandManager = Cast<AHandManager>(FoundActors[0]);
-                UE_LOG(LogTemp, Log, TEXT("[KCK] Using HandManager: %s"), *HandManager->GetName());
+                KCK_LOG_HOT(LogKevesCardKitAbility, Verbose, TEXT("[KCK] Using HandManager: %s"), *HandManager->GetName());
             }
         }
         else
         {
-            UE_LOG(LogTemp, Warning, TEXT("[KCK] No World available to find HandManager"));
+            UE_LOG(LogKevesCardKitAbility, Warning, TEXT("[KCK] No World available to find HandManager"));
         }
     }
 
     // Find the card data
-    for (const FName& Row : CardTable->GetRowNames())
+    const FCardCatalog::FRef Catalog = (HandManager && HandManager->CardDataTable == CardTable)
+        ? HandManager->GetCatalog()
+        : FCardCatalog::Get(CardTable, nullptr);
+
+    const FCardData* Card = Catalog->FindCard(CardID);
+    if (!Card)
     {
-        const FCardData* Card = CardTable->FindRow<FCardData>(Row, TEXT("DrawSpecificCard"));
+        UE_LOG(LogKevesCardKitAbility, Warning, TEXT("[KCK] Card ID %d not found in CardTable."), CardID);
+        return;
+    }
 
-        if (Card && Card->ID == CardID)
+    for (int32 i = 0; i < Count; ++i)
+    {
+        if (HandManager)
         {
-            for (int32 i = 0; i < Count; ++i)
-            {
-                if (HandManager)
-                {
-                    bool bAdded = HandManager->AddCardToHand(CardID);
-                    UE_LOG(LogTemp, Log, TEXT("[KCK] Added card '%s' (ID %d) to hand: %s"),
-                        *Card->Name.ToString(), Card->ID, bAdded ? TEXT("Success") : TEXT("Failed"));
-                }
-                else
-                {
-                    UE_LOG(LogTemp, Log, TEXT("[KCK] Drew card '%s' (ID %d) - No HandManager found"),
-                        *Card->Name.ToString(), Card->ID);
-                }
-            }
-            return;
+            bool bAdded = HandManager->AddCardToHand(CardID);
+            KCK_LOG_HOT(LogKevesCardKitAbility, Verbose, TEXT("[KCK] Added card '%s' (ID %d) to hand: %s"),
+                *Card->Name.ToString(), Card->ID, bAdded ? TEXT("Success") : TEXT("Failed"));
+        }
+        else
+        {
+            KCK_LOG_HOT(LogKevesCardKitAbility, Verbose, TEXT("[KCK] Drew card '%s' (ID %d) - No HandManager found"),
+                *Card->Name.ToString(), Card->ID);
         }
     }
-
-    UE_LOG(LogTemp, Warning, TEXT("[KCK] Card ID %d not found in CardTable."), CardID);
 }
 
 void UKCKGameplayLibrary::DrawMultipleCards(UDataTable* CardTable, const TArray<int32>& CardIDs, int32 CountPerCard, AActor* Target)
 {
     if (!CardTable || CardIDs.Num() == 0)
     {
-        UE_LOG(LogTemp, Warning, TEXT("[KCK] DrawMultipleCards: Invalid parameters"));
+        UE_LOG(LogKevesCardKitAbility, Warning, TEXT("[KCK] DrawMultipleCards: Invalid parameters"));
         return;
     }
 
@@ -179,7 +127,7 @@ void UKCKGameplayLibrary::BuffCard(FCardData& Card, int32 AttackIncrease, int32
     Card.Attack += AttackIncrease;
     Card.Health += HealthIncrease;
 
-    UE_LOG(LogTemp, Log, TEXT("[KCK] Buffed card %s to %d ATK / %d HP"),
+    KCK_LOG_HOT(LogKevesCardKitAbility, Verbose, TEXT("[KCK] Buffed card %s to %d ATK / %d HP"),
         *Card.Name.ToString(), Card.Attack, Card.Health);
 }
 
@@ -187,29 +135,67 @@ void UKCKGameplayLibrary::BuffAllOwnedCreatures(AActor* Owner, int32 AtkBoost, i
 {
     if (!Owner) return;
 
-    UE_LOG(LogTemp, Log, TEXT("[KCK] All owned creatures of %s gain +%d ATK / +%d HP"),
+    KCK_LOG_HOT(LogKevesCardKitAbility, Verbose, TEXT("[KCK] All owned creatures of %s gain +%d ATK / +%d HP"),
         *Owner->GetName(), AtkBoost, HpBoost);
 
-    // TODO: Hook into actual card manager to loop through Owner's hand/field cards
-    // This would need to be implemented based on your specific battlefield system
+    ACombatManager* CombatManager = Cast<ACombatManager>(UGameplayStatics::GetActorOfClass(Owner, ACombatManager::StaticClass()));
+    if (!CombatManager)
+    {
+        UE_LOG(LogKevesCardKitAbility, Warning, TEXT("[KCK] BuffAllOwnedCreatures: no CombatManager in the world"));
+        return;
+    }
+
+    // The enemy actor owns the enemy side; anything else is taken to be the player
+    FCardAbilityContext Context;
+    Context.HandManager = CombatManager->HandManager;
+    Context.CombatManager = CombatManager;
+    Context.bCasterIsPlayer = Owner != CombatManager->EnemyActor;
+
+    // Creatures and champions on the owner's battlefield and in their hand, recorded as per-card modifiers
+    FCardTargetSelector Selector;
+    Selector.Zones = (int32)(ECardTargetZone::OwnField | ECardTargetZone::OwnHand);
+    Selector.CardTypes = (1 << (int32)ECardType::Creature) | (1 << (int32)ECardType::Champion);
+    CombatManager->BuffTargets(KCKTargeting::Select(Selector, Context), AtkBoost, HpBoost);
 }
 
 void UKCKGameplayLibrary::ApplyDamage(AActor* Target, int32 Amount)
 {
     if (!Target || Amount <= 0) return;
 
-    UE_LOG(LogTemp, Log, TEXT("[KCK] ApplyDamage: %s takes %d damage."), *Target->GetName(), Amount);
+    KCK_LOG_HOT(LogKevesCardKitAbility, Verbose, TEXT("[KCK] ApplyDamage: %s takes %d damage."), *Target->GetName(), Amount);
+
+    // Creatures and the enemy go through the combat manager's batch path
+    ACombatManager* CombatManager = Cast<ACombatManager>(UGameplayStatics::GetActorOfClass(Target, ACombatManager::StaticClass()));
+    FCardTargetSet Targets;
+    if (KCKTargeting::ResolveActor(CombatManager, Target, Targets))
+    {
+        CombatManager->DamageTargets(Targets, Amount);
+        return;
+    }
 
-    // TODO: Implement actual damage application to Target
-    // This might involve finding a health component or calling a damage function
+    // Anything else uses the engine's damage pipeline (AActor::TakeDamage)
+    UGameplayStatics::ApplyDamage(Target, (float)Amount, nullptr, nullptr, UDamageType::StaticClass());
 }
 
 void UKCKGameplayLibrary::HealActor(AActor* Target, int32 Amount)
 {
     if (!Target || Amount <= 0) return;
 
-    UE_LOG(LogTemp, Log, TEXT("[KCK] HealActor: %s heals %d HP."), *Target->GetName(), Amount);
+    KCK_LOG_HOT(LogKevesCardKitAbility, Verbose, TEXT("[KCK] HealActor: %s heals %d HP."), *Target->GetName(), Amount);
+
+    ACombatManager* CombatManager = Cast<ACombatManager>(UGameplayStatics::GetActorOfClass(Target, ACombatManager::StaticClass()));
+    FCardTargetSet Targets;
+    if (KCKTargeting::ResolveActor(CombatManager, Target, Targets))
+    {
+        CombatManager->HealTargets(Targets, Amount);
+        return;
+    }
+
+    // The engine has no generic heal; other actors have to handle it themselves
+    UE_LOG(LogKevesCardKitAbility, Warning, TEXT("[KCK] HealActor: %s is not a creature or the enemy, nothing healed"), *Target->GetName());
+}
 
-    // TODO: Implement actual healing application to Target
-    // This might involve finding a health component or calling a heal function
-}
\ No newline at end of file
+bool UKCKGameplayLibrary::DidHandSlotChange(const FHandChangeSet& ChangeSet, int32 SlotIndex)
+{
+    return ChangeSet.DidSlotChange(SlotIndex);
+}
@@ -4,6 +4,7 @@
 #include "Kismet/BlueprintFunctionLibrary.h"
 #include "Engine/DataTable.h"
 #include "CardTypesHost.h"
+#include "RunSave.h"
 #include "KCKGameplayLibrary.generated.h"
 
 /**
@@ -16,6 +17,8 @@ class KEVESCARDKIT_API UKCKGameplayLibrary : public UBlueprintFunctionLibrary
 	
 public:
 
+    // Runs the ability's compiled program (see FCardCatalog / KCKAbility). Target is the chosen target,
+    // or the HandManager when nothing was chosen.
     static void ExecuteAbilityByID(
         int32 AbilityID,
         UDataTable* AbilityTable,
@@ -38,11 +41,34 @@ public:
     UFUNCTION(BlueprintCallable, Category = "KCK|Abilities")
     static void BuffAllOwnedCreatures(AActor* Owner, int32 AtkBoost, int32 HpBoost);
 
+    // Battlefield creatures and the enemy take card damage; other actors go through UGameplayStatics::ApplyDamage
     UFUNCTION(BlueprintCallable, Category = "KCK|Abilities")
     static void ApplyDamage(AActor* Target, int32 Amount);
 
     UFUNCTION(BlueprintCallable, Category = "KCK|Abilities")
     static void HealActor(AActor* Target, int32 Amount);
+
+    // Hand change sets
+    UFUNCTION(BlueprintPure, Category = "KCK|Hand")
+    static bool DidHandSlotChange(const FHandChangeSet& ChangeSet, int32 SlotIndex);
+
+    // Runs (see RunSave.h)
+    UFUNCTION(BlueprintCallable, Category = "KCK|Run")
+    static void StartNewRun(UPARAM(ref) FRunState& Run, int32 Seed = 0) { Run.Reset(Seed); }
+
+    // Returns the copy's instance handle
+    UFUNCTION(BlueprintCallable, Category = "KCK|Run")
+    static int32 AddCardToRun(UPARAM(ref) FRunState& Run, int32 CardID) { return Run.AddCard(CardID); }
+
+    // Snapshot the run and write it in the background; safe to call between every encounter
+    UFUNCTION(BlueprintCallable, Category = "KCK|Run")
+    static void SaveRun(const FRunState& Run, const FString& SlotName = TEXT("Run")) { KCKRunSave::SaveAsync(Run, SlotName); }
+
+    UFUNCTION(BlueprintCallable, Category = "KCK|Run")
+    static bool LoadRun(const FString& SlotName, FRunState& OutRun) { return KCKRunSave::Load(SlotName, OutRun); }
+
+    UFUNCTION(BlueprintPure, Category = "KCK|Run")
+    static bool IsRunSaveInProgress() { return KCKRunSave::IsSaving(); }
 	
 	
 };
@@ -1,6 +1,15 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "KevesCardKit.h"
+#include "KevesCardKitLog.h"
+#include "RunSave.h"
+
+DEFINE_LOG_CATEGORY(LogKevesCardKit);
+DEFINE_LOG_CATEGORY(LogKevesCardKitCombat);
+DEFINE_LOG_CATEGORY(LogKevesCardKitHand);
+DEFINE_LOG_CATEGORY(LogKevesCardKitAbility);
+DEFINE_LOG_CATEGORY(LogKevesCardKitUI);
+DEFINE_LOG_CATEGORY(LogKevesCardKitAI);
 
 #define LOCTEXT_NAMESPACE "FKevesCardKitModule"
 
@@ -13,6 +22,9 @@ void FKevesCardKitModule::ShutdownModule()
 {
 	// This function may be called during shutdown to clean up your module.  For modules that support dynamic reloading,
 	// we call this function before unloading the module.
+
+	// Let a run save that is still on the thread pool reach the disk
+	KCKRunSave::WaitForPendingSaves();
 }
 
 #undef LOCTEXT_NAMESPACE
@@ -0,0 +1,32 @@
+// KevesCardKitLog.h - Log categories for the card kit
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Logging/LogMacros.h"
+
+// Category family. Raise or lower any of them at runtime with "log LogKevesCardKitCombat Verbose" etc.
+KEVESCARDKIT_API DECLARE_LOG_CATEGORY_EXTERN(LogKevesCardKit, Log, All);          // Module and editor tooling
+KEVESCARDKIT_API DECLARE_LOG_CATEGORY_EXTERN(LogKevesCardKitCombat, Log, All);    // Combat flow and battlefield
+KEVESCARDKIT_API DECLARE_LOG_CATEGORY_EXTERN(LogKevesCardKitHand, Log, All);      // Hand, deck and piles
+KEVESCARDKIT_API DECLARE_LOG_CATEGORY_EXTERN(LogKevesCardKitAbility, Log, All);   // Ability execution
+KEVESCARDKIT_API DECLARE_LOG_CATEGORY_EXTERN(LogKevesCardKitUI, Log, All);        // Widgets
+KEVESCARDKIT_API DECLARE_LOG_CATEGORY_EXTERN(LogKevesCardKitAI, Log, All);        // Enemy AI, policies and evaluator
+
+// Verbosity tiers used across the kit:
+//   Warning/Error - always UE_LOG
+//   Log           - once-per-combat events (start/end, state changes, deck set)
+//   Verbose       - per-card / per-call events, via KCK_LOG_HOT
+//   VeryVerbose   - per-slot / per-widget detail, via KCK_LOG_HOT
+//
+// KCK_LOG_HOT compiles to nothing in Shipping and Test, so its arguments (typically Name.ToString())
+// are never evaluated there. In other builds UE_LOG already skips argument evaluation when the
+// category is below the requested verbosity.
+#ifndef KCK_HOT_LOGGING
+#define KCK_HOT_LOGGING !(UE_BUILD_SHIPPING || UE_BUILD_TEST)
+#endif
+
+#if KCK_HOT_LOGGING
+#define KCK_LOG_HOT(CategoryName, Verbosity, Format, ...) UE_LOG(CategoryName, Verbosity, Format, ##__VA_ARGS__)
+#else
+#define KCK_LOG_HOT(CategoryName, Verbosity, Format, ...) do { } while (0)
+#endif
@@ -0,0 +1,119 @@
+// KevesCardKitMemory.cpp - LLM tag definitions and memory accounting
+#include "KevesCardKitMemory.h"
+#include "Engine/DataTable.h"
+
+LLM_DEFINE_TAG(KevesCardKit);
+LLM_DEFINE_TAG(KevesCardKit_CardDefinitions);
+LLM_DEFINE_TAG(KevesCardKit_Piles);
+LLM_DEFINE_TAG(KevesCardKit_Battlefield);
+LLM_DEFINE_TAG(KevesCardKit_DisplayCache);
+LLM_DEFINE_TAG(KevesCardKit_Actors);
+LLM_DEFINE_TAG(KevesCardKit_Widgets);
+
+DEFINE_STAT(STAT_KCK_CardDefinitionsMemory);
+DEFINE_STAT(STAT_KCK_PilesMemory);
+DEFINE_STAT(STAT_KCK_BattlefieldMemory);
+DEFINE_STAT(STAT_KCK_DisplayCacheMemory);
+DEFINE_STAT(STAT_KCK_ActorsMemory);
+DEFINE_STAT(STAT_KCK_WidgetsMemory);
+DEFINE_STAT(STAT_KCK_CombatHighWaterMemory);
+
+namespace KCKMemory
+{
+    static constexpr int32 NumCategories = (int32)ECardKitMemoryCategory::Count;
+
+    static int64 CurrentBytes[NumCategories] = {};
+    static int64 PeakBytes[NumCategories] = {};
+    static int64 CurrentTotal = 0;
+    static int64 PeakTotal = 0;
+
+    static void UpdateStat(ECardKitMemoryCategory Category, int64 Bytes)
+    {
+        switch (Category)
+        {
+        case ECardKitMemoryCategory::CardDefinitions: SET_MEMORY_STAT(STAT_KCK_CardDefinitionsMemory, Bytes); break;
+        case ECardKitMemoryCategory::Piles:           SET_MEMORY_STAT(STAT_KCK_PilesMemory, Bytes); break;
+        case ECardKitMemoryCategory::Battlefield:     SET_MEMORY_STAT(STAT_KCK_BattlefieldMemory, Bytes); break;
+        case ECardKitMemoryCategory::DisplayCache:    SET_MEMORY_STAT(STAT_KCK_DisplayCacheMemory, Bytes); break;
+        case ECardKitMemoryCategory::Actors:          SET_MEMORY_STAT(STAT_KCK_ActorsMemory, Bytes); break;
+        case ECardKitMemoryCategory::Widgets:         SET_MEMORY_STAT(STAT_KCK_WidgetsMemory, Bytes); break;
+        default: break;
+        }
+    }
+
+    static FCardKitMemoryReport MakeReport(const int64 (&Bytes)[NumCategories], int64 Total)
+    {
+        FCardKitMemoryReport Report;
+        Report.CardDefinitionsBytes = Bytes[(int32)ECardKitMemoryCategory::CardDefinitions];
+        Report.PilesBytes = Bytes[(int32)ECardKitMemoryCategory::Piles];
+        Report.BattlefieldBytes = Bytes[(int32)ECardKitMemoryCategory::Battlefield];
+        Report.DisplayCacheBytes = Bytes[(int32)ECardKitMemoryCategory::DisplayCache];
+        Report.ActorsBytes = Bytes[(int32)ECardKitMemoryCategory::Actors];
+        Report.WidgetsBytes = Bytes[(int32)ECardKitMemoryCategory::Widgets];
+        Report.TotalBytes = Total;
+        return Report;
+    }
+
+    void SetBytes(ECardKitMemoryCategory Category, int64 Bytes)
+    {
+        check(IsInGameThread());
+
+        const int32 Index = (int32)Category;
+        if (Index < 0 || Index >= NumCategories)
+        {
+            return;
+        }
+
+        Bytes = FMath::Max<int64>(Bytes, 0);
+        CurrentTotal += Bytes - CurrentBytes[Index];
+        CurrentBytes[Index] = Bytes;
+
+        PeakBytes[Index] = FMath::Max(PeakBytes[Index], Bytes);
+        if (CurrentTotal > PeakTotal)
+        {
+            PeakTotal = CurrentTotal;
+            SET_MEMORY_STAT(STAT_KCK_CombatHighWaterMemory, PeakTotal);
+        }
+
+        UpdateStat(Category, Bytes);
+    }
+
+    void AddBytes(ECardKitMemoryCategory Category, int64 DeltaBytes)
+    {
+        const int32 Index = (int32)Category;
+        if (Index >= 0 && Index < NumCategories)
+        {
+            SetBytes(Category, CurrentBytes[Index] + DeltaBytes);
+        }
+    }
+
+    FCardKitMemoryReport GetCurrent()
+    {
+        return MakeReport(CurrentBytes, CurrentTotal);
+    }
+
+    FCardKitMemoryReport GetHighWater()
+    {
+        return MakeReport(PeakBytes, PeakTotal);
+    }
+
+    void ResetHighWater()
+    {
+        check(IsInGameThread());
+
+        FMemory::Memcpy(PeakBytes, CurrentBytes, sizeof(PeakBytes));
+        PeakTotal = CurrentTotal;
+        SET_MEMORY_STAT(STAT_KCK_CombatHighWaterMemory, PeakTotal);
+    }
+
+    int64 GetDataTableBytes(const UDataTable* Table)
+    {
+        if (!Table || !Table->GetRowStruct())
+        {
+            return 0;
+        }
+
+        const TMap<FName, uint8*>& RowMap = Table->GetRowMap();
+        return RowMap.GetAllocatedSize() + (int64)RowMap.Num() * Table->GetRowStruct()->GetStructureSize();
+    }
+}
@@ -0,0 +1,88 @@
+// KevesCardKitMemory.h - LLM tags and per-category memory accounting for the card system
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/LowLevelMemTracker.h"
+#include "KevesCardKitStats.h"
+#include "KevesCardKitMemory.generated.h"
+
+class UDataTable;
+
+// Low-level memory tags. Run with -llm and use "stat LLMFULL" (or -llmcsv) to see them under KevesCardKit.
+// Scope allocations with LLM_SCOPE_BYTAG(KevesCardKit_Piles) etc.; underscores become the tag hierarchy.
+LLM_DECLARE_TAG_API(KevesCardKit, KEVESCARDKIT_API);
+LLM_DECLARE_TAG_API(KevesCardKit_CardDefinitions, KEVESCARDKIT_API);
+LLM_DECLARE_TAG_API(KevesCardKit_Piles, KEVESCARDKIT_API);
+LLM_DECLARE_TAG_API(KevesCardKit_Battlefield, KEVESCARDKIT_API);
+LLM_DECLARE_TAG_API(KevesCardKit_DisplayCache, KEVESCARDKIT_API);
+LLM_DECLARE_TAG_API(KevesCardKit_Actors, KEVESCARDKIT_API);
+LLM_DECLARE_TAG_API(KevesCardKit_Widgets, KEVESCARDKIT_API);
+
+// Accounted bytes per category ("stat KevesCardKit"); these work without -llm
+DECLARE_MEMORY_STAT_EXTERN(TEXT("Card Definitions"), STAT_KCK_CardDefinitionsMemory, STATGROUP_KevesCardKit, KEVESCARDKIT_API);
+DECLARE_MEMORY_STAT_EXTERN(TEXT("Pile Storage"), STAT_KCK_PilesMemory, STATGROUP_KevesCardKit, KEVESCARDKIT_API);
+DECLARE_MEMORY_STAT_EXTERN(TEXT("Battlefield State"), STAT_KCK_BattlefieldMemory, STATGROUP_KevesCardKit, KEVESCARDKIT_API);
+DECLARE_MEMORY_STAT_EXTERN(TEXT("Display Cache"), STAT_KCK_DisplayCacheMemory, STATGROUP_KevesCardKit, KEVESCARDKIT_API);
+DECLARE_MEMORY_STAT_EXTERN(TEXT("Card Actors"), STAT_KCK_ActorsMemory, STATGROUP_KevesCardKit, KEVESCARDKIT_API);
+DECLARE_MEMORY_STAT_EXTERN(TEXT("Card Widgets"), STAT_KCK_WidgetsMemory, STATGROUP_KevesCardKit, KEVESCARDKIT_API);
+DECLARE_MEMORY_STAT_EXTERN(TEXT("Combat High-Water"), STAT_KCK_CombatHighWaterMemory, STATGROUP_KevesCardKit, KEVESCARDKIT_API);
+
+UENUM(BlueprintType)
+enum class ECardKitMemoryCategory : uint8
+{
+    CardDefinitions,
+    Piles,
+    Battlefield,
+    DisplayCache,
+    Actors,
+    Widgets,
+    Count           UMETA(Hidden)
+};
+
+// Bytes per category. Container storage is exact; actors and widgets count their class size,
+// not components, Slate or render resources (use -llm for those).
+USTRUCT(BlueprintType)
+struct FCardKitMemoryReport
+{
+    GENERATED_BODY()
+
+    UPROPERTY(BlueprintReadOnly, Category = "Memory")
+    int64 CardDefinitionsBytes = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Memory")
+    int64 PilesBytes = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Memory")
+    int64 BattlefieldBytes = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Memory")
+    int64 DisplayCacheBytes = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Memory")
+    int64 ActorsBytes = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Memory")
+    int64 WidgetsBytes = 0;
+
+    // For a high-water report this is the peak of the sum, not the sum of the per-category peaks
+    UPROPERTY(BlueprintReadOnly, Category = "Memory")
+    int64 TotalBytes = 0;
+};
+
+namespace KCKMemory
+{
+    // Replace a category's accounted size (game thread only)
+    KEVESCARDKIT_API void SetBytes(ECardKitMemoryCategory Category, int64 Bytes);
+
+    // Adjust a category by a delta, e.g. +/- class size as actors come and go (game thread only)
+    KEVESCARDKIT_API void AddBytes(ECardKitMemoryCategory Category, int64 DeltaBytes);
+
+    KEVESCARDKIT_API FCardKitMemoryReport GetCurrent();
+
+    // Peaks since the last ResetHighWater (ACombatManager resets this when a combat starts)
+    KEVESCARDKIT_API FCardKitMemoryReport GetHighWater();
+    KEVESCARDKIT_API void ResetHighWater();
+
+    // Row map plus row structs of a data table (row contents' own heap allocations are not followed)
+    KEVESCARDKIT_API int64 GetDataTableBytes(const UDataTable* Table);
+}
@@ -0,0 +1,8 @@
+// KevesCardKitStats.h - Shared stat group for the card kit
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Stats/Stats.h"
+
+// All card kit stats live under "stat KevesCardKit"
+DECLARE_STATS_GROUP(TEXT("KevesCardKit"), STATGROUP_KevesCardKit, STATCAT_Advanced);
@@ -0,0 +1,53 @@
+// KevesCardKitTrace.cpp - Trace channel and counter definitions
+#include "KevesCardKitTrace.h"
+#include "ProfilingDebugging/MiscTrace.h"
+
+UE_TRACE_CHANNEL_DEFINE(KevesCardKitChannel);
+
+TRACE_DECLARE_INT_COUNTER(KCK_CardsDrawn, TEXT("KevesCardKit/CardsDrawn"));
+TRACE_DECLARE_INT_COUNTER(KCK_EffectsResolved, TEXT("KevesCardKit/EffectsResolved"));
+TRACE_DECLARE_INT_COUNTER(KCK_BroadcastsFired, TEXT("KevesCardKit/BroadcastsFired"));
+TRACE_DECLARE_INT_COUNTER(KCK_ActorsSpawned, TEXT("KevesCardKit/ActorsSpawned"));
+
+namespace KCKTrace
+{
+    FTurnCounts GTurnCounts;
+
+    static int32 GWorkScopeDepth = 0;
+
+    void BeginTurn(bool bPlayerTurn)
+    {
+        GTurnCounts = FTurnCounts();
+
+        TRACE_COUNTER_SET(KCK_CardsDrawn, 0);
+        TRACE_COUNTER_SET(KCK_EffectsResolved, 0);
+        TRACE_COUNTER_SET(KCK_BroadcastsFired, 0);
+        TRACE_COUNTER_SET(KCK_ActorsSpawned, 0);
+
+        TRACE_BOOKMARK(TEXT("KCK %s Turn"), bPlayerTurn ? TEXT("Player") : TEXT("Enemy"));
+    }
+
+    FWorkScope::FWorkScope()
+    {
+        if (IsInGameThread())
+        {
+            bOutermost = GWorkScopeDepth++ == 0;
+            if (bOutermost)
+            {
+                StartCycles = FPlatformTime::Cycles64();
+            }
+        }
+    }
+
+    FWorkScope::~FWorkScope()
+    {
+        if (IsInGameThread())
+        {
+            if (bOutermost)
+            {
+                GTurnCounts.WorkCycles += FPlatformTime::Cycles64() - StartCycles;
+            }
+            GWorkScopeDepth--;
+        }
+    }
+}
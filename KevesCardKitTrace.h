@@ -0,0 +1,60 @@
+// KevesCardKitTrace.h - Unreal Insights channel, CPU scopes and per-turn counters
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Trace/Trace.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "ProfilingDebugging/CountersTrace.h"
+
+// Capture with: -trace=cpu,counters,KevesCardKit (then open the .utrace in Insights).
+// Scopes on this channel show up in the Timing view only when the KevesCardKit channel is enabled,
+// so they can be left in hot paths.
+UE_TRACE_CHANNEL_EXTERN(KevesCardKitChannel, KEVESCARDKIT_API);
+
+// CPU timing scope on the KevesCardKit channel. Name is an identifier, e.g. KCK_TRACE_SCOPE(KCK_PlayCard).
+// Also adds the outermost scope's duration to KCKTrace::GTurnCounts.WorkCycles for the metrics report.
+#define KCK_TRACE_SCOPE(Name) \
+    TRACE_CPUPROFILER_EVENT_SCOPE_ON_CHANNEL(Name, KevesCardKitChannel); \
+    KCKTrace::FWorkScope PREPROCESSOR_JOIN(KCKWorkScope_, __LINE__)
+
+// Per-turn counters (reset by KCKTrace::BeginTurn when a player or enemy turn starts)
+TRACE_DECLARE_INT_COUNTER_EXTERN(KCK_CardsDrawn);
+TRACE_DECLARE_INT_COUNTER_EXTERN(KCK_EffectsResolved);
+TRACE_DECLARE_INT_COUNTER_EXTERN(KCK_BroadcastsFired);
+TRACE_DECLARE_INT_COUNTER_EXTERN(KCK_ActorsSpawned);
+
+#define KCK_TRACE_CARD_DRAWN()      do { TRACE_COUNTER_INCREMENT(KCK_CardsDrawn); KCKTrace::GTurnCounts.CardsDrawn++; } while (0)
+#define KCK_TRACE_EFFECT_RESOLVED() do { TRACE_COUNTER_INCREMENT(KCK_EffectsResolved); KCKTrace::GTurnCounts.EffectsResolved++; } while (0)
+#define KCK_TRACE_BROADCAST()       do { TRACE_COUNTER_INCREMENT(KCK_BroadcastsFired); KCKTrace::GTurnCounts.BroadcastsFired++; } while (0)
+#define KCK_TRACE_ACTOR_SPAWNED()   do { TRACE_COUNTER_INCREMENT(KCK_ActorsSpawned); KCKTrace::GTurnCounts.ActorsSpawned++; } while (0)
+
+namespace KCKTrace
+{
+    // Plain tallies mirroring the trace counters, so they can be read without a trace session (game thread only)
+    struct FTurnCounts
+    {
+        int32 CardsDrawn = 0;
+        int32 EffectsResolved = 0;
+        int32 BroadcastsFired = 0;
+        int32 ActorsSpawned = 0;
+
+        // Time spent inside outermost KCK_TRACE_SCOPEs, in FPlatformTime cycles
+        uint64 WorkCycles = 0;
+    };
+
+    extern KEVESCARDKIT_API FTurnCounts GTurnCounts;
+
+    // Zero the per-turn counters and drop a bookmark so turns are easy to find on the timeline
+    KEVESCARDKIT_API void BeginTurn(bool bPlayerTurn);
+
+    // Accumulates game-thread time into GTurnCounts.WorkCycles; nested scopes are not double counted
+    struct KEVESCARDKIT_API FWorkScope
+    {
+        FWorkScope();
+        ~FWorkScope();
+
+    private:
+        uint64 StartCycles = 0;
+        bool bOutermost = false;
+    };
+}
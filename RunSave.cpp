@@ -0,0 +1,324 @@
+// RunSave.cpp - Run save format and background writer
+#include "RunSave.h"
+#include "KevesCardKitLog.h"
+#include "Async/Async.h"
+#include "HAL/FileManager.h"
+#include "Misc/Crc.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeLock.h"
+#include <atomic>
+#include <type_traits>
+
+// ==== RUN STATE ====
+
+int32 FRunState::AddCard(int32 CardID)
+{
+    FRunDeckCard& Card = Deck.AddDefaulted_GetRef();
+    Card.InstanceID = NextCardInstanceID++;
+    Card.CardID = CardID;
+    return Card.InstanceID;
+}
+
+int32 FRunState::NextEncounterSeed()
+{
+    FRandomStream Stream(RandomState);
+    const int32 Seed = (int32)Stream.GetUnsignedInt();
+    RandomState = Stream.GetCurrentSeed();
+    return (Seed != 0) ? Seed : 1; // 0 asks ACombatManager for a fresh seed
+}
+
+void FRunState::Reset(int32 Seed)
+{
+    *this = FRunState();
+    RandomSeed = RandomState = (Seed != 0) ? Seed : FMath::RandRange(1, MAX_int32);
+}
+
+// ==== FILE FORMAT ====
+
+namespace
+{
+    // "KCKR", little-endian
+    static constexpr uint32 RunSaveMagic = 0x524B434B;
+
+    // Oldest format Deserialize still reads; older files are rejected rather than guessed at
+    static constexpr uint16 OldestReadableVersion = 1;
+
+    struct FRunSaveHeader
+    {
+        uint32 Magic = RunSaveMagic;
+        uint16 Version = KCKRunSave::Version;
+        uint16 FixedSize = 0;
+        uint16 DeckEntrySize = 0;
+        uint16 Reserved = 0;
+        uint32 DeckCount = 0;
+        uint32 PayloadCrc = 0;  // Everything after the header
+    };
+
+    // Scalars of FRunState. New fields go at the end.
+    struct FRunSaveFixed
+    {
+        int32 Circle;
+        int32 Encounter;
+        int32 PlayerHealth;
+        int32 PlayerMaxHealth;
+        int32 Souls;
+        int32 RandomSeed;
+        int32 RandomState;
+        int32 NextCardInstanceID;
+    };
+
+    // Deck entries are FRunDeckCard bytes as they sit in memory
+    static_assert(PLATFORM_LITTLE_ENDIAN, "Run saves are stored little-endian");
+    static_assert(std::is_trivially_copyable<FRunDeckCard>::value, "FRunDeckCard is written as raw bytes");
+    static_assert(sizeof(FRunDeckCard) == 5 * sizeof(int32), "Append FRunDeckCard fields at the end and keep them int32");
+
+    FRunSaveFixed ToFixed(const FRunState& State)
+    {
+        FRunSaveFixed Fixed;
+        Fixed.Circle = State.Circle;
+        Fixed.Encounter = State.Encounter;
+        Fixed.PlayerHealth = State.PlayerHealth;
+        Fixed.PlayerMaxHealth = State.PlayerMaxHealth;
+        Fixed.Souls = State.Souls;
+        Fixed.RandomSeed = State.RandomSeed;
+        Fixed.RandomState = State.RandomState;
+        Fixed.NextCardInstanceID = State.NextCardInstanceID;
+        return Fixed;
+    }
+
+    void FromFixed(const FRunSaveFixed& Fixed, FRunState& State)
+    {
+        State.Circle = Fixed.Circle;
+        State.Encounter = Fixed.Encounter;
+        State.PlayerHealth = Fixed.PlayerHealth;
+        State.PlayerMaxHealth = Fixed.PlayerMaxHealth;
+        State.Souls = Fixed.Souls;
+        State.RandomSeed = Fixed.RandomSeed;
+        State.RandomState = Fixed.RandomState;
+        State.NextCardInstanceID = Fixed.NextCardInstanceID;
+    }
+
+    // Bring a state read from an older version up to the current meaning of its fields, one
+    // version at a time. Add a case here whenever KCKRunSave::Version is bumped.
+    void MigrateFromVersion(uint16 FileVersion, FRunState& State)
+    {
+        switch (FileVersion)
+        {
+        case 1:
+            // Current format
+            break;
+        default:
+            checkNoEntry();
+            break;
+        }
+    }
+
+    // SequenceLock guards LatestSequenceBySlot and is only held for a map update, so the game thread
+    // never waits on a write. FileLock serializes the writes themselves.
+    FCriticalSection SequenceLock;
+    FCriticalSection FileLock;
+    TMap<FString, uint32> LatestSequenceBySlot;
+    std::atomic<uint32> NextSaveSequence{ 1 };
+    std::atomic<int32> PendingSaves{ 0 };
+
+    uint32 ClaimSequence(const FString& Path)
+    {
+        const uint32 Sequence = NextSaveSequence.fetch_add(1);
+        FScopeLock Lock(&SequenceLock);
+        LatestSequenceBySlot.Add(Path, Sequence);
+        return Sequence;
+    }
+
+    bool IsLatest(const FString& Path, uint32 Sequence)
+    {
+        FScopeLock Lock(&SequenceLock);
+        return LatestSequenceBySlot.FindRef(Path) == Sequence;
+    }
+
+    // Caller holds FileLock. The slot is only replaced once the new file is complete.
+    bool WriteSlotFile(const TArray<uint8>& Bytes, const FString& Path)
+    {
+        const FString TempPath = Path + TEXT(".tmp");
+        if (!FFileHelper::SaveArrayToFile(Bytes, *TempPath) || !IFileManager::Get().Move(*Path, *TempPath, true))
+        {
+            UE_LOG(LogKevesCardKit, Warning, TEXT("[RunSave] Failed to write %s"), *Path);
+            return false;
+        }
+        return true;
+    }
+}
+
+namespace KCKRunSave
+{
+    FString GetSlotPath(const FString& SlotName)
+    {
+        return FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("SaveGames"), SlotName + TEXT(".kckrun"));
+    }
+
+    void Serialize(const FRunState& State, TArray<uint8>& OutBytes)
+    {
+        const FRunSaveFixed Fixed = ToFixed(State);
+        const int32 DeckBytes = State.Deck.Num() * sizeof(FRunDeckCard);
+
+        FRunSaveHeader Header;
+        Header.FixedSize = sizeof(FRunSaveFixed);
+        Header.DeckEntrySize = sizeof(FRunDeckCard);
+        Header.DeckCount = State.Deck.Num();
+
+        OutBytes.SetNumUninitialized(sizeof(FRunSaveHeader) + sizeof(FRunSaveFixed) + DeckBytes);
+        uint8* Payload = OutBytes.GetData() + sizeof(FRunSaveHeader);
+        FMemory::Memcpy(Payload, &Fixed, sizeof(FRunSaveFixed));
+        if (DeckBytes > 0)
+        {
+            FMemory::Memcpy(Payload + sizeof(FRunSaveFixed), State.Deck.GetData(), DeckBytes);
+        }
+
+        Header.PayloadCrc = FCrc::MemCrc32(Payload, sizeof(FRunSaveFixed) + DeckBytes);
+        FMemory::Memcpy(OutBytes.GetData(), &Header, sizeof(FRunSaveHeader));
+    }
+
+    bool Deserialize(TConstArrayView<uint8> Bytes, FRunState& OutState)
+    {
+        FRunSaveHeader Header;
+        if (Bytes.Num() < (int32)sizeof(FRunSaveHeader))
+        {
+            return false;
+        }
+        FMemory::Memcpy(&Header, Bytes.GetData(), sizeof(FRunSaveHeader));
+
+        const int64 PayloadSize = (int64)Header.FixedSize + (int64)Header.DeckCount * Header.DeckEntrySize;
+        if (Header.Magic != RunSaveMagic || Header.DeckEntrySize == 0
+            || PayloadSize != Bytes.Num() - (int64)sizeof(FRunSaveHeader))
+        {
+            return false;
+        }
+
+        if (Header.Version > KCKRunSave::Version)
+        {
+            UE_LOG(LogKevesCardKit, Error, TEXT("[RunSave] Save is version %d, newer than this build reads (%d)"),
+                Header.Version, KCKRunSave::Version);
+            return false;
+        }
+        if (Header.Version < OldestReadableVersion)
+        {
+            UE_LOG(LogKevesCardKit, Error, TEXT("[RunSave] Save is version %d, older than this build reads (%d)"),
+                Header.Version, OldestReadableVersion);
+            return false;
+        }
+
+        const uint8* Payload = Bytes.GetData() + sizeof(FRunSaveHeader);
+        if (FCrc::MemCrc32(Payload, (int32)PayloadSize) != Header.PayloadCrc)
+        {
+            UE_LOG(LogKevesCardKit, Warning, TEXT("[RunSave] Save data is corrupt (checksum mismatch)"));
+            return false;
+        }
+
+        // Fields the file does not have keep their defaults; fields this build does not know are skipped
+        FRunState State;
+        FRunSaveFixed Fixed = ToFixed(State);
+        FMemory::Memcpy(&Fixed, Payload, FMath::Min<int32>(Header.FixedSize, sizeof(FRunSaveFixed)));
+        FromFixed(Fixed, State);
+
+        const uint8* DeckData = Payload + Header.FixedSize;
+        if (Header.DeckEntrySize == sizeof(FRunDeckCard))
+        {
+            State.Deck.SetNumUninitialized(Header.DeckCount);
+            FMemory::Memcpy(State.Deck.GetData(), DeckData, (int64)Header.DeckCount * sizeof(FRunDeckCard));
+        }
+        else
+        {
+            const int32 CopySize = FMath::Min<int32>(Header.DeckEntrySize, sizeof(FRunDeckCard));
+            State.Deck.SetNum(Header.DeckCount);
+            for (uint32 Index = 0; Index < Header.DeckCount; Index++)
+            {
+                FMemory::Memcpy(&State.Deck[Index], DeckData + (int64)Index * Header.DeckEntrySize, CopySize);
+            }
+        }
+
+        if (Header.Version < KCKRunSave::Version)
+        {
+            MigrateFromVersion(Header.Version, State);
+        }
+
+        OutState = MoveTemp(State);
+        return true;
+    }
+
+    void SaveAsync(const FRunState& State, const FString& SlotName, TFunction<void(bool)> OnComplete)
+    {
+        // The serialized bytes are the snapshot; nothing the worker touches is shared with the game
+        TArray<uint8> Bytes;
+        Serialize(State, Bytes);
+
+        const FString Path = GetSlotPath(SlotName);
+        const uint32 Sequence = ClaimSequence(Path);
+        PendingSaves.fetch_add(1);
+
+        Async(EAsyncExecution::ThreadPool, [Bytes = MoveTemp(Bytes), Path, Sequence, OnComplete = MoveTemp(OnComplete)]() mutable
+        {
+            bool bSaved = true;
+            {
+                FScopeLock Lock(&FileLock);
+                if (IsLatest(Path, Sequence))
+                {
+                    bSaved = WriteSlotFile(Bytes, Path);
+                }
+            }
+            PendingSaves.fetch_sub(1);
+
+            if (OnComplete)
+            {
+                AsyncTask(ENamedThreads::GameThread, [OnComplete = MoveTemp(OnComplete), bSaved]()
+                {
+                    OnComplete(bSaved);
+                });
+            }
+        });
+    }
+
+    bool SaveNow(const FRunState& State, const FString& SlotName)
+    {
+        TArray<uint8> Bytes;
+        Serialize(State, Bytes);
+
+        // Claiming a sequence makes any older queued save for the slot skip its write
+        const FString Path = GetSlotPath(SlotName);
+        ClaimSequence(Path);
+
+        FScopeLock Lock(&FileLock);
+        return WriteSlotFile(Bytes, Path);
+    }
+
+    bool Load(const FString& SlotName, FRunState& OutState)
+    {
+        WaitForPendingSaves();
+
+        const FString Path = GetSlotPath(SlotName);
+        TArray<uint8> Bytes;
+        if (!FFileHelper::LoadFileToArray(Bytes, *Path, FILEREAD_Silent))
+        {
+            return false;
+        }
+
+        if (!Deserialize(Bytes, OutState))
+        {
+            UE_LOG(LogKevesCardKit, Warning, TEXT("[RunSave] %s is not a readable run save"), *Path);
+            return false;
+        }
+        return true;
+    }
+
+    bool IsSaving()
+    {
+        return PendingSaves.load() > 0;
+    }
+
+    void WaitForPendingSaves()
+    {
+        while (PendingSaves.load() > 0)
+        {
+            FPlatformProcess::Sleep(0.001f);
+        }
+    }
+}
@@ -0,0 +1,110 @@
+// RunSave.h - Run state between encounters and its compact binary save file
+#pragma once
+
+#include "CoreMinimal.h"
+#include "RunSave.generated.h"
+
+// One card owned by the run, with the permanent upgrades it has picked up
+USTRUCT(BlueprintType)
+struct FRunDeckCard
+{
+    GENERATED_BODY()
+
+    // Handle that stays with this copy for the whole run (see FRunState::AddCard)
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Run")
+    int32 InstanceID = 0;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Run")
+    int32 CardID = 0;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Run")
+    int32 AttackBonus = 0;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Run")
+    int32 HealthBonus = 0;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Run")
+    int32 CostDelta = 0;
+};
+
+// Everything a run carries from one encounter to the next
+USTRUCT(BlueprintType)
+struct KEVESCARDKIT_API FRunState
+{
+    GENERATED_BODY()
+
+    // Circle of Hell (1-9) and encounters cleared within it
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Run")
+    int32 Circle = 1;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Run")
+    int32 Encounter = 0;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Run")
+    int32 PlayerHealth = 20;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Run")
+    int32 PlayerMaxHealth = 20;
+
+    // Soul currency, spent at shops between battles
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Run")
+    int32 Souls = 0;
+
+    // Seed the run started from, and the current state of the run's random stream
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Run")
+    int32 RandomSeed = 0;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Run")
+    int32 RandomState = 0;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Run")
+    int32 NextCardInstanceID = 1;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Run")
+    TArray<FRunDeckCard> Deck;
+
+    // Add a fresh copy of a card to the deck; returns its instance handle
+    int32 AddCard(int32 CardID);
+
+    // Draw the seed for the next encounter's combat stream, advancing the run stream
+    int32 NextEncounterSeed();
+
+    // Start a new run from Seed (0 picks one)
+    void Reset(int32 Seed = 0);
+};
+
+/**
+ * Binary run save. A file is a fixed header, the scalar block and the deck as packed records, so
+ * a save is a handful of memcpys and a load is one file read plus a copy out of the buffer.
+ * Header sizes let builds sharing a Version read each other's files: missing fields keep their
+ * defaults and unknown trailing fields are skipped. Older Versions are migrated on load; newer
+ * ones are rejected. Saves are serialized on the calling thread (microseconds) and
+ * written on the thread pool to a temp file that replaces the slot once complete.
+ */
+namespace KCKRunSave
+{
+    // Bump when the meaning of an existing field changes; appending fields does not need it
+    static constexpr uint16 Version = 1;
+
+    KEVESCARDKIT_API FString GetSlotPath(const FString& SlotName);
+
+    KEVESCARDKIT_API void Serialize(const FRunState& State, TArray<uint8>& OutBytes);
+
+    // False (State untouched) if the buffer is not a run save, is corrupt, or is from a version this
+    // build cannot read. Older readable versions are migrated to the current one.
+    KEVESCARDKIT_API bool Deserialize(TConstArrayView<uint8> Bytes, FRunState& OutState);
+
+    // Snapshot State and write it in the background. OnComplete runs on the game thread; a save
+    // superseded by a newer one to the same slot before it reached the disk reports true and is skipped.
+    KEVESCARDKIT_API void SaveAsync(const FRunState& State, const FString& SlotName, TFunction<void(bool)> OnComplete = nullptr);
+
+    // Blocking write, for shutdown and tools
+    KEVESCARDKIT_API bool SaveNow(const FRunState& State, const FString& SlotName);
+
+    // Waits for pending writes first, so a load always sees the latest save
+    KEVESCARDKIT_API bool Load(const FString& SlotName, FRunState& OutState);
+
+    KEVESCARDKIT_API bool IsSaving();
+
+    KEVESCARDKIT_API void WaitForPendingSaves();
+}
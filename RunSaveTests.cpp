@@ -0,0 +1,113 @@
+// RunSaveTests.cpp - Run save format: round trip, truncation and version checks
+#include "RunSave.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace RunSaveTests
+{
+    // The header starts with the uint32 magic, followed by the uint16 version
+    static constexpr int32 VersionOffset = sizeof(uint32);
+
+    static FRunState MakeTestState()
+    {
+        FRunState State;
+        State.Reset(12345);
+        State.Circle = 3;
+        State.Encounter = 2;
+        State.PlayerHealth = 14;
+        State.Souls = 77;
+        for (int32 CardID = 1; CardID <= 5; CardID++)
+        {
+            State.AddCard(CardID);
+        }
+        State.Deck[1].AttackBonus = 2;
+        State.Deck[3].CostDelta = -1;
+        State.NextEncounterSeed();
+        return State;
+    }
+
+    static void SetVersion(TArray<uint8>& Bytes, uint16 Version)
+    {
+        FMemory::Memcpy(Bytes.GetData() + VersionOffset, &Version, sizeof(uint16));
+    }
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRunSaveRoundTripTest, "KevesCardKit.RunSave.RoundTrip",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+bool FRunSaveRoundTripTest::RunTest(const FString& Parameters)
+{
+    const FRunState Saved = RunSaveTests::MakeTestState();
+    TArray<uint8> Bytes;
+    KCKRunSave::Serialize(Saved, Bytes);
+
+    FRunState Loaded;
+    if (!TestTrue(TEXT("Deserialize accepts its own output"), KCKRunSave::Deserialize(Bytes, Loaded)))
+    {
+        return false;
+    }
+
+    TestEqual(TEXT("Circle"), Loaded.Circle, Saved.Circle);
+    TestEqual(TEXT("Encounter"), Loaded.Encounter, Saved.Encounter);
+    TestEqual(TEXT("PlayerHealth"), Loaded.PlayerHealth, Saved.PlayerHealth);
+    TestEqual(TEXT("PlayerMaxHealth"), Loaded.PlayerMaxHealth, Saved.PlayerMaxHealth);
+    TestEqual(TEXT("Souls"), Loaded.Souls, Saved.Souls);
+    TestEqual(TEXT("RandomSeed"), Loaded.RandomSeed, Saved.RandomSeed);
+    TestEqual(TEXT("RandomState"), Loaded.RandomState, Saved.RandomState);
+    TestEqual(TEXT("NextCardInstanceID"), Loaded.NextCardInstanceID, Saved.NextCardInstanceID);
+
+    if (TestEqual(TEXT("Deck size"), Loaded.Deck.Num(), Saved.Deck.Num()))
+    {
+        for (int32 Index = 0; Index < Saved.Deck.Num(); Index++)
+        {
+            const FRunDeckCard& A = Saved.Deck[Index];
+            const FRunDeckCard& B = Loaded.Deck[Index];
+            TestTrue(FString::Printf(TEXT("Deck[%d] matches"), Index),
+                A.InstanceID == B.InstanceID && A.CardID == B.CardID && A.AttackBonus == B.AttackBonus
+                && A.HealthBonus == B.HealthBonus && A.CostDelta == B.CostDelta);
+        }
+    }
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRunSaveTruncatedTest, "KevesCardKit.RunSave.RejectsTruncated",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+bool FRunSaveTruncatedTest::RunTest(const FString& Parameters)
+{
+    TArray<uint8> Bytes;
+    KCKRunSave::Serialize(RunSaveTests::MakeTestState(), Bytes);
+
+    const FRunState Untouched;
+    for (const int32 Length : { Bytes.Num() - 1, Bytes.Num() / 2, RunSaveTests::VersionOffset, 0 })
+    {
+        FRunState State;
+        TestFalse(FString::Printf(TEXT("%d of %d bytes is rejected"), Length, Bytes.Num()),
+            KCKRunSave::Deserialize(TConstArrayView<uint8>(Bytes.GetData(), Length), State));
+        TestEqual(TEXT("State is untouched"), State.Deck.Num(), Untouched.Deck.Num());
+    }
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRunSaveVersionTest, "KevesCardKit.RunSave.RejectsUnreadableVersion",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+bool FRunSaveVersionTest::RunTest(const FString& Parameters)
+{
+    TArray<uint8> Bytes;
+    KCKRunSave::Serialize(RunSaveTests::MakeTestState(), Bytes);
+
+    // The checksum covers the payload only, so this isolates the version check
+    AddExpectedError(TEXT("newer than this build reads"), EAutomationExpectedErrorFlags::Contains, 1);
+    RunSaveTests::SetVersion(Bytes, (uint16)(KCKRunSave::Version + 1));
+    FRunState State;
+    TestFalse(TEXT("A newer version is rejected"), KCKRunSave::Deserialize(Bytes, State));
+
+    AddExpectedError(TEXT("older than this build reads"), EAutomationExpectedErrorFlags::Contains, 1);
+    RunSaveTests::SetVersion(Bytes, 0);
+    TestFalse(TEXT("A version older than any readable format is rejected"), KCKRunSave::Deserialize(Bytes, State));
+
+    RunSaveTests::SetVersion(Bytes, KCKRunSave::Version);
+    TestTrue(TEXT("The current version still loads"), KCKRunSave::Deserialize(Bytes, State));
+    return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS